@@ -1,27 +1,51 @@
-QT       += core gui
+TEMPLATE = subdirs
 
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+# lexer    : 与Qt无关的词法分析静态库
+# app      : Qt图形界面
+# rustlex  : 命令行工具，并行分析整个源码目录
+# rustlexd : 常驻的语义单词服务，标准输入输出上的 LSP JSON-RPC
+# rustindex: 跨文件的单词倒排索引，建立、增量更新和查询
+# paralleltest: 并行分析与串行分析的一致性测试，失败时返回非零
+# exporttest: 单词导出的读回测试，失败时返回非零
+# numbertest: 数字字面量解码的边界用例测试，失败时返回非零
+SUBDIRS += \
+    lexer \
+    app \
+    rustlex \
+    rustlexd \
+    rustindex \
+    keywordbench \
+    lexbench \
+    indexbench \
+    paralleltest \
+    exporttest \
+    numbertest
 
-CONFIG += c++17
+app.depends = lexer
 
-# You can make your code fail to compile if it uses deprecated APIs.
-# In order to do so, uncomment the following line.
-#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+rustlex.subdir = tools/rustlex
+rustlex.depends = lexer
 
-SOURCES += \
-    main.cpp \
-    mainwindow.cpp \
-    rustlexer.cpp
+rustlexd.subdir = tools/rustlexd
+rustlexd.depends = lexer
 
-HEADERS += \
-    mainwindow.h \
-    rustlexer.h \
-    token.h
+rustindex.subdir = tools/rustindex
+rustindex.depends = lexer
 
-FORMS += \
-    mainwindow.ui
+keywordbench.subdir = benchmarks/keywordbench
+keywordbench.depends = lexer
 
-# Default rules for deployment.
-qnx: target.path = /tmp/$${TARGET}/bin
-else: unix:!android: target.path = /opt/$${TARGET}/bin
-!isEmpty(target.path): INSTALLS += target
+lexbench.subdir = benchmarks/lexbench
+lexbench.depends = lexer
+
+indexbench.subdir = benchmarks/indexbench
+indexbench.depends = lexer
+
+paralleltest.subdir = tests/paralleltest
+paralleltest.depends = lexer
+
+exporttest.subdir = tests/exporttest
+exporttest.depends = lexer
+
+numbertest.subdir = tests/numbertest
+numbertest.depends = lexer
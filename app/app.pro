@@ -0,0 +1,32 @@
+QT       += core gui concurrent
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+CONFIG += c++17
+
+TARGET = RustLexer
+
+# You can make your code fail to compile if it uses deprecated APIs.
+# In order to do so, uncomment the following line.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+include(../lexer/lexer.pri)
+
+SOURCES += \
+    main.cpp \
+    mainwindow.cpp \
+    tokentablemodel.cpp \
+    workspacemodel.cpp
+
+HEADERS += \
+    mainwindow.h \
+    tokentablemodel.h \
+    workspacemodel.h
+
+FORMS += \
+    mainwindow.ui
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
@@ -0,0 +1,621 @@
+#include "mainwindow.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextBlock>
+#include <QTextDocument>
+#include <QTextStream>
+#include <QThread>
+#include <cstdio>
+#include <QtConcurrent/QtConcurrentRun>
+#include <algorithm>
+#include <chrono>
+#include <utility>
+#include <vector>
+#include "mappedfile.h"
+#include "tokenexport.h"
+#include "threadpool.h"
+
+namespace {
+
+// 后台分析每积累这么多单词就交给界面线程一次
+constexpr size_t ANALYSIS_BATCH_SIZE = 64 * 1024;
+
+// 超过此字节数的编辑（如打开文件时整体替换文本）改为后台从头分析，不在界面线程增量分析
+constexpr size_t BACKGROUND_EDIT_SIZE = 1024 * 1024;
+
+// 递归查找 root 下的 .rs 文件，按大小降序排列，先调度大文件以免最后剩下一个大文件。
+// QDirIterator 默认不进入隐藏目录（.git 等）；构建输出目录 target 也跳过
+QStringList findRustFiles(const QString &root)
+{
+    QDir rootDir(root);
+    std::vector<std::pair<qint64, QString>> found;
+    QDirIterator it(root, QStringList() << "*.rs", QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        QString path = it.next();
+        QStringList parts = rootDir.relativeFilePath(path).split('/');
+        parts.removeLast();
+        if (!parts.contains("target")) {
+            found.emplace_back(it.fileInfo().size(), path);
+        }
+    }
+    std::stable_sort(found.begin(), found.end(), [](const auto &a, const auto &b) {
+        return a.first > b.first;
+    });
+    QStringList paths;
+    paths.reserve(int(found.size()));
+    for (const auto &file : found) {
+        paths << file.second;
+    }
+    return paths;
+}
+
+// 编辑器文本的UTF-8字节。toPlainText() 会把不间断空格换成空格、把行分隔符 U+2028 换成换行，
+// 既与文件内容不同，行数也不再与文本块数一致；这里只把文本块之间的段落分隔符换成换行，
+// 增量分析时才能按文本块定位行索引中的行
+std::string documentText(const QTextDocument *document)
+{
+    QString text = document->toRawText();
+    text.replace(QChar::ParagraphSeparator, QLatin1Char('\n'));
+    return text.toStdString();
+}
+
+} // namespace
+
+MainWindow::MainWindow(QWidget *parent)
+    : QMainWindow(parent)
+{
+    // 设置窗口标题
+    setWindowTitle("Rust单词拼装分类器");
+    // 设置窗口大小
+    resize(1000, 700);
+    
+    // 设置UI布局
+    setupUI();
+    // 设置菜单栏
+    setupMenus();
+    
+    // 设置状态栏
+    statusLabel = new QLabel("就绪");
+    statusBar()->addWidget(statusLabel);
+    progressBar = new QProgressBar(this);
+    progressBar->setRange(0, 1000);
+    progressBar->setMaximumWidth(200);
+    progressBar->setTextVisible(false);
+    progressBar->hide();
+    statusBar()->addPermanentWidget(progressBar);
+    
+    workspaceLabel = new QLabel(this);
+    workspaceLabel->hide();
+    statusBar()->addPermanentWidget(workspaceLabel);
+    
+    // 每次按键都增量重新分析并刷新结果
+    connect(codeEditor->document(), &QTextDocument::contentsChange, this, &MainWindow::onContentsChange);
+}
+
+MainWindow::~MainWindow()
+{
+    // 工作线程会向本窗口投递结果，必须在析构前结束
+    cancelAnalysis();
+    cancelWorkspace();
+    // 无需手动删除UI组件，它们会随着父窗口一起销毁
+}
+
+void MainWindow::setupUI()
+{
+    // 创建主部件
+    QWidget *centralWidget = new QWidget(this);
+    setCentralWidget(centralWidget);
+    
+    // 创建分割器，允许调整代码编辑器和结果显示区域的大小
+    QSplitter *splitter = new QSplitter(Qt::Vertical);
+    
+    // 创建代码编辑器
+    codeEditor = new QPlainTextEdit(this);
+    codeEditor->setFont(QFont("Consolas", 11));
+    codeEditor->setLineWrapMode(QPlainTextEdit::NoWrap);
+    codeEditor->setTabStopDistance(40);
+    
+    // 创建结果显示区域：按需绘制的单词表格，行高固定，避免为每一行计算尺寸
+    tokenModel = new TokenTableModel(this);
+    resultView = new QTableView(this);
+    resultView->setModel(tokenModel);
+    resultView->setFont(QFont("Consolas", 11));
+    resultView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    resultView->setWordWrap(false);
+    resultView->verticalHeader()->setVisible(false);
+    resultView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    resultView->verticalHeader()->setDefaultSectionSize(resultView->fontMetrics().height() + 6);
+    resultView->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+    resultView->horizontalHeader()->setStretchLastSection(true);
+    resultView->setColumnWidth(TokenTableModel::LineColumn, 70);
+    resultView->setColumnWidth(TokenTableModel::ColumnColumn, 60);
+    resultView->setColumnWidth(TokenTableModel::TypeColumn, 150);
+    
+    // 添加组件到分割器
+    splitter->addWidget(codeEditor);
+    splitter->addWidget(resultView);
+    
+    // 设置分割器的大小比例
+    splitter->setStretchFactor(0, 4); // 代码编辑区占40%
+    splitter->setStretchFactor(1, 6); // 结果显示区占60%
+    
+    // 创建主布局
+    QVBoxLayout *mainLayout = new QVBoxLayout(centralWidget);
+    mainLayout->addWidget(splitter);
+    
+    // 添加分析按钮
+    QPushButton *analyzeButton = new QPushButton("分析代码", this);
+    connect(analyzeButton, &QPushButton::clicked, this, &MainWindow::analyzeCode);
+    
+    // 将按钮添加到布局底部
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(analyzeButton);
+    buttonLayout->addStretch();
+    
+    mainLayout->addLayout(buttonLayout);
+    
+    setupWorkspace();
+}
+
+void MainWindow::setupWorkspace()
+{
+    // 工作区文件列表停靠在左侧，打开文件夹后才显示；点击表头按该列排序
+    workspaceModel = new WorkspaceModel(this);
+    workspaceProxy = new QSortFilterProxyModel(this);
+    workspaceProxy->setSourceModel(workspaceModel);
+    workspaceProxy->setSortRole(WorkspaceModel::SortRole);
+    workspaceProxy->setSortCaseSensitivity(Qt::CaseInsensitive);
+    // 结果逐个到达时不重新排序，避免选中的行在用户眼前跳动；点击表头时再排序
+    workspaceProxy->setDynamicSortFilter(false);
+    
+    workspaceView = new QTableView(this);
+    workspaceView->setModel(workspaceProxy);
+    workspaceView->setSortingEnabled(true);
+    workspaceView->sortByColumn(WorkspaceModel::FileColumn, Qt::AscendingOrder);
+    workspaceView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    workspaceView->setSelectionMode(QAbstractItemView::SingleSelection);
+    workspaceView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    workspaceView->setWordWrap(false);
+    workspaceView->verticalHeader()->setVisible(false);
+    workspaceView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    workspaceView->verticalHeader()->setDefaultSectionSize(workspaceView->fontMetrics().height() + 6);
+    workspaceView->horizontalHeader()->setSectionResizeMode(WorkspaceModel::FileColumn, QHeaderView::Stretch);
+    workspaceView->setColumnWidth(WorkspaceModel::TokensColumn, 80);
+    workspaceView->setColumnWidth(WorkspaceModel::BytesColumn, 80);
+    workspaceView->setColumnWidth(WorkspaceModel::TimeColumn, 70);
+    connect(workspaceView->selectionModel(), &QItemSelectionModel::currentRowChanged,
+            this, &MainWindow::openWorkspaceFile);
+    
+    workspaceDock = new QDockWidget("工作区", this);
+    workspaceDock->setObjectName("workspaceDock");
+    workspaceDock->setWidget(workspaceView);
+    addDockWidget(Qt::LeftDockWidgetArea, workspaceDock);
+    workspaceDock->hide();
+}
+
+void MainWindow::setupMenus()
+{
+    // 创建文件菜单
+    QMenu *fileMenu = menuBar()->addMenu("文件(&F)");
+    
+    // 添加打开文件动作
+    openAction = fileMenu->addAction("打开(&O)");
+    openAction->setShortcut(QKeySequence::Open);
+    connect(openAction, &QAction::triggered, this, &MainWindow::openFile);
+    
+    // 打开文件夹：分析其中所有 .rs 文件
+    openFolderAction = fileMenu->addAction("打开文件夹(&D)");
+    openFolderAction->setShortcut(QKeySequence("Ctrl+Shift+O"));
+    connect(openFolderAction, &QAction::triggered, this, &MainWindow::openFolder);
+    
+    QAction *workspaceAction = workspaceDock->toggleViewAction();
+    workspaceAction->setText("工作区(&W)");
+    fileMenu->addAction(workspaceAction);
+    
+    // 导出最近一次分析的单词序列
+    exportAction = fileMenu->addAction("导出单词(&E)...");
+    exportAction->setShortcut(QKeySequence("Ctrl+E"));
+    connect(exportAction, &QAction::triggered, this, &MainWindow::exportTokens);
+    
+    fileMenu->addSeparator();
+    
+    // 添加退出动作
+    QAction *exitAction = fileMenu->addAction("退出(&Q)");
+    exitAction->setShortcut(QKeySequence::Quit);
+    connect(exitAction, &QAction::triggered, this, &QWidget::close);
+    
+    // 创建分析菜单
+    QMenu *analyzeMenu = menuBar()->addMenu("分析(&A)");
+    
+    // 添加分析代码动作
+    analyzeAction = analyzeMenu->addAction("分析代码(&A)");
+    analyzeAction->setShortcut(Qt::Key_F5);
+    connect(analyzeAction, &QAction::triggered, this, &MainWindow::analyzeCode);
+    
+    // 扫描统计：只有以 CONFIG+=lexer_stats 构建的词法分析库才记录
+    statsAction = analyzeMenu->addAction("扫描统计(&S)");
+    statsAction->setEnabled(lexStatsEnabled());
+    if (!lexStatsEnabled()) {
+        statsAction->setToolTip("以 CONFIG+=lexer_stats 重新构建后可用");
+    }
+    connect(statsAction, &QAction::triggered, this, &MainWindow::showStats);
+}
+
+void MainWindow::openFile()
+{
+    // 打开文件对话框
+    QString filePath = QFileDialog::getOpenFileName(this, 
+                                                   "打开Rust源文件", 
+                                                   "", 
+                                                   "Rust源文件 (*.rs);;所有文件 (*.*)");
+    
+    if (filePath.isEmpty())
+        return;
+    
+    loadFile(filePath);
+}
+
+void MainWindow::loadFile(const QString &filePath)
+{
+    // 打开文件
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        QMessageBox::critical(this, "错误", "无法打开文件：" + filePath);
+        return;
+    }
+    
+    // 读取文件内容到代码编辑器
+    QTextStream in(&file);
+    // 删除 in.setCodec("UTF-8"); 这一行
+    // Qt 6已经默认使用UTF-8编码
+    codeEditor->setPlainText(in.readAll());
+    file.close();
+    
+    // 保存当前文件路径
+    currentFilePath = filePath;
+    statusLabel->setText("已加载文件：" + QFileInfo(filePath).fileName());
+}
+
+void MainWindow::openFolder()
+{
+    QString root = QFileDialog::getExistingDirectory(this, "打开文件夹");
+    if (root.isEmpty())
+        return;
+    
+    startWorkspace(root);
+}
+
+void MainWindow::startWorkspace(const QString &root)
+{
+    cancelWorkspace();
+    
+    QStringList paths = findRustFiles(root);
+    workspaceModel->setFiles(root, paths);
+    // 停靠窗口的标题同时是菜单中切换动作的文字，保持不变，根目录放在表格的提示中
+    workspaceView->setToolTip(QDir::toNativeSeparators(root));
+    workspaceDock->show();
+    if (paths.isEmpty()) {
+        workspaceLabel->setText("工作区中没有 .rs 文件");
+        workspaceLabel->show();
+        return;
+    }
+    
+    // 留一个核给界面线程和当前文件的分析；线程池在多次打开文件夹之间复用
+    if (!workspacePool) {
+        workspacePool = std::make_unique<ThreadPool>(size_t(std::max(1, QThread::idealThreadCount() - 1)));
+    }
+    
+    auto job = std::make_shared<WorkspaceJob>();
+    job->timer.start();
+    workspaceJob = job;
+    workspaceLabel->setText("工作区：正在分析 " + QString::number(paths.size()) + " 个文件");
+    workspaceLabel->show();
+    
+    // 每个文件只映射后逐个取单词计数，不保存单词；选中时再在编辑器中完整分析
+    for (int row = 0; row < paths.size(); row++) {
+        std::string path = QFile::encodeName(paths[row]).toStdString();
+        workspacePool->submit([this, job, row, path]() {
+            if (job->cancelled.load(std::memory_order_relaxed)) {
+                return;
+            }
+            auto begin = std::chrono::steady_clock::now();
+            MappedFile mapped;
+            qint64 count = 0;
+            QString error;
+            if (mapped.open(path)) {
+                RustLexer fileLexer(mapped.data(), mapped.size());
+                Token token;
+                while (fileLexer.nextToken(token)) {
+                    count++;
+                }
+            } else {
+                error = QString::fromStdString(mapped.errorString());
+            }
+            double milliseconds = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - begin).count();
+            qint64 bytes = qint64(mapped.size());
+            QMetaObject::invokeMethod(this, [this, job, row, bytes, count, milliseconds, error]() {
+                receiveWorkspaceResult(job, row, bytes, count, milliseconds, error);
+            }, Qt::QueuedConnection);
+        });
+    }
+}
+
+void MainWindow::cancelWorkspace()
+{
+    if (workspaceJob) {
+        workspaceJob->cancelled = true;
+        workspaceJob.reset();
+    }
+    // 正在执行的任务只分析完当前文件，其余任务检查取消标志后立即返回
+    if (workspacePool) {
+        workspacePool->wait();
+    }
+}
+
+void MainWindow::receiveWorkspaceResult(const std::shared_ptr<WorkspaceJob>& job, int row, qint64 bytes,
+                                        qint64 tokens, double milliseconds, const QString &error)
+{
+    // 已被新打开的文件夹取代的结果直接丢弃
+    if (job != workspaceJob) {
+        return;
+    }
+    
+    workspaceModel->setResult(row, bytes, tokens, milliseconds, error);
+    
+    int finished = workspaceModel->finishedCount();
+    int total = workspaceModel->fileCount();
+    QString summary = QString::number(finished) + "/" + QString::number(total) + " 个文件，"
+                      + QString::number(workspaceModel->totalTokens()) + " 个单词";
+    if (finished == total) {
+        workspaceJob.reset();
+        workspaceLabel->setText("工作区：" + summary + "，耗时 "
+                                + QString::number(job->timer.elapsed()) + " ms");
+    } else {
+        workspaceLabel->setText("工作区：正在分析 " + summary);
+    }
+}
+
+void MainWindow::openWorkspaceFile(const QModelIndex &current)
+{
+    if (!current.isValid()) {
+        return;
+    }
+    
+    // 按需载入：选中时才读入编辑器，载入后文本变化会触发后台分析
+    QString filePath = workspaceModel->filePath(workspaceProxy->mapToSource(current).row());
+    if (filePath != currentFilePath) {
+        loadFile(filePath);
+    }
+}
+
+void MainWindow::analyzeCode()
+{
+    // 获取代码文本（只取一次）
+    std::string code = documentText(codeEditor->document());
+    if (code.empty()) {
+        QMessageBox::warning(this, "警告", "请先输入或打开Rust代码");
+        return;
+    }
+    
+    startAnalysis(std::move(code));
+}
+
+void MainWindow::startAnalysis(std::string code)
+{
+    // 新的分析开始时取消正在进行的分析；工作线程每一批都检查取消标志，等待时间很短
+    cancelAnalysis();
+    
+    auto job = std::make_shared<AnalysisJob>();
+    currentJob = job;
+    lexer = std::make_shared<RustLexer>(std::move(code));
+    tokens = TokenStream();
+    lines = LineIndex();
+    displayTokens();
+    
+    progressBar->setValue(0);
+    progressBar->show();
+    statusLabel->setText("正在分析……");
+    
+    // 工作线程先建立行索引，再逐个取出单词，攒够一批后投递到界面线程追加到结果表格
+    std::shared_ptr<RustLexer> worker = lexer;
+    analysisFuture = QtConcurrent::run([this, job, worker]() {
+        LineIndex index(worker->sourceText());
+        QMetaObject::invokeMethod(this, [this, job, index = std::move(index)]() mutable {
+            if (job == currentJob) {
+                lines = std::move(index);
+                tokenModel->linesChanged();
+            }
+        }, Qt::QueuedConnection);
+        
+        TokenStream batch;
+        batch.reserve(ANALYSIS_BATCH_SIZE);
+        Token token;
+        bool more = true;
+        while (more && !job->cancelled.load(std::memory_order_relaxed)) {
+            more = worker->nextToken(token);
+            if (more) {
+                batch.append(token);
+            }
+            if (batch.size() == ANALYSIS_BATCH_SIZE || !more) {
+                size_t scanned = more ? token.offset + token.length : worker->sourceText().size();
+                QMetaObject::invokeMethod(this, [this, job, batch = std::move(batch), scanned, more]() {
+                    receiveBatch(job, batch, scanned, !more);
+                }, Qt::QueuedConnection);
+                batch.clear();
+                batch.reserve(ANALYSIS_BATCH_SIZE);
+            }
+        }
+    });
+}
+
+void MainWindow::cancelAnalysis()
+{
+    if (currentJob) {
+        currentJob->cancelled = true;
+        currentJob.reset();
+    }
+    analysisFuture.waitForFinished();
+    progressBar->hide();
+}
+
+void MainWindow::receiveBatch(const std::shared_ptr<AnalysisJob>& job, const TokenStream& batch,
+                              size_t scanned, bool finished)
+{
+    // 已取消的分析投递过来的结果直接丢弃
+    if (job != currentJob) {
+        return;
+    }
+    
+    tokenModel->appendTokens(batch);
+    
+    size_t total = lexer->sourceText().size();
+    progressBar->setValue(total == 0 ? 1000 : int(scanned * 1000 / total));
+    if (finished) {
+        // 工作线程在投递最后一批之前已结束扫描，此时读取统计没有竞争
+        lastStats = lexer->stats();
+        currentJob.reset();
+        progressBar->hide();
+        statusLabel->setText("分析完成，共识别 " + QString::number(tokens.size()) + " 个单词");
+    } else {
+        statusLabel->setText("正在分析：已识别 " + QString::number(tokens.size()) + " 个单词");
+    }
+}
+
+void MainWindow::onContentsChange(int position, int charsRemoved, int charsAdded)
+{
+    QTextDocument *document = codeEditor->document();
+    // 编辑量以UTF-16计不超过字节数，超过阈值时不必再换算
+    if (!lexer || currentJob || size_t(charsRemoved) + size_t(charsAdded) >= BACKGROUND_EDIT_SIZE) {
+        // 尚未分析过、后台分析中途文本又变了，或者编辑很大：从头重新分析
+        startAnalysis(documentText(document));
+        return;
+    }
+    
+    // contentsChange 给出的是UTF-16位置。文本块与行索引中的行一一对应，
+    // 起点所在行之前的部分没有变化，取行起点的字节偏移再加上块内前缀的UTF-8长度
+    QTextBlock block = document->findBlock(position);
+    int line = block.blockNumber() + 1;
+    if (!block.isValid() || size_t(line) > lines.lineCount()) {
+        startAnalysis(documentText(document));
+        return;
+    }
+    std::string_view before = lexer->sourceText();
+    size_t offset = lines.lineStart(line)
+                    + size_t(block.text().left(position - block.position()).toUtf8().size());
+    
+    // 删除的文本已不在文档中：在旧源码上从起点逐个UTF-8序列前进 charsRemoved 个UTF-16单元，
+    // 四字节序列对应一个代理对。整体替换文本时Qt报告的数目可能多出末尾的段落分隔符，到源码末尾为止
+    size_t removedEnd = offset;
+    for (int units = 0; units < charsRemoved && removedEnd < before.size(); ) {
+        unsigned char lead = static_cast<unsigned char>(before[removedEnd]);
+        size_t length = lead < 0x80 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+        units += length == 4 ? 2 : 1;
+        removedEnd += length;
+    }
+    size_t removed = std::min(removedEnd, before.size()) - offset;
+    
+    // 插入的文本只取受影响的几个文本块，块之间补上换行
+    int addedEnd = std::min(position + charsAdded, document->characterCount() - 1);
+    std::string inserted;
+    for (QTextBlock current = block; current.isValid() && current.position() <= addedEnd; current = current.next()) {
+        if (current != block) {
+            inserted += '\n';
+        }
+        int from = std::max(position - current.position(), 0);
+        int to = std::min(addedEnd - current.position(), current.length() - 1);
+        inserted += current.text().mid(from, to - from).toStdString();
+    }
+    if (inserted.size() == removed && before.compare(offset, removed, inserted) == 0) {
+        // 只改变了格式，文本没有变化
+        return;
+    }
+    if (removed + inserted.size() >= BACKGROUND_EDIT_SIZE) {
+        startAnalysis(documentText(document));
+        return;
+    }
+    
+    TokenEdit edit = lexer->applyEdit(tokens, offset, removed, inserted);
+    size_t lineCount = lines.lineCount();
+    lines.applyEdit(offset, removed, inserted);
+    
+    statusLabel->setText("增量分析：重新识别 " + QString::number(edit.inserted) + " 个单词，共 "
+                         + QString::number(tokens.size()) + " 个单词");
+    // 只通知视图改变了的行，不重置模型
+    tokenModel->tokensEdited(edit, offset + inserted.size(), lines.lineCount() != lineCount);
+}
+
+void MainWindow::exportTokens()
+{
+    if (!lexer || currentJob) {
+        QMessageBox::information(this, "导出单词", "请先分析代码，并等待分析完成");
+        return;
+    }
+    
+    QString selectedFilter;
+    QString path = QFileDialog::getSaveFileName(this, "导出单词", "",
+                                                "JSON Lines (*.jsonl);;CSV (*.csv);;二进制 (*.bin)",
+                                                &selectedFilter);
+    if (path.isEmpty())
+        return;
+    
+    ExportFormat format = ExportFormat::JsonLines;
+    if (selectedFilter.startsWith("CSV")) {
+        format = ExportFormat::Csv;
+    } else if (selectedFilter.startsWith("二进制")) {
+        format = ExportFormat::Binary;
+    }
+    
+    std::FILE *file = std::fopen(QFile::encodeName(path).constData(), "wb");
+    if (!file) {
+        QMessageBox::critical(this, "错误", "无法创建文件：" + path);
+        return;
+    }
+    
+    // 直接从单词序列和源码格式化到写缓冲区，不经过表格模型
+    std::string name = currentFilePath.isEmpty()
+        ? std::string("untitled.rs") : QFileInfo(currentFilePath).fileName().toStdString();
+    bool ok;
+    uint64_t bytes;
+    {
+        BufferedWriter out(file);
+        TokenExporter exporter(out, format);
+        exporter.writeHeader();
+        exporter.exportTokens(name, lexer->sourceText(), tokens);
+        ok = out.flush();
+        bytes = out.bytesWritten();
+    }
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) {
+        QMessageBox::critical(this, "错误", "写入文件失败：" + path);
+        return;
+    }
+    statusLabel->setText("已导出 " + QString::number(tokens.size()) + " 个单词，"
+                         + QString::number(bytes) + " 字节：" + QFileInfo(path).fileName());
+}
+
+void MainWindow::showStats()
+{
+    if (lastStats.tokenCount() == 0) {
+        QMessageBox::information(this, "扫描统计", "请先分析代码");
+        return;
+    }
+    
+    // 报告按列对齐，用等宽字体显示
+    QMessageBox box(this);
+    box.setWindowTitle("扫描统计");
+    box.setTextFormat(Qt::RichText);
+    box.setText("<pre style=\"font-family: Consolas, monospace;\">"
+                + QString::fromStdString(lastStats.format()).toHtmlEscaped() + "</pre>");
+    box.exec();
+}
+
+void MainWindow::displayTokens()
+{
+    // 模型直接引用分析结果，视图只绘制可见的行
+    tokenModel->setTokens(lexer.get(), &tokens, &lines);
+}
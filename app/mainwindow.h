@@ -0,0 +1,106 @@
+#ifndef MAINWINDOW_H
+#define MAINWINDOW_H
+
+#include <QMainWindow>
+#include <QPlainTextEdit>
+#include <QLabel>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QPushButton>
+#include <QMenuBar>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QTabWidget>
+#include <QSplitter>
+#include <QScrollBar>
+#include <QStatusBar>
+#include <QTableView>
+#include <QHeaderView>
+#include <QProgressBar>
+#include <QFuture>
+#include <QDockWidget>
+#include <QElapsedTimer>
+#include <QSortFilterProxyModel>
+#include <atomic>
+#include <memory>
+#include "lineindex.h"
+#include "rustlexer.h"
+#include "tokentablemodel.h"
+#include "workspacemodel.h"
+
+class MainWindow : public QMainWindow {
+    Q_OBJECT
+
+public:
+    MainWindow(QWidget *parent = nullptr);
+    ~MainWindow();
+
+private slots:
+    void openFile();
+    void openFolder();
+    void openWorkspaceFile(const QModelIndex &current);
+    void exportTokens();
+    void analyzeCode();
+    void onContentsChange(int position, int charsRemoved, int charsAdded);
+    void showStats();
+
+private:
+    QPlainTextEdit *codeEditor;
+    QTableView *resultView;
+    TokenTableModel *tokenModel;
+    QString currentFilePath;
+    QLabel *statusLabel;
+    QAction *openAction;
+    QAction *openFolderAction;
+    QAction *exportAction;
+    QAction *analyzeAction;
+    QAction *statsAction;
+    QProgressBar *progressBar;
+    
+    // 工作区：打开文件夹后列出其中所有 .rs 文件，选中一行时才把该文件载入编辑器
+    QDockWidget *workspaceDock;
+    QTableView *workspaceView;
+    WorkspaceModel *workspaceModel;
+    QSortFilterProxyModel *workspaceProxy;
+    QLabel *workspaceLabel;
+    
+    // 最近一次分析的结果，编辑时在此基础上增量更新。
+    // 后台分析期间工作线程推进 lexer 的扫描位置，界面线程只通过它读取词素
+    std::shared_ptr<RustLexer> lexer;
+    TokenStream tokens;
+    LineIndex lines;
+    // 最近一次完整分析的热路径统计（词法分析库以 RUSTLEXER_STATS 编译时才有数据）
+    LexStats lastStats;
+    
+    // 后台分析任务：置位 cancelled 后工作线程在当前一批结束时退出
+    struct AnalysisJob {
+        std::atomic<bool> cancelled{false};
+    };
+    std::shared_ptr<AnalysisJob> currentJob;
+    QFuture<void> analysisFuture;
+    
+    // 工作区分析：每个文件一个任务，在线程数有限的线程池上执行，结果逐个投递到界面线程。
+    // 置位 cancelled 后尚未开始的任务直接返回
+    struct WorkspaceJob {
+        std::atomic<bool> cancelled{false};
+        QElapsedTimer timer;
+    };
+    std::shared_ptr<WorkspaceJob> workspaceJob;
+    std::unique_ptr<ThreadPool> workspacePool;
+    
+    void setupUI();
+    void setupMenus();
+    void setupWorkspace();
+    void loadFile(const QString &filePath);
+    void displayTokens();
+    void startAnalysis(std::string code);
+    void cancelAnalysis();
+    void receiveBatch(const std::shared_ptr<AnalysisJob>& job, const TokenStream& batch,
+                      size_t scanned, bool finished);
+    void startWorkspace(const QString &root);
+    void cancelWorkspace();
+    void receiveWorkspaceResult(const std::shared_ptr<WorkspaceJob>& job, int row, qint64 bytes,
+                                qint64 tokens, double milliseconds, const QString &error);
+};
+
+#endif // MAINWINDOW_H
@@ -0,0 +1,215 @@
+#include "tokentablemodel.h"
+
+#include <QColor>
+#include <algorithm>
+
+TokenTableModel::TokenTableModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+void TokenTableModel::setTokens(const RustLexer *lexer, TokenStream *tokens, const LineIndex *lines)
+{
+    // 重置只通知视图重新取行数，不遍历单词
+    beginResetModel();
+    this->lexer = lexer;
+    this->tokens = tokens;
+    this->lines = lines;
+    rows = tokens ? int(tokens->size()) : 0;
+    endResetModel();
+}
+
+void TokenTableModel::appendTokens(const TokenStream &batch)
+{
+    if (!tokens || batch.empty()) {
+        return;
+    }
+    int first = int(tokens->size());
+    beginInsertRows(QModelIndex(), first, first + int(batch.size()) - 1);
+    tokens->append(batch);
+    rows = int(tokens->size());
+    endInsertRows();
+}
+
+void TokenTableModel::tokensEdited(const TokenEdit &edit, size_t editEnd, bool linesShifted)
+{
+    if (!tokens) {
+        return;
+    }
+    
+    // 新旧单词数相同的部分原地刷新，多出或少了的部分才插入或删除行，
+    // 在一个单词内打字时视图的选中和滚动位置都不变
+    const int first = int(edit.first);
+    const int kept = int(std::min(edit.removed, edit.inserted));
+    if (edit.removed > edit.inserted) {
+        beginRemoveRows(QModelIndex(), first + kept, first + int(edit.removed) - 1);
+        rows = int(tokens->size());
+        endRemoveRows();
+    } else if (edit.inserted > edit.removed) {
+        beginInsertRows(QModelIndex(), first + kept, first + int(edit.inserted) - 1);
+        rows = int(tokens->size());
+        endInsertRows();
+    }
+    if (kept > 0) {
+        emit dataChanged(index(first, 0), index(first + kept - 1, ColumnCount - 1));
+    }
+    
+    // 其后的单词只平移了偏移。行数变化时其后所有单词的行号（以及按行交替的底色）都变了，
+    // 否则只有编辑结束处同一行上的单词列号变了
+    int from = first + int(edit.inserted);
+    if (from >= rows || !lines || lines->empty()) {
+        return;
+    }
+    int to = rows - 1;
+    if (!linesShifted) {
+        int line = lines->line(editEnd);
+        if (size_t(line) < lines->lineCount()) {
+            // 二分查找下一行的第一个单词
+            size_t lineEnd = lines->lineStart(line + 1);
+            size_t low = size_t(from);
+            size_t high = size_t(rows);
+            while (low < high) {
+                size_t middle = low + (high - low) / 2;
+                if (tokens->offset(middle) < lineEnd) {
+                    low = middle + 1;
+                } else {
+                    high = middle;
+                }
+            }
+            to = int(low) - 1;
+        }
+    }
+    if (to >= from) {
+        emit dataChanged(index(from, 0), index(to, ColumnCount - 1));
+    }
+}
+
+void TokenTableModel::linesChanged()
+{
+    if (rowCount() > 0) {
+        emit dataChanged(index(0, 0), index(rowCount() - 1, ColumnCount - 1));
+    }
+}
+
+int TokenTableModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : rows;
+}
+
+int TokenTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant TokenTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || !tokens || index.row() >= rows) {
+        return QVariant();
+    }
+
+    const Token token = tokens->token(size_t(index.row()));
+    const bool hasLines = lines && !lines->empty();
+    switch (role) {
+    case Qt::DisplayRole:
+        switch (index.column()) {
+        case LineColumn:
+            return hasLines ? QVariant(lines->line(token.offset)) : QVariant();
+        case ColumnColumn:
+            return hasLines ? QVariant(lines->column(token.offset, lexer->sourceText())) : QVariant();
+        case TypeColumn:
+            return typeName(token.type);
+        case LexemeColumn: {
+            // 词素只在显示时按需取出
+            std::string_view lexeme = lexer->lexeme(token);
+            return QString::fromUtf8(lexeme.data(), qsizetype(lexeme.size()));
+        }
+        }
+        break;
+    case Qt::ForegroundRole:
+        if (index.column() == TypeColumn || index.column() == LexemeColumn) {
+            return typeColor(token.type);
+        }
+        break;
+    case Qt::BackgroundRole:
+        // 相邻两行源码的单词交替着色，同一行的单词成为一组
+        if (hasLines) {
+            return QColor(lines->line(token.offset) % 2 ? "#ffffff" : "#eef2f8");
+        }
+        break;
+    case Qt::ToolTipRole:
+        if (token.type == TokenType::INTEGER_LITERAL || token.type == TokenType::FLOAT_LITERAL) {
+            // 数字字面量悬停时显示解码后的值
+            QString value = "值：" + QString::fromStdString(decodeNumber(lexer->lexeme(token)).toString());
+            return hasLines ? sourceLine(lines->line(token.offset)) + "\n" + value : value;
+        }
+        if (hasLines) {
+            return sourceLine(lines->line(token.offset));
+        }
+        break;
+    case Qt::TextAlignmentRole:
+        if (index.column() == LineColumn || index.column() == ColumnColumn) {
+            return int(Qt::AlignRight | Qt::AlignVCenter);
+        }
+        break;
+    }
+    return QVariant();
+}
+
+QVariant TokenTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    switch (section) {
+    case LineColumn:   return QString("行");
+    case ColumnColumn: return QString("列");
+    case TypeColumn:   return QString("类型");
+    case LexemeColumn: return QString("单词");
+    }
+    return QVariant();
+}
+
+QString TokenTableModel::typeName(TokenType type)
+{
+    switch (type) {
+    case TokenType::KEYWORD:         return "关键字";
+    case TokenType::IDENTIFIER:      return "标识符";
+    case TokenType::INTEGER_LITERAL: return "字面量（整数）";
+    case TokenType::FLOAT_LITERAL:   return "字面量（浮点数）";
+    case TokenType::STRING_LITERAL:  return "字符串字面量";
+    case TokenType::CHAR_LITERAL:    return "字符字面量";
+    case TokenType::OPERATOR:        return "操作符";
+    case TokenType::DELIMITER:       return "分隔符";
+    case TokenType::COMMENT:         return "注释";
+    case TokenType::MACRO_CALL:      return "宏调用名";
+    case TokenType::LIFETIME:        return "生命周期/标签";
+    default:                         return "未知类型";
+    }
+}
+
+QColor TokenTableModel::typeColor(TokenType type)
+{
+    switch (type) {
+    case TokenType::KEYWORD:         return QColor("#0000CC");
+    case TokenType::IDENTIFIER:      return QColor("#006600");
+    case TokenType::INTEGER_LITERAL:
+    case TokenType::FLOAT_LITERAL:   return QColor("#990099");
+    case TokenType::STRING_LITERAL:
+    case TokenType::CHAR_LITERAL:    return QColor("#CC0000");
+    case TokenType::OPERATOR:        return QColor("#000088");
+    case TokenType::DELIMITER:       return QColor("#444444");
+    case TokenType::COMMENT:         return QColor("#886600");
+    case TokenType::MACRO_CALL:      return QColor("#884400");
+    case TokenType::LIFETIME:        return QColor("#007777");
+    default:                         return QColor("#000000");
+    }
+}
+
+QString TokenTableModel::sourceLine(int line) const
+{
+    // 单词起点所在的整行源码（不含换行），只在悬停提示时计算
+    std::string_view source = lexer->sourceText();
+    size_t begin = lines->lineStart(line);
+    size_t end = size_t(line) < lines->lineCount() ? lines->lineStart(line + 1) - 1 : source.size();
+    return QString::fromUtf8(source.data() + begin, qsizetype(end - begin));
+}
@@ -0,0 +1,55 @@
+#ifndef TOKENTABLEMODEL_H
+#define TOKENTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include "lineindex.h"
+#include "rustlexer.h"
+
+// 单词列表模型：直接读取词法分析结果，不复制单词也不预先生成任何文本，
+// 视图只对可见的行调用 data()，因此显示开销与文件大小无关。行列号按需从 LineIndex 查询
+class TokenTableModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    enum Column {
+        LineColumn,
+        ColumnColumn,
+        TypeColumn,
+        LexemeColumn,
+        ColumnCount
+    };
+
+    explicit TokenTableModel(QObject *parent = nullptr);
+
+    // 指向的对象由调用方持有；内容变化后需再次调用以通知视图。
+    // 行索引为空时不显示行列号
+    void setTokens(const RustLexer *lexer, TokenStream *tokens, const LineIndex *lines);
+    // 在单词序列末尾追加一批单词并通知视图插入了这些行
+    void appendTokens(const TokenStream &batch);
+    // 增量分析之后调用：单词序列和行索引已按 edit 更新。只通知视图删除、插入和改变了的行，
+    // 以及其后行列号随之移动的行。editEnd 是插入文本在新源码中的结束位置，
+    // linesShifted 表示这次编辑改变了源码的行数
+    void tokensEdited(const TokenEdit &edit, size_t editEnd, bool linesShifted);
+    // 行索引建立完成后刷新行列号
+    void linesChanged();
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    static QString typeName(TokenType type);
+    static QColor typeColor(TokenType type);
+
+private:
+    const RustLexer *lexer = nullptr;
+    TokenStream *tokens = nullptr;
+    const LineIndex *lines = nullptr;
+    // 已通知视图的行数。tokensEdited() 调用时单词序列已经改变，
+    // 通知删除或插入行的过程中 rowCount() 仍须返回改变前的行数
+    int rows = 0;
+
+    QString sourceLine(int line) const;
+};
+
+#endif // TOKENTABLEMODEL_H
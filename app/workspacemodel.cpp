@@ -0,0 +1,133 @@
+#include "workspacemodel.h"
+
+#include <QColor>
+#include <QDir>
+#include <limits>
+
+WorkspaceModel::WorkspaceModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+void WorkspaceModel::setFiles(const QString &root, const QStringList &paths)
+{
+    beginResetModel();
+    QDir rootDir(root);
+    files.clear();
+    files.reserve(paths.size());
+    for (const QString &path : paths) {
+        Entry entry;
+        entry.path = path;
+        entry.displayName = rootDir.relativeFilePath(path);
+        files.push_back(entry);
+    }
+    finished = 0;
+    tokenSum = 0;
+    byteSum = 0;
+    endResetModel();
+}
+
+void WorkspaceModel::clear()
+{
+    setFiles(QString(), QStringList());
+}
+
+void WorkspaceModel::setResult(int row, qint64 bytes, qint64 tokens, double milliseconds, const QString &error)
+{
+    if (row < 0 || row >= files.size()) {
+        return;
+    }
+    Entry &entry = files[row];
+    if (entry.tokens < 0 && entry.error.isEmpty()) {
+        finished++;
+    }
+    entry.bytes = bytes;
+    entry.tokens = error.isEmpty() ? tokens : -1;
+    entry.milliseconds = milliseconds;
+    entry.error = error;
+    if (error.isEmpty()) {
+        tokenSum += tokens;
+        byteSum += bytes;
+    }
+    emit dataChanged(index(row, 0), index(row, ColumnCount - 1));
+}
+
+int WorkspaceModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : files.size();
+}
+
+int WorkspaceModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant WorkspaceModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= files.size()) {
+        return QVariant();
+    }
+
+    const Entry &entry = files[index.row()];
+    const bool done = entry.tokens >= 0;
+    switch (role) {
+    case Qt::DisplayRole:
+        switch (index.column()) {
+        case FileColumn:
+            return entry.displayName;
+        case TokensColumn:
+            if (!entry.error.isEmpty()) {
+                return QString("无法读取");
+            }
+            return done ? QVariant(entry.tokens) : QVariant(QString("等待分析"));
+        case BytesColumn:
+            return done ? QVariant(entry.bytes) : QVariant();
+        case TimeColumn:
+            return done ? QVariant(QString::number(entry.milliseconds, 'f', 2)) : QVariant();
+        }
+        break;
+    case SortRole:
+        // 尚未分析或出错的行取最大值，升序时排在最后
+        switch (index.column()) {
+        case FileColumn:
+            return entry.displayName;
+        case TokensColumn:
+            return done ? entry.tokens : std::numeric_limits<qint64>::max();
+        case BytesColumn:
+            return done ? entry.bytes : std::numeric_limits<qint64>::max();
+        case TimeColumn:
+            return done ? entry.milliseconds : std::numeric_limits<double>::max();
+        }
+        break;
+    case Qt::ForegroundRole:
+        if (!entry.error.isEmpty()) {
+            return QColor("#CC0000");
+        }
+        if (!done && index.column() != FileColumn) {
+            return QColor("#888888");
+        }
+        break;
+    case Qt::ToolTipRole:
+        return entry.error.isEmpty() ? entry.path : entry.path + "\n" + entry.error;
+    case Qt::TextAlignmentRole:
+        if (index.column() != FileColumn) {
+            return int(Qt::AlignRight | Qt::AlignVCenter);
+        }
+        break;
+    }
+    return QVariant();
+}
+
+QVariant WorkspaceModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    switch (section) {
+    case FileColumn:   return QString("文件");
+    case TokensColumn: return QString("单词数");
+    case BytesColumn:  return QString("字节");
+    case TimeColumn:   return QString("耗时(ms)");
+    }
+    return QVariant();
+}
@@ -0,0 +1,62 @@
+#ifndef WORKSPACEMODEL_H
+#define WORKSPACEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// 工作区文件列表模型：每行一个 .rs 文件，后台分析完成后逐行填入单词数和耗时。
+// 排序交给 QSortFilterProxyModel，数值列通过 SortRole 按数值而不是按文本比较
+class WorkspaceModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    enum Column {
+        FileColumn,
+        TokensColumn,
+        BytesColumn,
+        TimeColumn,
+        ColumnCount
+    };
+
+    // 排序用的原始值：文件名为字符串，其余为数值，尚未分析的行排在最后
+    static constexpr int SortRole = Qt::UserRole;
+
+    explicit WorkspaceModel(QObject *parent = nullptr);
+
+    // 替换整个文件列表，所有行回到“等待分析”状态；路径显示为相对 root 的形式
+    void setFiles(const QString &root, const QStringList &paths);
+    void clear();
+
+    // 填入第 row 个文件的分析结果；error 非空表示无法读取
+    void setResult(int row, qint64 bytes, qint64 tokens, double milliseconds, const QString &error);
+
+    QString filePath(int row) const { return files[row].path; }
+    int fileCount() const { return files.size(); }
+    int finishedCount() const { return finished; }
+    qint64 totalTokens() const { return tokenSum; }
+    qint64 totalBytes() const { return byteSum; }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    struct Entry {
+        QString path;               // 绝对路径
+        QString displayName;        // 相对工作区根目录的路径
+        qint64 bytes = -1;          // -1 表示尚未分析
+        qint64 tokens = -1;
+        double milliseconds = 0.0;
+        QString error;
+    };
+
+    QVector<Entry> files;
+    int finished = 0;
+    qint64 tokenSum = 0;
+    qint64 byteSum = 0;
+};
+
+#endif // WORKSPACEMODEL_H
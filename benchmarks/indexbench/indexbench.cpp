@@ -0,0 +1,562 @@
+// 倒排索引基准：以固定种子在临时目录中生成数千个互相引用的Rust源文件，测量
+// 全量建立索引、写出和映射索引文件、各类查询的延迟，以及少量文件变化后增量更新的耗时，
+// 并与逐个文件重新分析来查找同一词素对比。结果写入 JSON 文件，便于比较不同版本。
+//
+// 用法：indexbench [选项]
+//   --files <N>      生成的文件数（默认 5000）
+//   --queries <N>    每类查询的次数（默认 1000）
+//   --jobs <N>       线程数（默认为硬件线程数）
+//   --seed <N>       生成器种子（默认 20240521）
+//   --dir <目录>     生成源码和索引的目录（默认在系统临时目录下），结束时删除
+//   --keep           保留生成的目录
+//   --output <文件>  结果文件（默认 indexbench.json）
+
+#include "mappedfile.h"
+#include "rustlexer.h"
+#include "threadpool.h"
+#include "tokenindex.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// ---- 源码生成器 ----
+
+using Random = std::mt19937_64;
+
+// 组成各模块条目名称的词；模块编号作为后缀，使每个模块的名称各不相同
+const char* const WORDS[] = {
+    "parse", "read", "write", "header", "buffer", "frame", "token", "node", "entry", "cache",
+    "index", "stream", "packet", "record", "table", "schema", "query", "route", "session", "config",
+    "socket", "worker", "queue", "event", "handle", "signal", "layout", "render", "shader", "mesh"
+};
+
+// 各文件中都会大量出现的局部变量名和方法名
+const char* const COMMON[] = {
+    "value", "len", "data", "result", "count", "offset", "input", "output", "state", "ctx",
+    "iter", "map", "unwrap", "clone", "push", "insert", "get", "into", "as_ref", "to_string"
+};
+
+const char* const TYPES[] = {
+    "u8", "u32", "u64", "usize", "i64", "f64", "bool", "String", "Vec<u8>", "Option<usize>"
+};
+
+const char* const SENTENCE[] = {
+    "the", "parser", "returns", "an", "error", "when", "input", "is", "empty", "and",
+    "otherwise", "consumes", "bytes", "until", "a", "delimiter", "is", "found"
+};
+
+template <size_t N>
+const char* pick(Random& rng, const char* const (&items)[N])
+{
+    return items[rng() % N];
+}
+
+size_t uniform(Random& rng, size_t low, size_t high)
+{
+    return low + rng() % (high - low + 1);
+}
+
+constexpr size_t WORD_COUNT = sizeof(WORDS) / sizeof(WORDS[0]);
+
+std::string capitalized(const char* word)
+{
+    std::string out = word;
+    out[0] = char(out[0] - 'a' + 'A');
+    return out;
+}
+
+// 模块 module 中定义的类型、函数和常量的名称
+std::string typeName(size_t module)
+{
+    return capitalized(WORDS[module % WORD_COUNT]) + capitalized(WORDS[module / WORD_COUNT % WORD_COUNT])
+        + std::to_string(module);
+}
+
+std::string functionName(size_t module, size_t k)
+{
+    return std::string(WORDS[(module + k) % WORD_COUNT]) + "_" + WORDS[(module * 7 + k) % WORD_COUNT] + "_"
+        + std::to_string(module) + "_" + std::to_string(k);
+}
+
+std::string constantLiteral(size_t module)
+{
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "0x%08llX",
+                  static_cast<unsigned long long>((module * 2654435761u) & 0xFFFFFFFFu));
+    return buffer;
+}
+
+// 被引用的模块偏向编号小的模块：少数模块被大量引用，多数只被引用几次
+size_t referencedModule(Random& rng, size_t moduleCount)
+{
+    double u = double(rng() >> 11) / double(1ull << 53);
+    return std::min(moduleCount - 1, size_t(std::pow(u, 3.0) * double(moduleCount)));
+}
+
+constexpr size_t MAX_FUNCTIONS = 12;
+
+size_t functionCount(size_t module)
+{
+    return 3 + module * 2654435761u % (MAX_FUNCTIONS - 2);
+}
+
+void appendSentence(Random& rng, std::string& out, size_t words)
+{
+    for (size_t i = 0; i < words; i++) {
+        if (i > 0) {
+            out += ' ';
+        }
+        out += pick(rng, SENTENCE);
+    }
+}
+
+// 第 module 个模块：引用其他模块的类型和函数，定义自己的类型、常量和若干方法
+std::string generateModule(size_t module, size_t moduleCount, uint64_t seed)
+{
+    Random rng(seed * 1000003u + module);
+    std::string out;
+    out += "//! ";
+    appendSentence(rng, out, uniform(rng, 5, 12));
+    out += "\n\nuse std::collections::HashMap;\n";
+    size_t imports = uniform(rng, 1, 4);
+    for (size_t i = 0; i < imports; i++) {
+        size_t other = referencedModule(rng, moduleCount);
+        out += "use crate::m" + std::to_string(other) + "::" + typeName(other) + ";\n";
+    }
+
+    std::string self = typeName(module);
+    out += "\npub const LIMIT: u64 = " + constantLiteral(module) + ";\n\n";
+    out += "/// ";
+    appendSentence(rng, out, uniform(rng, 4, 10));
+    out += "\n#[derive(Debug, Clone)]\npub struct " + self + " {\n";
+    size_t fields = uniform(rng, 2, 6);
+    for (size_t i = 0; i < fields; i++) {
+        out += "    pub ";
+        out += WORDS[rng() % WORD_COUNT];
+        out += "_";
+        out += std::to_string(i);
+        out += ": ";
+        out += pick(rng, TYPES);
+        out += ",\n";
+    }
+    out += "}\n\nimpl " + self + " {\n";
+
+    size_t functions = functionCount(module);
+    for (size_t k = 0; k < functions; k++) {
+        out += "    pub fn " + functionName(module, k) + "<'a>(&self, value: &'a [u8], len: usize) -> Option<usize> {\n";
+        size_t statements = uniform(rng, 3, 10);
+        for (size_t s = 0; s < statements; s++) {
+            size_t other = referencedModule(rng, moduleCount);
+            switch (rng() % 6) {
+            case 0:
+                out += "        let ";
+                out += pick(rng, COMMON);
+                out += " = " + typeName(other) + "::default();\n";
+                break;
+            case 1:
+                out += "        let ";
+                out += pick(rng, COMMON);
+                out += " = " + functionName(other, rng() % functionCount(other)) + "(value, ";
+                out += std::to_string(rng() % 1000);
+                out += ");\n";
+                break;
+            case 2:
+                out += "        println!(\"";
+                appendSentence(rng, out, uniform(rng, 2, 6));
+                out += ": {}\", ";
+                out += pick(rng, COMMON);
+                out += ");\n";
+                break;
+            case 3:
+                out += "        if len > " + constantLiteral(other) + " as usize {\n            return None;\n        }\n";
+                break;
+            case 4:
+                out += "        let ";
+                out += pick(rng, COMMON);
+                out += " = self.";
+                out += pick(rng, COMMON);
+                out += '.';
+                out += pick(rng, COMMON);
+                out += "().";
+                out += pick(rng, COMMON);
+                out += "(";
+                out += std::to_string(rng() % 64);
+                out += ");\n";
+                break;
+            default:
+                out += "        // ";
+                appendSentence(rng, out, uniform(rng, 3, 9));
+                out += "\n        let mut table: HashMap<String, usize> = HashMap::new();\n";
+                break;
+            }
+        }
+        out += "        Some(len)\n    }\n\n";
+    }
+    out += "}\n";
+    return out;
+}
+
+std::string modulePath(const std::string& directory, size_t module)
+{
+    // 每个子目录100个文件，与真实仓库的目录深度相近
+    return (fs::u8path(directory) / ("d" + std::to_string(module / 100)) / ("m" + std::to_string(module) + ".rs"))
+        .u8string();
+}
+
+bool writeFile(const std::string& path, const std::string& content)
+{
+    std::ofstream out(fs::u8path(path), std::ios::binary | std::ios::trunc);
+    out.write(content.data(), std::streamsize(content.size()));
+    return bool(out);
+}
+
+// ---- 测量 ----
+
+struct Options {
+    size_t files = 5000;
+    size_t queries = 1000;
+    size_t threads = 0;
+    uint64_t seed = 20240521u;
+    std::string directory;
+    bool keep = false;
+    std::string output = "indexbench.json";
+};
+
+double secondsSince(std::chrono::steady_clock::time_point begin)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+struct QueryResult {
+    const char* name;
+    const char* description;
+    size_t queries = 0;
+    uint64_t hits = 0;
+    double medianMicros = 0.0;
+    double p99Micros = 0.0;
+    double maxMicros = 0.0;
+};
+
+QueryResult runQueries(const TokenIndex& index, const char* name, const char* description,
+                       const std::vector<std::string>& lexemes)
+{
+    QueryResult result;
+    result.name = name;
+    result.description = description;
+    result.queries = lexemes.size();
+    std::vector<double> micros;
+    std::vector<Posting> postings;
+    for (const std::string& lexeme : lexemes) {
+        auto begin = std::chrono::steady_clock::now();
+        postings.clear();
+        for (const TokenIndexTerm& term : index.find(lexeme)) {
+            index.postings(term, postings);
+        }
+        micros.push_back(secondsSince(begin) * 1e6);
+        result.hits += postings.size();
+    }
+    std::sort(micros.begin(), micros.end());
+    if (!micros.empty()) {
+        result.medianMicros = micros[micros.size() / 2];
+        result.p99Micros = micros[std::min(micros.size() - 1, micros.size() * 99 / 100)];
+        result.maxMicros = micros.back();
+    }
+    return result;
+}
+
+struct UpdateResult {
+    size_t changed = 0;
+    double loadSeconds = 0.0;
+    double updateSeconds = 0.0;
+    double saveSeconds = 0.0;
+    size_t relexed = 0;
+};
+
+// 改写 changed 个文件后，从索引文件开始增量更新并写回
+UpdateResult runUpdate(const Options& options, const std::vector<std::string>& paths, const std::string& indexPath,
+                       size_t changed, ThreadPool& pool, Random& rng)
+{
+    for (size_t i = 0; i < changed; i++) {
+        size_t module = rng() % paths.size();
+        writeFile(paths[module], generateModule(module, paths.size(), options.seed + 1 + rng() % 1000));
+    }
+
+    UpdateResult result;
+    result.changed = changed;
+    auto begin = std::chrono::steady_clock::now();
+    std::unique_ptr<TokenIndexBuilder> builder;
+    {
+        TokenIndex existing;
+        existing.open(indexPath);
+        builder = std::make_unique<TokenIndexBuilder>(existing);
+    }
+    result.loadSeconds = secondsSince(begin);
+
+    begin = std::chrono::steady_clock::now();
+    TokenIndexUpdate update = builder->update(paths, pool);
+    result.updateSeconds = secondsSince(begin);
+    result.relexed = update.added + update.updated;
+
+    begin = std::chrono::steady_clock::now();
+    builder->save(indexPath);
+    result.saveSeconds = secondsSince(begin);
+    return result;
+}
+
+// 对照：不用索引，逐个文件分析并比较词素
+double scanSeconds(const std::vector<std::string>& paths, const std::string& lexeme, ThreadPool& pool, size_t& hits)
+{
+    std::atomic<size_t> found{0};
+    auto begin = std::chrono::steady_clock::now();
+    pool.parallelFor(paths.size(), [&](size_t i) {
+        MappedFile mapped;
+        if (!mapped.open(paths[i])) {
+            return;
+        }
+        RustLexer lexer(mapped.data(), mapped.size());
+        Token token;
+        while (lexer.nextToken(token)) {
+            if (token.length == lexeme.size() && lexer.lexeme(token) == lexeme) {
+                found++;
+            }
+        }
+    });
+    hits = found;
+    return secondsSince(begin);
+}
+
+bool writeJson(const std::string& path, const Options& options, size_t threads, uint64_t sourceBytes,
+               double buildSeconds, double saveSeconds, double openMicros, const TokenIndex& index,
+               const std::vector<QueryResult>& queries, double scan, const std::vector<UpdateResult>& updates)
+{
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        return false;
+    }
+
+    std::time_t now = std::time(nullptr);
+    char timestamp[32];
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    std::fprintf(file, "{\n");
+    std::fprintf(file, "  \"benchmark\": \"indexbench\",\n");
+    std::fprintf(file, "  \"timestamp\": \"%s\",\n", timestamp);
+    std::fprintf(file, "  \"seed\": %llu,\n", static_cast<unsigned long long>(options.seed));
+    std::fprintf(file, "  \"threads\": %zu,\n", threads);
+    std::fprintf(file, "  \"files\": %zu,\n", index.fileCount());
+    std::fprintf(file, "  \"source_bytes\": %llu,\n", static_cast<unsigned long long>(sourceBytes));
+    std::fprintf(file, "  \"terms\": %zu,\n", index.termCount());
+    std::fprintf(file, "  \"postings\": %llu,\n", static_cast<unsigned long long>(index.postingCount()));
+    std::fprintf(file, "  \"index_bytes\": %zu,\n", index.byteSize());
+    std::fprintf(file, "  \"build_seconds\": %.6f,\n", buildSeconds);
+    std::fprintf(file, "  \"save_seconds\": %.6f,\n", saveSeconds);
+    std::fprintf(file, "  \"open_microseconds\": %.1f,\n", openMicros);
+    std::fprintf(file, "  \"scan_seconds\": %.6f,\n", scan);
+    std::fprintf(file, "  \"queries\": [\n");
+    for (size_t i = 0; i < queries.size(); i++) {
+        const QueryResult& q = queries[i];
+        std::fprintf(file,
+                     "    {\"name\": \"%s\", \"description\": \"%s\", \"queries\": %zu, \"hits\": %llu, "
+                     "\"median_microseconds\": %.2f, \"p99_microseconds\": %.2f, \"max_microseconds\": %.2f}%s\n",
+                     q.name, q.description, q.queries, static_cast<unsigned long long>(q.hits),
+                     q.medianMicros, q.p99Micros, q.maxMicros, i + 1 < queries.size() ? "," : "");
+    }
+    std::fprintf(file, "  ],\n");
+    std::fprintf(file, "  \"updates\": [\n");
+    for (size_t i = 0; i < updates.size(); i++) {
+        const UpdateResult& u = updates[i];
+        std::fprintf(file,
+                     "    {\"changed_files\": %zu, \"relexed_files\": %zu, \"load_seconds\": %.6f, "
+                     "\"update_seconds\": %.6f, \"save_seconds\": %.6f}%s\n",
+                     u.changed, u.relexed, u.loadSeconds, u.updateSeconds, u.saveSeconds,
+                     i + 1 < updates.size() ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+    return std::fclose(file) == 0;
+}
+
+void printUsage(const char* program)
+{
+    std::printf("用法：%s [--files N] [--queries N] [--jobs N] [--seed N] [--dir 目录] [--keep] [--output 文件]\n",
+                program);
+}
+
+bool parseOptions(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            std::exit(0);
+        }
+        if (arg == "--keep") {
+            options.keep = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "%s 需要一个参数\n", arg.c_str());
+            return false;
+        }
+        const char* value = argv[++i];
+        if (arg == "--files") {
+            options.files = std::strtoul(value, nullptr, 10);
+        } else if (arg == "--queries") {
+            options.queries = std::strtoul(value, nullptr, 10);
+        } else if (arg == "--jobs") {
+            options.threads = std::strtoul(value, nullptr, 10);
+        } else if (arg == "--seed") {
+            options.seed = std::strtoull(value, nullptr, 10);
+        } else if (arg == "--dir") {
+            options.directory = value;
+        } else if (arg == "--output") {
+            options.output = value;
+        } else {
+            std::fprintf(stderr, "未知选项：%s\n", arg.c_str());
+            return false;
+        }
+    }
+    if (options.files == 0 || options.queries == 0) {
+        std::fprintf(stderr, "--files 和 --queries 必须为正数\n");
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+    std::error_code ec;
+    if (options.directory.empty()) {
+        options.directory = (fs::temp_directory_path(ec) / ("indexbench-" + std::to_string(options.seed))).u8string();
+    }
+    fs::remove_all(fs::u8path(options.directory), ec);
+
+    // 生成源码
+    std::vector<std::string> paths;
+    uint64_t sourceBytes = 0;
+    for (size_t module = 0; module < options.files; module++) {
+        paths.push_back(modulePath(options.directory, module));
+        if (module % 100 == 0) {
+            fs::create_directories(fs::u8path(paths.back()).parent_path(), ec);
+        }
+        std::string source = generateModule(module, options.files, options.seed);
+        sourceBytes += source.size();
+        if (!writeFile(paths.back(), source)) {
+            std::fprintf(stderr, "无法写入 %s\n", paths.back().c_str());
+            return 1;
+        }
+    }
+    std::string indexPath = (fs::u8path(options.directory) / "index.rlix").u8string();
+    std::printf("生成 %zu 个文件，%.1f MB，目录 %s\n", paths.size(), double(sourceBytes) / 1e6,
+                options.directory.c_str());
+
+    // 全量建立
+    ThreadPool pool(options.threads);
+    double buildSeconds;
+    double saveSeconds;
+    {
+        TokenIndexBuilder builder;
+        auto begin = std::chrono::steady_clock::now();
+        builder.update(paths, pool);
+        buildSeconds = secondsSince(begin);
+        begin = std::chrono::steady_clock::now();
+        if (!builder.save(indexPath)) {
+            std::fprintf(stderr, "无法写入 %s\n", indexPath.c_str());
+            return 1;
+        }
+        saveSeconds = secondsSince(begin);
+    }
+
+    auto openBegin = std::chrono::steady_clock::now();
+    TokenIndex index;
+    if (!index.open(indexPath)) {
+        std::fprintf(stderr, "%s\n", index.errorString().c_str());
+        return 1;
+    }
+    double openMicros = secondsSince(openBegin) * 1e6;
+    std::printf("建立 %.1f ms（%zu 线程，%.1f MB/s），写出 %.1f ms，映射 %.1f us\n",
+                buildSeconds * 1e3, pool.threadCount(), double(sourceBytes) / 1e6 / buildSeconds,
+                saveSeconds * 1e3, openMicros);
+    std::printf("%zu 个词条，%llu 次出现，索引 %.1f MB（每次出现 %.2f 字节）\n", index.termCount(),
+                static_cast<unsigned long long>(index.postingCount()), double(index.byteSize()) / 1e6,
+                double(index.byteSize()) / double(std::max<uint64_t>(index.postingCount(), 1)));
+
+    // 查询：高频的局部变量名、只在少数文件中出现的函数名、十六进制常量和不存在的名字
+    Random rng(options.seed);
+    std::vector<std::string> common;
+    std::vector<std::string> rare;
+    std::vector<std::string> literals;
+    std::vector<std::string> missing;
+    for (size_t i = 0; i < options.queries; i++) {
+        size_t module = rng() % options.files;
+        common.push_back(pick(rng, COMMON));
+        rare.push_back(functionName(module, rng() % functionCount(module)));
+        literals.push_back(constantLiteral(module));
+        missing.push_back("missing_" + std::to_string(rng()));
+    }
+    std::vector<QueryResult> queries = {
+        runQueries(index, "common", "高频的局部变量名和方法名", common),
+        runQueries(index, "rare", "只在定义和少数引用处出现的函数名", rare),
+        runQueries(index, "literal", "十六进制常量", literals),
+        runQueries(index, "missing", "不存在的名字", missing),
+    };
+    std::printf("%-10s %8s %12s %12s %12s %12s\n", "query", "count", "hits", "median us", "p99 us", "max us");
+    for (const QueryResult& q : queries) {
+        std::printf("%-10s %8zu %12llu %12.2f %12.2f %12.2f\n", q.name, q.queries,
+                    static_cast<unsigned long long>(q.hits), q.medianMicros, q.p99Micros, q.maxMicros);
+    }
+
+    size_t scanHits = 0;
+    double scan = scanSeconds(paths, rare.front(), pool, scanHits);
+    std::printf("对照：不用索引逐个分析全部文件查找 %s：%.1f ms，%zu 处\n", rare.front().c_str(), scan * 1e3, scanHits);
+
+    // 增量更新：改写若干文件后从索引文件开始更新并写回
+    index.close();
+    std::vector<UpdateResult> updates;
+    std::printf("%-10s %10s %12s %12s %12s\n", "changed", "relexed", "load ms", "update ms", "save ms");
+    for (size_t changed : {size_t(1), size_t(10), size_t(100)}) {
+        if (changed > paths.size()) {
+            break;
+        }
+        UpdateResult u = runUpdate(options, paths, indexPath, changed, pool, rng);
+        std::printf("%-10zu %10zu %12.1f %12.1f %12.1f\n", u.changed, u.relexed, u.loadSeconds * 1e3,
+                    u.updateSeconds * 1e3, u.saveSeconds * 1e3);
+        updates.push_back(u);
+    }
+
+    index.open(indexPath);
+    bool written = writeJson(options.output, options, pool.threadCount(), sourceBytes, buildSeconds, saveSeconds,
+                             openMicros, index, queries, scan, updates);
+    index.close();
+    if (!options.keep) {
+        fs::remove_all(fs::u8path(options.directory), ec);
+    }
+    if (!written) {
+        std::fprintf(stderr, "无法写入 %s\n", options.output.c_str());
+        return 1;
+    }
+    std::printf("结果已写入 %s\n", options.output.c_str());
+    return 0;
+}
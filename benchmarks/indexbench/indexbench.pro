@@ -0,0 +1,11 @@
+TEMPLATE = app
+TARGET = indexbench
+
+QT -= core gui
+CONFIG += console c++17 thread
+CONFIG -= app_bundle
+
+include(../../lexer/lexer.pri)
+
+SOURCES += \
+    indexbench.cpp
@@ -0,0 +1,108 @@
+// 关键字识别微基准：比较编译期完美哈希 isRustKeyword() 与原先的
+// std::unordered_set<std::string> 查找（每次先 substr 构造字符串）。
+//
+// 用法：keywordbench [轮数]
+
+#include "keywords.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+// 实际Rust代码中常见的非关键字标识符
+const char* const COMMON_IDENTIFIERS[] = {
+    "x", "i", "n", "len", "new", "iter", "map", "unwrap", "Vec", "String",
+    "Option", "Some", "None", "Ok", "Err", "Result", "value", "data", "buffer",
+    "index", "count", "into", "from", "clone", "push", "insert", "get", "is_empty",
+    "HashMap", "Box", "Rc", "Arc", "usize", "u8", "i32", "f64", "str", "println",
+    "format", "assert_eq", "writer", "reader", "config", "selfish", "types", "matches"
+};
+
+struct Word {
+    size_t offset;
+    size_t length;
+};
+
+// 以固定种子生成约30%关键字、70%普通标识符的单词流
+void buildWorkload(std::string& source, std::vector<Word>& words, size_t count)
+{
+    std::mt19937 rng(20240521u);
+    const size_t identifierCount = sizeof(COMMON_IDENTIFIERS) / sizeof(COMMON_IDENTIFIERS[0]);
+    std::uniform_int_distribution<size_t> pickKeyword(0, RUST_KEYWORD_COUNT - 1);
+    std::uniform_int_distribution<size_t> pickIdentifier(0, identifierCount - 1);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    for (size_t i = 0; i < count; i++) {
+        std::string_view word = percent(rng) < 30
+            ? RUST_KEYWORDS[pickKeyword(rng)]
+            : std::string_view(COMMON_IDENTIFIERS[pickIdentifier(rng)]);
+        words.push_back({source.size(), word.size()});
+        source.append(word.data(), word.size());
+        source.push_back(' ');
+    }
+}
+
+template <typename Fn>
+double measure(const char* name, int rounds, size_t wordCount, Fn&& fn)
+{
+    size_t hits = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        hits += fn();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(end - begin).count();
+    double perLookup = ns / (double(rounds) * double(wordCount));
+    std::printf("%-28s %8.2f ns/lookup  (hits=%zu)\n", name, perLookup, hits);
+    return perLookup;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int rounds = argc > 1 ? std::atoi(argv[1]) : 50;
+    if (rounds <= 0) {
+        rounds = 50;
+    }
+
+    const size_t wordCount = 1 << 20;
+    std::string source;
+    std::vector<Word> words;
+    buildWorkload(source, words, wordCount);
+
+    // 原实现：每个标识符 substr 出 std::string 再查哈希集合
+    std::unordered_set<std::string> keywordSet;
+    for (std::string_view kw : RUST_KEYWORDS) {
+        keywordSet.emplace(kw);
+    }
+
+    std::printf("%zu words, %d rounds\n", wordCount, rounds);
+
+    double setTime = measure("unordered_set<string>", rounds, wordCount, [&]() {
+        size_t hits = 0;
+        for (const Word& w : words) {
+            std::string text = source.substr(w.offset, w.length);
+            hits += keywordSet.find(text) != keywordSet.end();
+        }
+        return hits;
+    });
+
+    double perfectTime = measure("isRustKeyword (perfect hash)", rounds, wordCount, [&]() {
+        size_t hits = 0;
+        for (const Word& w : words) {
+            hits += isRustKeyword(source.data() + w.offset, w.length);
+        }
+        return hits;
+    });
+
+    std::printf("speedup: %.2fx\n", setTime / perfectTime);
+    return 0;
+}
@@ -0,0 +1,705 @@
+// 词法分析吞吐量基准：以固定种子生成几类典型的Rust源码，
+// 分别测量 tokenize() 的 MB/s、tokens/s、每个单词的堆分配次数和峰值内存，
+// 并把结果写入 JSON 文件，便于比较不同版本。
+//
+// 用法：lexbench [选项]
+//   --size <MiB>     每类源码的大小（默认 8）
+//   --rounds <N>     每类重复测量的轮数，取最快一轮（默认 5）
+//   --seed <N>       生成器种子（默认 20240521）
+//   --mix <名称>     只运行指定类别，可重复给出
+//   --profile <名称> 输出配置（默认 all，见 PROFILES），比较过滤和只计数时的开销
+//   --backend <名称> 快速跳过内核：scalar、sse2 或 avx2（默认按CPU自动选择），比较各实现的吞吐量
+//   --output <文件>  结果文件（默认 lexbench.json）
+
+#include "fastskip.h"
+#include "rustlexer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+// ---- 堆分配计数：替换全局 operator new ----
+
+namespace {
+std::atomic<size_t> allocationCount{0};
+std::atomic<size_t> allocatedBytes{0};
+}
+
+void* operator new(size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace {
+
+// ---- 源码生成器 ----
+
+using Random = std::mt19937_64;
+
+const char* const IDENTIFIERS[] = {
+    "x", "i", "n", "len", "value", "data", "buffer", "index", "count", "config",
+    "reader", "writer", "state", "result", "parser", "token", "node", "entry",
+    "request", "response", "handle", "context", "items", "offset", "capacity"
+};
+
+const char* const TYPES[] = {
+    "u8", "u32", "usize", "i64", "f64", "bool", "String", "Vec<u8>", "Option<usize>",
+    "HashMap<String, usize>", "Box<dyn Error>", "Arc<Mutex<State>>", "Result<(), Error>"
+};
+
+const char* const METHODS[] = {
+    "iter", "map", "filter", "collect", "unwrap", "clone", "len", "push", "insert",
+    "get", "is_empty", "into", "as_ref", "to_string", "expect", "and_then", "ok_or"
+};
+
+const char* const WORDS[] = {
+    "the", "parser", "returns", "an", "error", "when", "input", "is", "empty", "and",
+    "otherwise", "consumes", "bytes", "until", "a", "delimiter", "see", "also", "this",
+    "function", "panics", "if", "buffer", "overflows", "safety", "caller", "must", "ensure"
+};
+
+// 非ASCII标识符（UTF-8）：拉丁扩展、希腊、西里尔和中日文字
+const char* const UNICODE_IDENTIFIERS[] = {
+    "größe", "länge", "café", "índice", "π", "αβγ", "Δt", "значение", "счётчик",
+    "宽度", "高度", "变量", "数据", "结果", "名前", "値"
+};
+
+const char* const UNICODE_WORDS[] = {
+    "返回", "错误", "输入", "为空", "时", "否则", "读取", "字节", "直到", "分隔符",
+    "→", "≤", "¿qué?", "ñandú", "Ωμέγα", "данные"
+};
+
+template <size_t N>
+const char* pick(Random& rng, const char* const (&items)[N])
+{
+    return items[rng() % N];
+}
+
+size_t uniform(Random& rng, size_t low, size_t high)
+{
+    return low + rng() % (high - low + 1);
+}
+
+void appendSentence(Random& rng, std::string& out, size_t words)
+{
+    for (size_t i = 0; i < words; i++) {
+        if (i > 0) {
+            out += ' ';
+        }
+        out += pick(rng, WORDS);
+    }
+}
+
+// 标识符密集：函数定义、let 绑定、路径和方法链
+void identifierItem(Random& rng, std::string& out)
+{
+    out += "pub fn ";
+    out += pick(rng, IDENTIFIERS);
+    out += "_";
+    out += pick(rng, METHODS);
+    out += "(&self, ";
+    out += pick(rng, IDENTIFIERS);
+    out += ": ";
+    out += pick(rng, TYPES);
+    out += ") -> ";
+    out += pick(rng, TYPES);
+    out += " {\n";
+    size_t statements = uniform(rng, 2, 6);
+    for (size_t i = 0; i < statements; i++) {
+        out += "    let ";
+        if (rng() % 3 == 0) {
+            out += "mut ";
+        }
+        out += pick(rng, IDENTIFIERS);
+        out += " = self.";
+        out += pick(rng, IDENTIFIERS);
+        size_t chain = uniform(rng, 1, 4);
+        for (size_t c = 0; c < chain; c++) {
+            out += '.';
+            out += pick(rng, METHODS);
+            out += "()";
+        }
+        out += ";\n";
+    }
+    out += "    std::collections::HashMap::new()\n}\n\n";
+}
+
+void appendNumber(Random& rng, std::string& out)
+{
+    char buffer[64];
+    switch (rng() % 7) {
+    case 0:
+        std::snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(rng() % 100000));
+        break;
+    case 1:
+        std::snprintf(buffer, sizeof(buffer), "0x%llX", static_cast<unsigned long long>(rng() >> 16));
+        break;
+    case 2:
+        std::snprintf(buffer, sizeof(buffer), "0b%d%d%d%d_%d%d%d%du8",
+                      int(rng() & 1), int(rng() & 1), int(rng() & 1), int(rng() & 1),
+                      int(rng() & 1), int(rng() & 1), int(rng() & 1), int(rng() & 1));
+        break;
+    case 3:
+        std::snprintf(buffer, sizeof(buffer), "0o%llo", static_cast<unsigned long long>(rng() % 4096));
+        break;
+    case 4:
+        std::snprintf(buffer, sizeof(buffer), "%llu_%03llu_%03llu",
+                      static_cast<unsigned long long>(rng() % 1000),
+                      static_cast<unsigned long long>(rng() % 1000),
+                      static_cast<unsigned long long>(rng() % 1000));
+        break;
+    case 5:
+        std::snprintf(buffer, sizeof(buffer), "%.6f", double(rng() % 1000000) / 997.0);
+        break;
+    default:
+        std::snprintf(buffer, sizeof(buffer), "%.3fe%d_f64", double(rng() % 10000) / 1000.0,
+                      int(rng() % 40) - 20);
+        break;
+    }
+    out += buffer;
+}
+
+// 数字字面量密集：常量表和数组
+void numericItem(Random& rng, std::string& out)
+{
+    out += "const ";
+    out += pick(rng, IDENTIFIERS);
+    out += "_TABLE: [u64; 16] = [";
+    for (size_t i = 0; i < 16; i++) {
+        if (i > 0) {
+            out += i % 4 == 0 ? ",\n    " : ", ";
+        }
+        appendNumber(rng, out);
+    }
+    out += "];\n";
+}
+
+// 注释与文档密集：模块文档、条目文档、行注释和文档块
+void commentItem(Random& rng, std::string& out)
+{
+    if (rng() % 4 == 0) {
+        out += "//! ";
+        appendSentence(rng, out, uniform(rng, 6, 14));
+        out += '\n';
+    }
+    size_t lines = uniform(rng, 2, 8);
+    for (size_t i = 0; i < lines; i++) {
+        out += "/// ";
+        appendSentence(rng, out, uniform(rng, 4, 16));
+        out += '\n';
+    }
+    if (rng() % 3 == 0) {
+        out += "/**\n * ";
+        appendSentence(rng, out, uniform(rng, 8, 24));
+        out += "\n */\n";
+    }
+    out += "fn ";
+    out += pick(rng, IDENTIFIERS);
+    out += "() {} // ";
+    appendSentence(rng, out, uniform(rng, 3, 10));
+    out += "\n\n";
+}
+
+// 字符串密集：普通字符串（含转义）、字节字符串和字符字面量
+void stringItem(Random& rng, std::string& out)
+{
+    out += "println!(\"";
+    appendSentence(rng, out, uniform(rng, 2, 10));
+    out += ": {}\\n\", ";
+    out += pick(rng, IDENTIFIERS);
+    out += ");\nlet ";
+    out += pick(rng, IDENTIFIERS);
+    out += " = \"";
+    size_t words = uniform(rng, 3, 20);
+    for (size_t i = 0; i < words; i++) {
+        out += pick(rng, WORDS);
+        switch (rng() % 6) {
+        case 0: out += "\\t"; break;
+        case 1: out += "\\\""; break;
+        case 2: out += "\\\\"; break;
+        default: out += ' '; break;
+        }
+    }
+    out += "\";\nlet bytes = b\"";
+    appendSentence(rng, out, uniform(rng, 1, 6));
+    out += "\";\nlet c = '";
+    out += static_cast<char>('a' + rng() % 26);
+    out += "';\nlet escaped = '\\n';\n";
+}
+
+// 非ASCII标识符、注释和字符串：验证 UTF-8 解码路径
+void unicodeItem(Random& rng, std::string& out)
+{
+    out += "/// ";
+    size_t words = uniform(rng, 3, 10);
+    for (size_t i = 0; i < words; i++) {
+        out += pick(rng, UNICODE_WORDS);
+        out += ' ';
+    }
+    out += "\nfn ";
+    out += pick(rng, UNICODE_IDENTIFIERS);
+    out += "_";
+    out += pick(rng, IDENTIFIERS);
+    out += "(";
+    out += pick(rng, UNICODE_IDENTIFIERS);
+    out += ": ";
+    out += pick(rng, TYPES);
+    out += ") {\n";
+    size_t statements = uniform(rng, 2, 6);
+    for (size_t i = 0; i < statements; i++) {
+        out += "    let ";
+        out += pick(rng, UNICODE_IDENTIFIERS);
+        out += " = ";
+        out += rng() % 2 ? pick(rng, UNICODE_IDENTIFIERS) : pick(rng, IDENTIFIERS);
+        out += '.';
+        out += pick(rng, METHODS);
+        out += "(\"";
+        out += pick(rng, UNICODE_WORDS);
+        out += "\", '";
+        out += rng() % 2 ? "字" : "c";
+        out += "');\n";
+    }
+    out += "}\n\n";
+}
+
+// 深度嵌套的块注释
+void nestedCommentItem(Random& rng, std::string& out)
+{
+    size_t depth = uniform(rng, 1, 8);
+    for (size_t i = 0; i < depth; i++) {
+        out += "/* ";
+        appendSentence(rng, out, uniform(rng, 1, 6));
+        out += i % 2 == 0 ? "\n" : " * ";
+    }
+    for (size_t i = 0; i < depth; i++) {
+        appendSentence(rng, out, uniform(rng, 0, 3));
+        out += " */";
+    }
+    out += "\nstruct ";
+    out += pick(rng, IDENTIFIERS);
+    out += ";\n";
+}
+
+using ItemGenerator = void (*)(Random&, std::string&);
+
+// 混合：按近似真实代码的比例从各类条目中抽取
+void mixedItem(Random& rng, std::string& out)
+{
+    size_t roll = rng() % 100;
+    ItemGenerator item = roll < 50 ? identifierItem
+                       : roll < 65 ? commentItem
+                       : roll < 80 ? stringItem
+                       : roll < 95 ? numericItem
+                                   : nestedCommentItem;
+    item(rng, out);
+}
+
+struct Mix {
+    const char* name;
+    const char* description;
+    ItemGenerator item;
+};
+
+// 每类的种子是 --seed 加上它在表中的下标，新类别只能追加在末尾，
+// 否则已有类别生成的源码会改变，与旧的结果无法比较
+const Mix MIXES[] = {
+    {"identifiers", "标识符、路径和方法链密集", identifierItem},
+    {"numbers", "各种进制和后缀的数字字面量密集", numericItem},
+    {"comments", "行注释和文档注释密集", commentItem},
+    {"strings", "带转义的字符串、字节字符串和字符字面量密集", stringItem},
+    {"nested-comments", "深度嵌套的块注释", nestedCommentItem},
+    {"mixed", "按近似真实代码比例混合", mixedItem},
+    {"unicode", "非ASCII标识符、注释和字符串", unicodeItem},
+};
+
+std::string generate(const Mix& mix, uint64_t seed, size_t targetBytes)
+{
+    Random rng(seed);
+    std::string out;
+    out.reserve(targetBytes + 4096);
+    while (out.size() < targetBytes) {
+        mix.item(rng, out);
+    }
+    return out;
+}
+
+// ---- 测量 ----
+
+// 输出配置：all 即 tokenize()，其余经 LexOptions 过滤，count 只计数
+struct Profile {
+    const char* name;
+    const char* description;
+    LexOptions options;
+    bool countOnly;
+};
+
+const Profile PROFILES[] = {
+    {"all", "全部单词", LexOptions(), false},
+    {"no-comments", "除注释外的单词", LexOptions::withoutComments(), false},
+    {"identifiers", "只有标识符和关键字", LexOptions::only({TokenType::IDENTIFIER, TokenType::KEYWORD}), false},
+    {"kinds", "全部单词，只保存种类", LexOptions{ALL_TOKEN_TYPES, false}, false},
+    {"count", "只统计各类单词个数", LexOptions(), true},
+};
+
+const Profile* profileByName(const std::string& name)
+{
+    for (const Profile& profile : PROFILES) {
+        if (name == profile.name) {
+            return &profile;
+        }
+    }
+    return nullptr;
+}
+
+struct Options {
+    size_t megabytes = 8;
+    int rounds = 5;
+    uint64_t seed = 20240521u;
+    std::vector<std::string> mixes;
+    std::string output = "lexbench.json";
+    const Profile* profile = &PROFILES[0];
+    bool forceBackend = false;
+    FastSkipBackend backend = FastSkipBackend::Scalar;
+};
+
+struct MixResult {
+    const Mix* mix = nullptr;
+    size_t bytes = 0;
+    size_t tokens = 0;          // 输出的单词数
+    double bestSeconds = 0.0;
+    double medianSeconds = 0.0;
+    double allocationsPerToken = 0.0;
+    double allocatedBytesPerToken = 0.0;
+    size_t peakRssBytes = 0;
+};
+
+#ifdef _WIN32
+// 进程启动以来的峰值工作集（字节），只增不减
+size_t peakResidentBytes()
+{
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+}
+#else
+// 子进程的峰值常驻内存（字节）
+size_t peakResidentBytes(const struct rusage& usage)
+{
+#if defined(__APPLE__)
+    return static_cast<size_t>(usage.ru_maxrss);         // macOS 以字节计
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;  // Linux 以KiB计
+#endif
+}
+#endif
+
+MixResult runMix(const Mix& mix, const Options& options, uint64_t seed)
+{
+    MixResult result;
+    result.mix = &mix;
+
+    std::string source = generate(mix, seed, options.megabytes * 1024 * 1024);
+    result.bytes = source.size();
+
+    std::vector<double> seconds;
+    for (int round = 0; round < options.rounds; round++) {
+        // 借用源码缓冲区，构造本身不复制也不分配
+        RustLexer lexer(source.data(), source.size());
+        size_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+        size_t bytesBefore = allocatedBytes.load(std::memory_order_relaxed);
+
+        auto begin = std::chrono::steady_clock::now();
+        size_t emitted;
+        if (options.profile->countOnly) {
+            emitted = size_t(lexer.countTokens(options.profile->options).total());
+        } else {
+            emitted = lexer.tokenize(options.profile->options).size();
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        seconds.push_back(std::chrono::duration<double>(end - begin).count());
+        result.tokens = emitted;
+        if (round == 0 && emitted != 0) {
+            double count = double(emitted);
+            result.allocationsPerToken = double(allocationCount.load(std::memory_order_relaxed) - allocationsBefore) / count;
+            result.allocatedBytesPerToken = double(allocatedBytes.load(std::memory_order_relaxed) - bytesBefore) / count;
+        }
+    }
+
+    std::sort(seconds.begin(), seconds.end());
+    result.bestSeconds = seconds.front();
+    result.medianSeconds = seconds[seconds.size() / 2];
+    return result;
+}
+
+// 峰值常驻内存是整个进程的，只增不减：同一进程中先运行的大类会掩盖后面各类的峰值。
+// 因此每类在 fork 出的子进程中生成源码并测量，结果经管道传回，峰值取该子进程的 ru_maxrss。
+// fork 时父进程还没有生成任何源码，子进程继承的常驻内存只有几 MiB。
+// Windows 没有 fork，仍在本进程中运行，峰值是到此为止整个进程的
+bool runMixIsolated(const Mix& mix, const Options& options, uint64_t seed, MixResult& result)
+{
+#ifdef _WIN32
+    result = runMix(mix, options, seed);
+    result.peakRssBytes = peakResidentBytes();
+    return true;
+#else
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return false;
+    }
+    // 子进程会继承标准输出缓冲区中尚未写出的内容
+    std::fflush(stdout);
+    pid_t child = fork();
+    if (child < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+    if (child == 0) {
+        close(fds[0]);
+        MixResult measured = runMix(mix, options, seed);
+        bool written = write(fds[1], &measured, sizeof(measured)) == ssize_t(sizeof(measured));
+        _exit(written ? 0 : 1);
+    }
+
+    close(fds[1]);
+    size_t received = 0;
+    char* buffer = reinterpret_cast<char*>(&result);
+    while (received < sizeof(result)) {
+        ssize_t n = read(fds[0], buffer + received, sizeof(result) - received);
+        if (n <= 0) {
+            break;
+        }
+        received += size_t(n);
+    }
+    close(fds[0]);
+
+    int status = 0;
+    struct rusage usage;
+    if (wait4(child, &status, 0, &usage) != child || !WIFEXITED(status) || WEXITSTATUS(status) != 0
+        || received != sizeof(result)) {
+        return false;
+    }
+    result.peakRssBytes = peakResidentBytes(usage);
+    return true;
+#endif
+}
+
+double rate(double amount, double seconds)
+{
+    return seconds > 0.0 ? amount / seconds : 0.0;
+}
+
+bool writeJson(const std::string& path, const Options& options, const std::vector<MixResult>& results)
+{
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        return false;
+    }
+
+    std::time_t now = std::time(nullptr);
+    char timestamp[32];
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    std::fprintf(file, "{\n");
+    std::fprintf(file, "  \"benchmark\": \"lexbench\",\n");
+    std::fprintf(file, "  \"timestamp\": \"%s\",\n", timestamp);
+    std::fprintf(file, "  \"seed\": %llu,\n", static_cast<unsigned long long>(options.seed));
+    std::fprintf(file, "  \"rounds\": %d,\n", options.rounds);
+    std::fprintf(file, "  \"profile\": \"%s\",\n", options.profile->name);
+    std::fprintf(file, "  \"backend\": \"%s\",\n", fastSkipBackendName(fastSkipBackend()));
+    std::fprintf(file, "  \"mixes\": [\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const MixResult& r = results[i];
+        std::fprintf(file,
+                     "    {\"name\": \"%s\", \"description\": \"%s\", \"bytes\": %zu, \"tokens\": %zu, "
+                     "\"best_seconds\": %.6f, \"median_seconds\": %.6f, "
+                     "\"mb_per_second\": %.2f, \"tokens_per_second\": %.0f, "
+                     "\"allocations_per_token\": %.6f, \"allocated_bytes_per_token\": %.3f, "
+                     "\"peak_rss_bytes\": %zu}%s\n",
+                     r.mix->name, r.mix->description, r.bytes, r.tokens, r.bestSeconds, r.medianSeconds,
+                     rate(double(r.bytes) / 1e6, r.bestSeconds), rate(double(r.tokens), r.bestSeconds),
+                     r.allocationsPerToken, r.allocatedBytesPerToken, r.peakRssBytes,
+                     i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+    return std::fclose(file) == 0;
+}
+
+bool backendByName(const std::string& name, FastSkipBackend& backend)
+{
+    const FastSkipBackend backends[] = {FastSkipBackend::Scalar, FastSkipBackend::SSE2, FastSkipBackend::AVX2};
+    for (FastSkipBackend candidate : backends) {
+        if (name == fastSkipBackendName(candidate)) {
+            backend = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+void printUsage(const char* program)
+{
+    std::printf("用法：%s [--size MiB] [--rounds N] [--seed N] [--mix 名称]... [--profile 名称] [--backend 名称]"
+                " [--output 文件]\n类别：",
+                program);
+    for (const Mix& mix : MIXES) {
+        std::printf(" %s", mix.name);
+    }
+    std::printf("\n快速跳过内核：scalar sse2 avx2\n输出配置：\n");
+    for (const Profile& profile : PROFILES) {
+        std::printf("  %-12s %s\n", profile.name, profile.description);
+    }
+}
+
+bool parseOptions(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            std::exit(0);
+        }
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "%s 需要一个参数\n", arg.c_str());
+            return false;
+        }
+        const char* value = argv[++i];
+        if (arg == "--size") {
+            options.megabytes = std::strtoul(value, nullptr, 10);
+        } else if (arg == "--rounds") {
+            options.rounds = std::atoi(value);
+        } else if (arg == "--seed") {
+            options.seed = std::strtoull(value, nullptr, 10);
+        } else if (arg == "--mix") {
+            options.mixes.push_back(value);
+        } else if (arg == "--profile") {
+            options.profile = profileByName(value);
+            if (!options.profile) {
+                std::fprintf(stderr, "未知的输出配置：%s\n", value);
+                return false;
+            }
+        } else if (arg == "--backend") {
+            if (!backendByName(value, options.backend)) {
+                std::fprintf(stderr, "未知的快速跳过内核：%s\n", value);
+                return false;
+            }
+            options.forceBackend = true;
+        } else if (arg == "--output") {
+            options.output = value;
+        } else {
+            std::fprintf(stderr, "未知选项：%s\n", arg.c_str());
+            return false;
+        }
+    }
+    if (options.megabytes == 0 || options.rounds <= 0) {
+        std::fprintf(stderr, "--size 和 --rounds 必须为正数\n");
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    // 在 fork 测量进程之前选定，各子进程继承同一实现
+    if (options.forceBackend) {
+        FastSkipBackend selected = selectFastSkipBackend(options.backend);
+        if (selected != options.backend) {
+            std::printf("CPU 不支持 %s，改用 %s\n", fastSkipBackendName(options.backend),
+                        fastSkipBackendName(selected));
+        }
+    }
+
+    std::vector<MixResult> results;
+    std::printf("输出配置：%s（%s），快速跳过内核：%s\n", options.profile->name, options.profile->description,
+                fastSkipBackendName(fastSkipBackend()));
+    std::printf("%-16s %10s %10s %9s %14s %12s %10s\n",
+                "mix", "MiB", "tokens", "MB/s", "tokens/s", "allocs/tok", "peak RSS");
+    for (size_t index = 0; index < sizeof(MIXES) / sizeof(MIXES[0]); index++) {
+        const Mix& mix = MIXES[index];
+        if (!options.mixes.empty()
+            && std::find(options.mixes.begin(), options.mixes.end(), mix.name) == options.mixes.end()) {
+            continue;
+        }
+        // 每类使用不同但固定的种子，单独运行某一类时生成的源码不变
+        MixResult r;
+        if (!runMixIsolated(mix, options, options.seed + index, r)) {
+            std::fprintf(stderr, "%s：测量进程失败\n", mix.name);
+            return 1;
+        }
+        std::printf("%-16s %10.1f %10zu %9.1f %14.0f %12.5f %8.1f MiB\n",
+                    mix.name, double(r.bytes) / (1024.0 * 1024.0), r.tokens,
+                    rate(double(r.bytes) / 1e6, r.bestSeconds), rate(double(r.tokens), r.bestSeconds),
+                    r.allocationsPerToken, double(r.peakRssBytes) / (1024.0 * 1024.0));
+        std::fflush(stdout);
+        results.push_back(r);
+    }
+
+    if (results.empty()) {
+        std::fprintf(stderr, "没有匹配的类别\n");
+        return 2;
+    }
+    if (!writeJson(options.output, options, results)) {
+        std::fprintf(stderr, "无法写入 %s\n", options.output.c_str());
+        return 1;
+    }
+    std::printf("结果已写入 %s\n", options.output.c_str());
+    return 0;
+}
@@ -0,0 +1,14 @@
+TEMPLATE = app
+TARGET = lexbench
+
+QT -= core gui
+CONFIG += console c++17
+CONFIG -= app_bundle
+
+include(../../lexer/lexer.pri)
+
+# 峰值内存通过 GetProcessMemoryInfo 读取
+win32: LIBS += -lpsapi
+
+SOURCES += \
+    lexbench.cpp
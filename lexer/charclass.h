@@ -0,0 +1,107 @@
+#ifndef CHARCLASS_H
+#define CHARCLASS_H
+
+#include <cstdint>
+#include <cstddef>
+
+// 字符类别位标志，与区域设置无关，只对ASCII字节置位
+enum CharClassFlag : uint16_t {
+    CC_SPACE            = 1 << 0,   // 空白字符（与C区域设置下的isspace一致）
+    CC_ALPHA            = 1 << 1,   // 字母
+    CC_DIGIT            = 1 << 2,   // 十进制数字
+    CC_HEX_DIGIT        = 1 << 3,   // 十六进制数字
+    CC_OCTAL_DIGIT      = 1 << 4,   // 八进制数字
+    CC_BINARY_DIGIT     = 1 << 5,   // 二进制数字
+    CC_IDENT_START      = 1 << 6,   // 标识符首字符：字母或下划线
+    CC_IDENT_CONTINUE   = 1 << 7,   // 标识符后续字符：字母、数字或下划线
+    CC_UNDERSCORE       = 1 << 8    // 下划线，数字字面量中的分隔符
+};
+
+// 单词首字节对应的子扫描器类别，scanToken()据此查表分派
+enum class ScanClass : uint8_t {
+    Operator,       // 运算符、分隔符及其他字节
+    Whitespace,     // 空白
+    Identifier,     // 标识符或关键字
+    Number,         // 数字字面量
+    String,         // 字符串字面量
+    Char,           // 字符字面量、生命周期或标签
+    Slash,          // '/'：注释或除法运算符
+    Unicode,        // 非ASCII字节：UTF-8 编码的标识符或其他码点
+    Count
+};
+
+struct CharClassTable {
+    uint16_t flags[256];
+    ScanClass scanClass[256];
+};
+
+constexpr CharClassTable buildCharClassTable()
+{
+    CharClassTable table{};
+    for (int c = 0; c < 256; c++) {
+        uint16_t f = 0;
+        bool alpha = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+        bool digit = c >= '0' && c <= '9';
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r') {
+            f |= CC_SPACE;
+        }
+        if (alpha) {
+            f |= CC_ALPHA;
+        }
+        if (digit) {
+            f |= CC_DIGIT;
+        }
+        if (digit || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F')) {
+            f |= CC_HEX_DIGIT;
+        }
+        if (c >= '0' && c <= '7') {
+            f |= CC_OCTAL_DIGIT;
+        }
+        if (c == '0' || c == '1') {
+            f |= CC_BINARY_DIGIT;
+        }
+        if (c == '_') {
+            f |= CC_UNDERSCORE;
+        }
+        if (alpha || c == '_') {
+            f |= CC_IDENT_START;
+        }
+        if (alpha || digit || c == '_') {
+            f |= CC_IDENT_CONTINUE;
+        }
+        table.flags[c] = f;
+
+        ScanClass sc = ScanClass::Operator;
+        if (f & CC_SPACE) {
+            sc = ScanClass::Whitespace;
+        } else if (f & CC_IDENT_START) {
+            sc = ScanClass::Identifier;
+        } else if (digit) {
+            sc = ScanClass::Number;
+        } else if (c == '"') {
+            sc = ScanClass::String;
+        } else if (c == '\'') {
+            sc = ScanClass::Char;
+        } else if (c == '/') {
+            sc = ScanClass::Slash;
+        } else if (c >= 0x80) {
+            sc = ScanClass::Unicode;
+        }
+        table.scanClass[c] = sc;
+    }
+    return table;
+}
+
+constexpr CharClassTable CHAR_CLASS_TABLE = buildCharClassTable();
+
+inline bool hasCharClass(char c, uint16_t mask)
+{
+    return (CHAR_CLASS_TABLE.flags[static_cast<unsigned char>(c)] & mask) != 0;
+}
+
+inline ScanClass scanClassOf(char c)
+{
+    return CHAR_CLASS_TABLE.scanClass[static_cast<unsigned char>(c)];
+}
+
+#endif // CHARCLASS_H
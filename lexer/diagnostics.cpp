@@ -0,0 +1,103 @@
+#include "diagnostics.h"
+#include "unicodeident.h"
+
+namespace {
+
+// 块注释 text 的嵌套层数是否恰好在末尾回到0
+bool blockCommentClosed(std::string_view text)
+{
+    int nesting = 0;
+    size_t i = 0;
+    while (i + 1 < text.size()) {
+        if (text[i] == '/' && text[i + 1] == '*') {
+            nesting++;
+            i += 2;
+        } else if (text[i] == '*' && text[i + 1] == '/') {
+            if (--nesting == 0) {
+                return i + 2 == text.size();
+            }
+            i += 2;
+        } else {
+            i++;
+        }
+    }
+    return false;
+}
+
+// 延续到源码结尾且没有闭合的块注释
+bool unterminatedComment(std::string_view text, size_t end, std::string_view source)
+{
+    return end == source.size() && text.substr(0, 2) == "/*" && !blockCommentClosed(text);
+}
+
+LexErrorKind classifyUnknown(std::string_view text)
+{
+    switch (text[0]) {
+    case '"':
+        return LexErrorKind::UnterminatedString;
+    case '\'':
+        // 以转义开头却没有成为字符字面量的，一定是未闭合（结尾的单引号是被转义的）
+        if (text.size() >= 2 && text.back() == '\'' && text[1] != '\\') {
+            return LexErrorKind::InvalidChar;
+        }
+        return LexErrorKind::UnterminatedChar;
+    default: {
+        char32_t codePoint;
+        if (decodeUtf8(text.data(), text.size(), codePoint) == 0) {
+            return LexErrorKind::InvalidUtf8;
+        }
+        return LexErrorKind::UnexpectedCharacter;
+    }
+    }
+}
+
+} // namespace
+
+const char* lexErrorMessage(LexErrorKind kind)
+{
+    switch (kind) {
+    case LexErrorKind::UnterminatedString:  return "字符串未闭合";
+    case LexErrorKind::UnterminatedChar:    return "字符字面量未闭合";
+    case LexErrorKind::InvalidChar:         return "字符字面量只能包含一个字符";
+    case LexErrorKind::UnterminatedComment: return "块注释未闭合";
+    case LexErrorKind::InvalidUtf8:         return "非法的 UTF-8 字节";
+    case LexErrorKind::UnexpectedCharacter: return "无法识别的字符";
+    }
+    return "";
+}
+
+std::vector<LexDiagnostic> collectDiagnostics(const TokenView& tokens, std::string_view source)
+{
+    // 只看种类字节；未闭合的块注释一定延续到源码结尾，只需检查最后一个单词
+    std::vector<LexDiagnostic> diagnostics;
+    const uint8_t* kinds = tokens.kindData();
+    const uint8_t unknown = TokenKind::encode(TokenType::UNKNOWN, OperatorId::None);
+    for (size_t i = 0; i < tokens.size(); i++) {
+        if (kinds[i] == unknown) {
+            std::string_view text = source.substr(tokens.offset(i), tokens.length(i));
+            diagnostics.push_back({classifyUnknown(text), tokens.offset(i), tokens.length(i)});
+        }
+    }
+    if (!tokens.empty()) {
+        size_t last = tokens.size() - 1;
+        std::string_view text = source.substr(tokens.offset(last), tokens.length(last));
+        if (tokens.type(last) == TokenType::COMMENT && unterminatedComment(text, tokens.end(last), source)) {
+            diagnostics.push_back({LexErrorKind::UnterminatedComment, tokens.offset(last), tokens.length(last)});
+        }
+    }
+    return diagnostics;
+}
+
+bool diagnoseToken(const Token& token, std::string_view source, LexDiagnostic& diagnostic)
+{
+    std::string_view text = token.text(source);
+    if (token.type == TokenType::UNKNOWN) {
+        diagnostic = {classifyUnknown(text), token.offset, token.length};
+        return true;
+    }
+    if (token.type == TokenType::COMMENT && unterminatedComment(text, token.offset + token.length, source)) {
+        diagnostic = {LexErrorKind::UnterminatedComment, token.offset, token.length};
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,42 @@
+#ifndef DIAGNOSTICS_H
+#define DIAGNOSTICS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "tokenstream.h"
+
+// 词法错误的种类。词法分析器遇到错误时不中断，也不另外记录：出错的部分成为有界的
+// UNKNOWN 单词（或延续到源码结尾的块注释），诊断按需从单词序列归类得到，
+// 因此 tokenize()、tokenizeParallel() 和 applyEdit() 的结果都可以直接使用
+enum class LexErrorKind : uint8_t {
+    UnterminatedString,     // 字符串未闭合，单词在开头引号所在行的行尾（同步点）结束
+    UnterminatedChar,       // 字符字面量未闭合，单词在换行、'/' 或源码结尾之前结束
+    InvalidChar,            // 格式错误的字符字面量，如 '' 和 'ab'
+    UnterminatedComment,    // 块注释未闭合，延续到源码结尾
+    InvalidUtf8,            // 非法的 UTF-8 字节
+    UnexpectedCharacter     // 不能开始任何单词的字符，如 '→'
+};
+
+struct LexDiagnostic {
+    LexErrorKind kind;
+    size_t offset;          // 出错单词的起点
+    size_t length;          // 出错单词的长度，分析从 offset + length 处恢复
+};
+
+const char* lexErrorMessage(LexErrorKind kind);
+
+// 归类 tokens 中的全部词法错误，按偏移升序返回；source 为产生 tokens 的源码
+std::vector<LexDiagnostic> collectDiagnostics(const TokenView& tokens, std::string_view source);
+
+inline std::vector<LexDiagnostic> collectDiagnostics(const TokenStream& tokens, std::string_view source)
+{
+    return collectDiagnostics(tokens.view(), source);
+}
+
+// 归类逐个取出的单词（RustLexer::nextToken()），出错时填写 diagnostic 并返回 true。
+// 按顺序对每个 UNKNOWN 和注释单词调用，结果与 collectDiagnostics() 相同
+bool diagnoseToken(const Token& token, std::string_view source, LexDiagnostic& diagnostic);
+
+#endif // DIAGNOSTICS_H
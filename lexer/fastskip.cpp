@@ -0,0 +1,238 @@
+#include "fastskip.h"
+
+#include <atomic>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define FASTSKIP_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define FASTSKIP_TARGET_AVX2
+#else
+#define FASTSKIP_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace {
+
+struct FastSkipKernels {
+    FastSkipBackend backend;
+    size_t (*scanUntil)(const char*, size_t, char, char);
+    size_t (*skipSpaces)(const char*, size_t);
+};
+
+inline bool isSpaceByte(unsigned char c)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// x 不为0
+inline unsigned lowestBit(uint32_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return unsigned(__builtin_ctz(x));
+#else
+    unsigned long index;
+    _BitScanForward(&index, x);
+    return unsigned(index);
+#endif
+}
+
+// ---- 标量实现，也用于处理SIMD块之后的尾部 ----
+
+size_t scanUntilScalarFrom(const char* data, size_t length, char a, char b, size_t i)
+{
+    for (; i < length; i++) {
+        char c = data[i];
+        if (c == a || c == b) {
+            return i;
+        }
+    }
+    return length;
+}
+
+size_t skipSpacesScalarFrom(const char* data, size_t length, size_t i)
+{
+    for (; i < length; i++) {
+        if (!isSpaceByte(static_cast<unsigned char>(data[i]))) {
+            return i;
+        }
+    }
+    return length;
+}
+
+size_t scanUntilScalar(const char* data, size_t length, char a, char b)
+{
+    return scanUntilScalarFrom(data, length, a, b, 0);
+}
+
+size_t skipSpacesScalar(const char* data, size_t length)
+{
+    return skipSpacesScalarFrom(data, length, 0);
+}
+
+#ifdef FASTSKIP_X86
+
+// ---- SSE2：x86-64 的基线指令集，无需运行时检测 ----
+
+size_t scanUntilSSE2(const char* data, size_t length, char a, char b)
+{
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        uint32_t stopMask = uint32_t(_mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(v, va), _mm_cmpeq_epi8(v, vb))));
+        if (stopMask) {
+            return i + lowestBit(stopMask);
+        }
+    }
+    return scanUntilScalarFrom(data, length, a, b, i);
+}
+
+size_t skipSpacesSSE2(const char* data, size_t length)
+{
+    // 空白为 ' ' 或 '\t'..'\r'：后者减去 '\t' 后无符号不大于4
+    const __m128i vspace = _mm_set1_epi8(' ');
+    const __m128i vtab = _mm_set1_epi8('\t');
+    const __m128i vfour = _mm_set1_epi8(4);
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i shifted = _mm_sub_epi8(v, vtab);
+        __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(shifted, vfour), shifted);
+        __m128i space = _mm_or_si128(control, _mm_cmpeq_epi8(v, vspace));
+        uint32_t stopMask = ~uint32_t(_mm_movemask_epi8(space)) & 0xffffu;
+        if (stopMask) {
+            return i + lowestBit(stopMask);
+        }
+    }
+    return skipSpacesScalarFrom(data, length, i);
+}
+
+// ---- AVX2 ----
+
+FASTSKIP_TARGET_AVX2
+size_t scanUntilAVX2(const char* data, size_t length, char a, char b)
+{
+    const __m256i va = _mm256_set1_epi8(a);
+    const __m256i vb = _mm256_set1_epi8(b);
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        uint32_t stopMask = uint32_t(_mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, va), _mm256_cmpeq_epi8(v, vb))));
+        if (stopMask) {
+            return i + lowestBit(stopMask);
+        }
+    }
+    return scanUntilScalarFrom(data, length, a, b, i);
+}
+
+FASTSKIP_TARGET_AVX2
+size_t skipSpacesAVX2(const char* data, size_t length)
+{
+    const __m256i vspace = _mm256_set1_epi8(' ');
+    const __m256i vtab = _mm256_set1_epi8('\t');
+    const __m256i vfour = _mm256_set1_epi8(4);
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i shifted = _mm256_sub_epi8(v, vtab);
+        __m256i control = _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, vfour), shifted);
+        __m256i space = _mm256_or_si256(control, _mm256_cmpeq_epi8(v, vspace));
+        uint32_t stopMask = ~uint32_t(_mm256_movemask_epi8(space));
+        if (stopMask) {
+            return i + lowestBit(stopMask);
+        }
+    }
+    return skipSpacesScalarFrom(data, length, i);
+}
+
+bool cpuSupportsAVX2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // FASTSKIP_X86
+
+const FastSkipKernels SCALAR_KERNELS = {FastSkipBackend::Scalar, scanUntilScalar, skipSpacesScalar};
+#ifdef FASTSKIP_X86
+const FastSkipKernels SSE2_KERNELS = {FastSkipBackend::SSE2, scanUntilSSE2, skipSpacesSSE2};
+const FastSkipKernels AVX2_KERNELS = {FastSkipBackend::AVX2, scanUntilAVX2, skipSpacesAVX2};
+#endif
+
+const FastSkipKernels* kernelsFor(FastSkipBackend backend)
+{
+#ifdef FASTSKIP_X86
+    if (backend == FastSkipBackend::AVX2 && cpuSupportsAVX2()) {
+        return &AVX2_KERNELS;
+    }
+    if (backend != FastSkipBackend::Scalar) {
+        return &SSE2_KERNELS;
+    }
+#else
+    (void)backend;
+#endif
+    return &SCALAR_KERNELS;
+}
+
+std::atomic<const FastSkipKernels*>& activeKernels()
+{
+    static std::atomic<const FastSkipKernels*> kernels{kernelsFor(FastSkipBackend::AVX2)};
+    return kernels;
+}
+
+} // namespace
+
+size_t scanUntil(const char* data, size_t length, char a, char b)
+{
+    return activeKernels().load(std::memory_order_relaxed)->scanUntil(data, length, a, b);
+}
+
+size_t skipSpaces(const char* data, size_t length)
+{
+    return activeKernels().load(std::memory_order_relaxed)->skipSpaces(data, length);
+}
+
+FastSkipBackend fastSkipBackend()
+{
+    return activeKernels().load(std::memory_order_relaxed)->backend;
+}
+
+const char* fastSkipBackendName(FastSkipBackend backend)
+{
+    switch (backend) {
+    case FastSkipBackend::Scalar: return "scalar";
+    case FastSkipBackend::SSE2: return "sse2";
+    case FastSkipBackend::AVX2: return "avx2";
+    }
+    return "unknown";
+}
+
+FastSkipBackend selectFastSkipBackend(FastSkipBackend backend)
+{
+    const FastSkipKernels* kernels = kernelsFor(backend);
+    activeKernels().store(kernels, std::memory_order_relaxed);
+    return kernels->backend;
+}
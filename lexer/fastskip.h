@@ -0,0 +1,33 @@
+#ifndef FASTSKIP_H
+#define FASTSKIP_H
+
+#include <cstddef>
+#include <cstdint>
+
+// 快速跳过内核：在空白、注释体和字符串体中一次比较16/32个字节，
+// 直接定位到下一个需要逐字节处理的位置。行列号由 LineIndex 按需计算，这里不统计换行。
+// 运行时按CPU支持情况在 AVX2、SSE2 和可移植的标量实现之间选择。
+
+enum class FastSkipBackend {
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+// 以下函数返回停止位置（相对起点），未找到时等于输入长度
+
+// 查找第一个等于 a 或 b 的字节
+size_t scanUntil(const char* data, size_t length, char a, char b);
+
+// 查找第一个非空白字节（空白与 CC_SPACE 一致：空格、\t、\n、\v、\f、\r）
+size_t skipSpaces(const char* data, size_t length);
+
+// 当前使用的实现
+FastSkipBackend fastSkipBackend();
+const char* fastSkipBackendName(FastSkipBackend backend);
+
+// 强制指定实现（如 lexbench --backend 比较各实现的吞吐量），CPU不支持时退回到可用的最快实现。
+// 返回实际选用的实现
+FastSkipBackend selectFastSkipBackend(FastSkipBackend backend);
+
+#endif // FASTSKIP_H
@@ -0,0 +1,90 @@
+#ifndef KEYWORDS_H
+#define KEYWORDS_H
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+// Rust严格关键字与保留关键字
+constexpr std::string_view RUST_KEYWORDS[] = {
+    "as", "break", "const", "continue", "crate", "else", "enum", "extern",
+    "false", "fn", "for", "if", "impl", "in", "let", "loop", "match", "mod",
+    "move", "mut", "pub", "ref", "return", "self", "Self", "static", "struct",
+    "super", "trait", "true", "type", "unsafe", "use", "where", "while", "async",
+    "await", "dyn", "abstract", "become", "box", "do", "final", "macro", "override",
+    "priv", "typeof", "unsized", "virtual", "yield", "try"
+};
+
+constexpr size_t RUST_KEYWORD_COUNT = sizeof(RUST_KEYWORDS) / sizeof(RUST_KEYWORDS[0]);
+constexpr size_t KEYWORD_MIN_LENGTH = 2;
+constexpr size_t KEYWORD_MAX_LENGTH = 8;
+
+// 完美哈希参数：取首两字节、末两字节与长度组成32位键，乘法散列后取高7位。
+// 乘数是离线搜索得到的，能把上面的关键字无冲突地映射到128个槽位
+constexpr uint32_t KEYWORD_HASH_MULTIPLIER = 0x40457f5du;
+constexpr unsigned KEYWORD_TABLE_BITS = 7;
+constexpr size_t KEYWORD_TABLE_SIZE = size_t(1) << KEYWORD_TABLE_BITS;
+constexpr uint8_t KEYWORD_EMPTY_SLOT = 0xff;
+
+// 调用方保证 2 <= n <= KEYWORD_MAX_LENGTH
+constexpr uint32_t keywordHash(const char* p, size_t n)
+{
+    uint32_t key = uint32_t(static_cast<unsigned char>(p[0]))
+                 | uint32_t(static_cast<unsigned char>(p[1])) << 8
+                 | uint32_t(static_cast<unsigned char>(p[n - 2])) << 16
+                 | uint32_t(static_cast<unsigned char>(p[n - 1])) << 24;
+    return ((key + uint32_t(n)) * KEYWORD_HASH_MULTIPLIER) >> (32 - KEYWORD_TABLE_BITS);
+}
+
+// 槽位 -> 关键字下标，编译期生成
+struct KeywordTable {
+    uint8_t slots[KEYWORD_TABLE_SIZE];
+    bool perfect;
+};
+
+constexpr KeywordTable buildKeywordTable()
+{
+    KeywordTable table{};
+    table.perfect = true;
+    for (size_t i = 0; i < KEYWORD_TABLE_SIZE; i++) {
+        table.slots[i] = KEYWORD_EMPTY_SLOT;
+    }
+    for (size_t i = 0; i < RUST_KEYWORD_COUNT; i++) {
+        std::string_view kw = RUST_KEYWORDS[i];
+        if (kw.size() < KEYWORD_MIN_LENGTH || kw.size() > KEYWORD_MAX_LENGTH) {
+            table.perfect = false;
+            continue;
+        }
+        uint32_t slot = keywordHash(kw.data(), kw.size());
+        if (table.slots[slot] != KEYWORD_EMPTY_SLOT) {
+            table.perfect = false;
+        }
+        table.slots[slot] = uint8_t(i);
+    }
+    return table;
+}
+
+constexpr KeywordTable KEYWORD_TABLE = buildKeywordTable();
+static_assert(KEYWORD_TABLE.perfect,
+              "关键字哈希出现冲突，修改关键字列表后需要重新搜索 KEYWORD_HASH_MULTIPLIER");
+
+// 直接在源码字节上判断是否为关键字：不分配内存，最多一次memcmp
+inline bool isRustKeyword(const char* p, size_t n)
+{
+    if (n < KEYWORD_MIN_LENGTH || n > KEYWORD_MAX_LENGTH) {
+        return false;
+    }
+    uint8_t index = KEYWORD_TABLE.slots[keywordHash(p, n)];
+    if (index == KEYWORD_EMPTY_SLOT) {
+        return false;
+    }
+    std::string_view kw = RUST_KEYWORDS[index];
+    return kw.size() == n && std::memcmp(kw.data(), p, n) == 0;
+}
+
+inline bool isRustKeyword(std::string_view text)
+{
+    return isRustKeyword(text.data(), text.size());
+}
+
+#endif // KEYWORDS_H
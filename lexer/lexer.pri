@@ -0,0 +1,17 @@
+# 使用词法分析库的子项目 include 本文件
+
+LEXER_SOURCE_DIR = $$PWD
+LEXER_BUILD_DIR = $$shadowed($$PWD)
+
+INCLUDEPATH += $$LEXER_SOURCE_DIR
+DEPENDPATH += $$LEXER_SOURCE_DIR
+
+win32:CONFIG(release, debug|release): LEXER_LIB_DIR = $$LEXER_BUILD_DIR/release
+else:win32:CONFIG(debug, debug|release): LEXER_LIB_DIR = $$LEXER_BUILD_DIR/debug
+else: LEXER_LIB_DIR = $$LEXER_BUILD_DIR
+
+LIBS += -L$$LEXER_LIB_DIR -lrustlexer
+
+win32-g++: PRE_TARGETDEPS += $$LEXER_LIB_DIR/librustlexer.a
+else:win32:!win32-g++: PRE_TARGETDEPS += $$LEXER_LIB_DIR/rustlexer.lib
+else:unix: PRE_TARGETDEPS += $$LEXER_LIB_DIR/librustlexer.a
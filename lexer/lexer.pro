@@ -0,0 +1,48 @@
+TEMPLATE = lib
+TARGET = rustlexer
+
+QT -= core gui
+CONFIG += staticlib c++17
+
+# qmake CONFIG+=lexer_stats 时编入热路径统计（见 lexstats.h），默认不编入
+lexer_stats: DEFINES += RUSTLEXER_STATS
+
+SOURCES += \
+    diagnostics.cpp \
+    fastskip.cpp \
+    lexstats.cpp \
+    lineindex.cpp \
+    mappedfile.cpp \
+    numericliteral.cpp \
+    rustlexer.cpp \
+    streaminglexer.cpp \
+    symboltable.cpp \
+    threadpool.cpp \
+    tokenarena.cpp \
+    tokencache.cpp \
+    tokenexport.cpp \
+    tokenindex.cpp \
+    tokenstream.cpp \
+    unicodeident.cpp
+
+HEADERS += \
+    charclass.h \
+    diagnostics.h \
+    fastskip.h \
+    keywords.h \
+    lexstats.h \
+    lineindex.h \
+    mappedfile.h \
+    numericliteral.h \
+    operators.h \
+    rustlexer.h \
+    streaminglexer.h \
+    symboltable.h \
+    threadpool.h \
+    token.h \
+    tokenarena.h \
+    tokencache.h \
+    tokenexport.h \
+    tokenindex.h \
+    tokenstream.h \
+    unicodeident.h
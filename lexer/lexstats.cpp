@@ -0,0 +1,152 @@
+#include "lexstats.h"
+
+#include <cstdio>
+
+uint64_t LexStats::tokenCount() const
+{
+    uint64_t total = 0;
+    for (uint64_t count : tokensByType) {
+        total += count;
+    }
+    return total;
+}
+
+uint64_t LexStats::byteCount() const
+{
+    uint64_t total = whitespaceBytes;
+    for (const Scanner& scanner : scanners) {
+        total += scanner.bytes;
+    }
+    return total;
+}
+
+void LexStats::merge(const LexStats& other)
+{
+    for (size_t i = 0; i < TOKEN_TYPE_COUNT; i++) {
+        tokensByType[i] += other.tokensByType[i];
+    }
+    for (size_t i = 0; i < SCANNER_COUNT; i++) {
+        scanners[i].calls += other.scanners[i].calls;
+        scanners[i].bytes += other.scanners[i].bytes;
+        scanners[i].sampledCalls += other.scanners[i].sampledCalls;
+        scanners[i].sampledTicks += other.scanners[i].sampledTicks;
+    }
+    whitespaceBytes += other.whitespaceBytes;
+}
+
+namespace {
+
+double percent(double part, double whole)
+{
+    return whole > 0.0 ? part * 100.0 / whole : 0.0;
+}
+
+} // namespace
+
+std::string LexStats::format() const
+{
+    if (!lexStatsEnabled()) {
+        return "统计未编译（以 CONFIG+=lexer_stats 重新构建词法分析库后可用）\n";
+    }
+
+    std::string out;
+    char line[160];
+
+    const uint64_t tokens = tokenCount();
+    std::snprintf(line, sizeof(line), "单词类型（共 %llu 个）：\n", static_cast<unsigned long long>(tokens));
+    out += line;
+    for (size_t i = 0; i < TOKEN_TYPE_COUNT; i++) {
+        if (tokensByType[i] == 0) {
+            continue;
+        }
+        // 中文名称的显示宽度与字节数不同，放在行尾以免错位
+        std::snprintf(line, sizeof(line), "  %12llu  %6.2f%%  %s\n",
+                      static_cast<unsigned long long>(tokensByType[i]),
+                      percent(double(tokensByType[i]), double(tokens)),
+                      tokenTypeName(static_cast<TokenType>(i)));
+        out += line;
+    }
+
+    double totalTicks = 0.0;
+    for (const Scanner& scanner : scanners) {
+        totalTicks += scanner.estimatedTicks();
+    }
+
+    const uint64_t bytes = byteCount();
+    std::snprintf(line, sizeof(line), "子扫描器（共 %llu 字节，每 %llu 个单词采样计时一次，单位：%s）：\n",
+                  static_cast<unsigned long long>(bytes),
+                  static_cast<unsigned long long>(SAMPLE_INTERVAL), tickUnit());
+    out += line;
+    std::snprintf(line, sizeof(line), "  %-20s %12s %14s %8s %10s %8s\n",
+                  "scanner", "calls", "bytes", "bytes%", "ticks/call", "time%");
+    out += line;
+    for (size_t i = 0; i < SCANNER_COUNT; i++) {
+        const Scanner& scanner = scanners[i];
+        if (scanner.calls == 0) {
+            continue;
+        }
+        double ticksPerCall = scanner.sampledCalls == 0 ? 0.0
+                                                        : double(scanner.sampledTicks) / double(scanner.sampledCalls);
+        std::snprintf(line, sizeof(line), "  %-20s %12llu %14llu %7.2f%% %10.1f %7.2f%%\n",
+                      scannerName(static_cast<ScannerId>(i)),
+                      static_cast<unsigned long long>(scanner.calls),
+                      static_cast<unsigned long long>(scanner.bytes),
+                      percent(double(scanner.bytes), double(bytes)),
+                      ticksPerCall, percent(scanner.estimatedTicks(), totalTicks));
+        out += line;
+    }
+    std::snprintf(line, sizeof(line), "  %-20s %12s %14llu %7.2f%%\n", "whitespace", "-",
+                  static_cast<unsigned long long>(whitespaceBytes),
+                  percent(double(whitespaceBytes), double(bytes)));
+    out += line;
+    return out;
+}
+
+bool lexStatsEnabled()
+{
+#ifdef RUSTLEXER_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+const char* tickUnit()
+{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    return "TSC周期";
+#else
+    return "纳秒";
+#endif
+}
+
+const char* scannerName(ScannerId id)
+{
+    switch (id) {
+    case ScannerId::Identifier:          return "identifier";
+    case ScannerId::Number:              return "number";
+    case ScannerId::String:              return "string";
+    case ScannerId::Character:           return "character";
+    case ScannerId::Comment:             return "comment";
+    case ScannerId::OperatorOrDelimiter: return "operatorOrDelimiter";
+    default:                             return "?";
+    }
+}
+
+const char* tokenTypeName(TokenType type)
+{
+    switch (type) {
+    case TokenType::KEYWORD:         return "关键字";
+    case TokenType::IDENTIFIER:      return "标识符";
+    case TokenType::INTEGER_LITERAL: return "整数";
+    case TokenType::FLOAT_LITERAL:   return "浮点数";
+    case TokenType::STRING_LITERAL:  return "字符串";
+    case TokenType::CHAR_LITERAL:    return "字符";
+    case TokenType::OPERATOR:        return "操作符";
+    case TokenType::DELIMITER:       return "分隔符";
+    case TokenType::COMMENT:         return "注释";
+    case TokenType::MACRO_CALL:      return "宏调用名";
+    case TokenType::LIFETIME:        return "生命周期";
+    default:                         return "未知";
+    }
+}
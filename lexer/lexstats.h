@@ -0,0 +1,64 @@
+#ifndef LEXSTATS_H
+#define LEXSTATS_H
+
+#include <cstdint>
+#include <string>
+#include "token.h"
+
+// 子扫描器编号，与 RustLexer 的单词识别方法一一对应
+enum class ScannerId : uint8_t {
+    Identifier,             // identifier()，含关键字和宏调用名
+    Number,                 // number()
+    String,                 // string()
+    Character,              // character()
+    Comment,                // comment()
+    OperatorOrDelimiter,    // operatorOrDelimiter()
+    Count
+};
+
+constexpr size_t SCANNER_COUNT = size_t(ScannerId::Count);
+
+// 词法分析热路径统计。只有以 RUSTLEXER_STATS 编译词法分析库时才会记录
+// （qmake CONFIG+=lexer_stats），否则扫描循环中没有任何统计代码，各项始终为0。
+// 计时每 SAMPLE_INTERVAL 个单词采样一次，单位为 tickUnit()：
+// x86 上为时间戳计数器周期，其他平台为纳秒
+struct LexStats {
+    static constexpr uint64_t SAMPLE_INTERVAL = 64;
+
+    struct Scanner {
+        uint64_t calls = 0;         // 调用次数（即产生的单词数）
+        uint64_t bytes = 0;         // 消费的字节数，宏调用名包括 '!'
+        uint64_t sampledCalls = 0;  // 参与计时采样的调用次数
+        uint64_t sampledTicks = 0;  // 采样调用的总耗时
+
+        // 按采样平均值估计的总耗时
+        double estimatedTicks() const
+        {
+            return sampledCalls == 0 ? 0.0 : double(sampledTicks) / double(sampledCalls) * double(calls);
+        }
+    };
+
+    uint64_t tokensByType[TOKEN_TYPE_COUNT] = {};
+    Scanner scanners[SCANNER_COUNT];
+    uint64_t whitespaceBytes = 0;   // 单词之间跳过的空白字节
+
+    uint64_t tokenCount() const;
+    uint64_t byteCount() const;
+
+    void merge(const LexStats& other);
+    void reset() { *this = LexStats(); }
+
+    // 多行的可读报告，供命令行工具和界面显示
+    std::string format() const;
+};
+
+// 词法分析库是否以 RUSTLEXER_STATS 编译
+bool lexStatsEnabled();
+
+// 计时单位的名称
+const char* tickUnit();
+
+const char* scannerName(ScannerId id);
+const char* tokenTypeName(TokenType type);
+
+#endif // LEXSTATS_H
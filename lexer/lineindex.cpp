@@ -0,0 +1,69 @@
+#include "lineindex.h"
+#include "fastskip.h"
+#include "unicodeident.h"
+
+#include <algorithm>
+
+void LineIndex::build(std::string_view source)
+{
+    starts.clear();
+    starts.push_back(0);
+
+    // 用快速跳过内核逐个定位换行
+    const char* data = source.data();
+    const size_t length = source.length();
+    size_t position = 0;
+    while (true) {
+        position += scanUntil(data + position, length - position, '\n', '\n');
+        if (position >= length) {
+            break;
+        }
+        position++;
+        starts.push_back(static_cast<uint32_t>(position));
+    }
+}
+
+void LineIndex::applyEdit(size_t offset, size_t removed, std::string_view inserted)
+{
+    if (starts.empty()) {
+        starts.push_back(0);
+    }
+
+    // 起点在 (offset, offset + removed] 内的行，其前面的换行被删除了
+    auto first = std::upper_bound(starts.begin(), starts.end(), offset);
+    auto last = std::upper_bound(first, starts.end(), offset + removed);
+
+    // 之后的行整体平移，无符号回绕加法对负的差值同样成立
+    const uint32_t shift = static_cast<uint32_t>(inserted.length() - removed);
+    for (auto it = last; it != starts.end(); ++it) {
+        *it += shift;
+    }
+
+    std::vector<uint32_t> added;
+    for (size_t i = 0; i < inserted.length(); i++) {
+        if (inserted[i] == '\n') {
+            added.push_back(static_cast<uint32_t>(offset + i + 1));
+        }
+    }
+
+    size_t index = static_cast<size_t>(first - starts.begin());
+    starts.erase(first, last);
+    starts.insert(starts.begin() + index, added.begin(), added.end());
+}
+
+int LineIndex::line(size_t offset) const
+{
+    // 最后一个不大于 offset 的行起点；starts[0] 为0，结果至少为1
+    return static_cast<int>(std::upper_bound(starts.begin(), starts.end(), offset) - starts.begin());
+}
+
+int LineIndex::column(size_t offset) const
+{
+    return static_cast<int>(offset - lineStart(line(offset)));
+}
+
+int LineIndex::column(size_t offset, std::string_view source) const
+{
+    size_t start = lineStart(line(offset));
+    return static_cast<int>(countCodePoints(source.data() + start, offset - start));
+}
@@ -0,0 +1,36 @@
+#ifndef LINEINDEX_H
+#define LINEINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// 行起点索引：记录每一行第一个字节的偏移，按偏移二分查找行号和列号。
+// 词法分析时不再逐字节维护行列号，需要显示位置时才查询。
+// 偏移以32位保存，与 TokenStream 相同，源码不能超过 4 GiB
+class LineIndex {
+public:
+    LineIndex() = default;
+    explicit LineIndex(std::string_view source) { build(source); }
+
+    void build(std::string_view source);
+
+    // 源码 offset 处删除 removed 个字节、插入 inserted 之后更新索引
+    void applyEdit(size_t offset, size_t removed, std::string_view inserted);
+
+    // 行号从1开始，列号从0开始，以字节计
+    int line(size_t offset) const;
+    int column(size_t offset) const;
+    // 列号以码点计，与编辑器中看到的字符位置一致；source 为建立索引的源码
+    int column(size_t offset, std::string_view source) const;
+
+    size_t lineCount() const { return starts.size(); }
+    size_t lineStart(int line) const { return starts[size_t(line - 1)]; }
+    bool empty() const { return starts.empty(); }
+
+private:
+    std::vector<uint32_t> starts;
+};
+
+#endif // LINEINDEX_H
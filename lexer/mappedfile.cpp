@@ -0,0 +1,164 @@
+#include "mappedfile.h"
+
+#include <cstring>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <filesystem>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) {
+        close();
+        address = std::exchange(other.address, nullptr);
+        length = std::exchange(other.length, 0);
+        opened = std::exchange(other.opened, false);
+        error = std::move(other.error);
+#ifdef _WIN32
+        fileHandle = std::exchange(other.fileHandle, nullptr);
+        mappingHandle = std::exchange(other.mappingHandle, nullptr);
+#endif
+    }
+    return *this;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& path)
+{
+    close();
+
+    // 路径按UTF-8解释
+    std::wstring widePath = std::filesystem::u8path(path).wstring();
+    HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        error = "无法打开文件：" + path;
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        error = "无法获取文件大小：" + path;
+        return false;
+    }
+
+    fileHandle = file;
+    length = static_cast<size_t>(fileSize.QuadPart);
+    opened = true;
+
+    // 空文件无法映射，直接视为空内容
+    if (length == 0) {
+        return true;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        close();
+        error = "无法映射文件：" + path;
+        return false;
+    }
+    mappingHandle = mapping;
+
+    address = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (address == nullptr) {
+        close();
+        error = "无法映射文件：" + path;
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (address) {
+        UnmapViewOfFile(address);
+    }
+    if (mappingHandle) {
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+    }
+    if (fileHandle) {
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+    }
+    address = nullptr;
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+    length = 0;
+    opened = false;
+}
+
+#else
+
+bool MappedFile::open(const std::string& path)
+{
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "无法打开文件：" + path + "（" + std::strerror(errno) + "）";
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        error = "无法获取文件大小：" + path + "（" + std::strerror(errno) + "）";
+        ::close(fd);
+        return false;
+    }
+
+    length = static_cast<size_t>(info.st_size);
+    opened = true;
+
+    // 空文件无法映射，直接视为空内容
+    if (length > 0) {
+        void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            error = "无法映射文件：" + path + "（" + std::strerror(errno) + "）";
+            ::close(fd);
+            length = 0;
+            opened = false;
+            return false;
+        }
+        address = static_cast<const char*>(mapped);
+        // 词法分析按顺序读取整个文件
+        madvise(mapped, length, MADV_SEQUENTIAL);
+    }
+
+    // 映射建立后即可关闭文件描述符
+    ::close(fd);
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (address) {
+        munmap(const_cast<char*>(address), length);
+    }
+    address = nullptr;
+    length = 0;
+    opened = false;
+}
+
+#endif
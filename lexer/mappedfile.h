@@ -0,0 +1,40 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// 只读内存映射文件。映射期间 data() 指向文件内容，可直接交给 RustLexer 借用
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // 映射整个文件，失败时返回 false，原因见 errorString()
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return opened; }
+    const char* data() const { return address; }
+    size_t size() const { return length; }
+    std::string_view view() const { return std::string_view(address, length); }
+    const std::string& errorString() const { return error; }
+
+private:
+    const char* address = nullptr;
+    size_t length = 0;
+    bool opened = false;
+    std::string error;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,488 @@
+#include "numericliteral.h"
+#include "charclass.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+// ---- 128位运算 ----
+
+// 64位乘法的完整128位结果
+inline void multiply64(uint64_t a, uint64_t b, uint64_t& high, uint64_t& low)
+{
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    high = static_cast<uint64_t>(product >> 64);
+    low = static_cast<uint64_t>(product);
+#else
+    uint64_t aLow = a & 0xFFFFFFFFu, aHigh = a >> 32;
+    uint64_t bLow = b & 0xFFFFFFFFu, bHigh = b >> 32;
+    uint64_t ll = aLow * bLow, lh = aLow * bHigh, hl = aHigh * bLow, hh = aHigh * bHigh;
+    uint64_t middle = (ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu);
+    low = (middle << 32) | (ll & 0xFFFFFFFFu);
+    high = hh + (lh >> 32) + (hl >> 32) + (middle >> 32);
+#endif
+}
+
+// value = value * multiplier + addend，超出128位时返回 false
+inline bool multiplyAdd(UInt128& value, uint64_t multiplier, uint64_t addend)
+{
+    uint64_t lowHigh, lowLow, highHigh, highLow;
+    multiply64(value.low, multiplier, lowHigh, lowLow);
+    multiply64(value.high, multiplier, highHigh, highLow);
+    if (highHigh != 0) {
+        return false;
+    }
+    uint64_t high = highLow + lowHigh;
+    if (high < highLow) {
+        return false;
+    }
+    uint64_t low = lowLow + addend;
+    if (low < lowLow) {
+        if (++high == 0) {
+            return false;
+        }
+    }
+    value.high = high;
+    value.low = low;
+    return true;
+}
+
+// value = (value << bits) | digit，超出128位时返回 false
+inline bool shiftAdd(UInt128& value, unsigned bits, uint64_t digit)
+{
+    if (value.high >> (64 - bits)) {
+        return false;
+    }
+    value.high = (value.high << bits) | (value.low >> (64 - bits));
+    value.low = (value.low << bits) | digit;
+    return true;
+}
+
+inline bool lessOrEqual(const UInt128& a, const UInt128& b)
+{
+    return a.high < b.high || (a.high == b.high && a.low <= b.low);
+}
+
+// ---- 8位十进制数字的SWAR转换 ----
+
+// 按小端序读取8个字节，首字符在最低字节
+inline uint64_t loadEightBytes(const char* p)
+{
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    return value;
+}
+
+// 8个字节是否都是 '0'~'9'：高半字节为3，且加6后不进位到高半字节
+inline bool isEightDigits(uint64_t value)
+{
+    return ((value & 0xF0F0F0F0F0F0F0F0ULL)
+            | (((value + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
+}
+
+// 把8个十进制数字字符转换为数值：逐级把相邻的1、2、4位数两两合并，共3次乘法
+inline uint32_t parseEightDigits(uint64_t value)
+{
+    value = ((value & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;
+    value = ((value & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;
+    return static_cast<uint32_t>(((value & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32);
+}
+
+inline bool isDecimalDigit(char c)
+{
+    return hasCharClass(c, CC_DIGIT);
+}
+
+// 数字字符的值，查表避免随机的字母/数字分支预测失败
+struct DigitValueTable {
+    uint8_t value[256];
+};
+
+constexpr DigitValueTable buildDigitValueTable()
+{
+    DigitValueTable table{};
+    for (int c = 0; c < 256; c++) {
+        if (c >= '0' && c <= '9') {
+            table.value[c] = uint8_t(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            table.value[c] = uint8_t(c - 'a' + 10);
+        } else if (c >= 'A' && c <= 'F') {
+            table.value[c] = uint8_t(c - 'A' + 10);
+        }
+    }
+    return table;
+}
+
+constexpr DigitValueTable DIGIT_VALUES = buildDigitValueTable();
+
+inline unsigned hexValue(char c)
+{
+    return DIGIT_VALUES.value[static_cast<unsigned char>(c)];
+}
+
+struct SuffixEntry {
+    std::string_view text;
+    NumericSuffix suffix;
+};
+
+constexpr SuffixEntry SUFFIXES[] = {
+    {"u8", NumericSuffix::U8}, {"u16", NumericSuffix::U16}, {"u32", NumericSuffix::U32},
+    {"u64", NumericSuffix::U64}, {"u128", NumericSuffix::U128}, {"usize", NumericSuffix::Usize},
+    {"i8", NumericSuffix::I8}, {"i16", NumericSuffix::I16}, {"i32", NumericSuffix::I32},
+    {"i64", NumericSuffix::I64}, {"i128", NumericSuffix::I128}, {"isize", NumericSuffix::Isize},
+    {"f32", NumericSuffix::F32}, {"f64", NumericSuffix::F64},
+};
+
+NumericSuffix parseSuffix(std::string_view text)
+{
+    if (text.empty()) {
+        return NumericSuffix::None;
+    }
+    for (const SuffixEntry& entry : SUFFIXES) {
+        if (entry.text == text) {
+            return entry.suffix;
+        }
+    }
+    return NumericSuffix::Invalid;
+}
+
+bool isFloatSuffix(NumericSuffix suffix)
+{
+    return suffix == NumericSuffix::F32 || suffix == NumericSuffix::F64;
+}
+
+// 整数后缀类型可表示的最大值；有符号类型为 2^(n-1)，负号是单独的单词。
+// usize/isize 按64位平台计算
+UInt128 suffixLimit(NumericSuffix suffix)
+{
+    auto bits = [](unsigned n) {
+        UInt128 limit;
+        if (n >= 128) {
+            limit.high = limit.low = ~uint64_t(0);
+        } else if (n >= 64) {
+            limit.low = ~uint64_t(0);
+            limit.high = n == 64 ? 0 : (uint64_t(1) << (n - 64)) - 1;
+        } else {
+            limit.low = (uint64_t(1) << n) - 1;
+        }
+        return limit;
+    };
+    auto signedMagnitude = [](unsigned n) {
+        UInt128 limit;
+        if (n > 64) {
+            limit.high = uint64_t(1) << (n - 65);
+        } else {
+            limit.low = uint64_t(1) << (n - 1);
+        }
+        return limit;
+    };
+    switch (suffix) {
+    case NumericSuffix::U8:    return bits(8);
+    case NumericSuffix::U16:   return bits(16);
+    case NumericSuffix::U32:   return bits(32);
+    case NumericSuffix::U64:
+    case NumericSuffix::Usize: return bits(64);
+    case NumericSuffix::I8:    return signedMagnitude(8);
+    case NumericSuffix::I16:   return signedMagnitude(16);
+    case NumericSuffix::I32:   return signedMagnitude(32);
+    case NumericSuffix::I64:
+    case NumericSuffix::Isize: return signedMagnitude(64);
+    case NumericSuffix::I128:  return signedMagnitude(128);
+    default:                   return bits(128);
+    }
+}
+
+// 十进制数字串（可含 '_'）的值，超出128位时返回 false
+bool accumulateDecimal(const char* p, const char* end, UInt128& result)
+{
+    // 不超过19个数字一定放得下64位，先在64位整数中累加
+    constexpr unsigned FAST_DIGITS = 19;
+    uint64_t low = 0;
+    unsigned digits = 0;
+    while (p < end) {
+        if (end - p >= 8 && digits + 8 <= FAST_DIGITS) {
+            uint64_t chunk = loadEightBytes(p);
+            if (isEightDigits(chunk)) {
+                low = low * 100000000u + parseEightDigits(chunk);
+                digits += 8;
+                p += 8;
+                continue;
+            }
+        }
+        if (*p == '_') {
+            p++;
+            continue;
+        }
+        if (digits == FAST_DIGITS) {
+            break;
+        }
+        low = low * 10 + uint64_t(*p - '0');
+        digits++;
+        p++;
+    }
+
+    UInt128 value;
+    value.low = low;
+    while (p < end) {
+        if (end - p >= 8) {
+            uint64_t chunk = loadEightBytes(p);
+            if (isEightDigits(chunk)) {
+                if (!multiplyAdd(value, 100000000u, parseEightDigits(chunk))) {
+                    return false;
+                }
+                p += 8;
+                continue;
+            }
+        }
+        if (*p != '_' && !multiplyAdd(value, 10, uint64_t(*p - '0'))) {
+            return false;
+        }
+        p++;
+    }
+    result = value;
+    return true;
+}
+
+} // namespace
+
+NumericValue decodeNumber(std::string_view lexeme)
+{
+    NumericValue result;
+    const char* begin = lexeme.data();
+    const char* end = begin + lexeme.size();
+    const char* p = begin;
+
+    // 进制前缀
+    unsigned bits = 0;
+    if (lexeme.size() >= 2 && p[0] == '0') {
+        switch (p[1]) {
+        case 'x': case 'X': result.radix = 16; bits = 4; break;
+        case 'o': case 'O': result.radix = 8;  bits = 3; break;
+        case 'b': case 'B': result.radix = 2;  bits = 1; break;
+        }
+        if (bits) {
+            p += 2;
+        }
+    }
+
+    if (bits) {
+        // 二/八/十六进制：按位左移累加，后缀从第一个不是本进制数字的字符开始
+        const uint16_t digitClass = result.radix == 16 ? CC_HEX_DIGIT
+                                  : result.radix == 8 ? CC_OCTAL_DIGIT : CC_BINARY_DIGIT;
+        // 前 64/bits 个数字一定放得下64位，直接在64位整数中累加，其余数字再按128位处理
+        const unsigned fastDigits = 64 / bits;
+        uint64_t low = 0;
+        unsigned digits = 0;
+        for (; p < end && digits < fastDigits && hasCharClass(*p, digitClass | CC_UNDERSCORE); p++) {
+            if (*p != '_') {
+                low = (low << bits) | hexValue(*p);
+                digits++;
+            }
+        }
+        UInt128 value;
+        value.low = low;
+        bool overflow = false;
+        for (; p < end && hasCharClass(*p, digitClass | CC_UNDERSCORE); p++) {
+            if (*p != '_') {
+                digits++;
+                overflow |= !shiftAdd(value, bits, hexValue(*p));
+            }
+        }
+        const bool anyDigit = digits > 0;
+        if (overflow) {
+            result.overflow = true;
+        } else {
+            result.integer = value;
+        }
+        result.suffix = parseSuffix(std::string_view(p, size_t(end - p)));
+        // 非十进制没有浮点字面量
+        if (!anyDigit || result.suffix == NumericSuffix::Invalid || isFloatSuffix(result.suffix)) {
+            result.malformed = true;
+        }
+    } else {
+        // 十进制：整数部分、可选的小数部分和指数部分，与 RustLexer::number() 的规则相同
+        const char* integerEnd = p;
+        while (integerEnd < end && hasCharClass(*integerEnd, CC_DIGIT | CC_UNDERSCORE)) {
+            integerEnd++;
+        }
+        const char* bodyEnd = integerEnd;
+        if (bodyEnd < end && *bodyEnd == '.') {
+            result.isFloat = true;
+            bodyEnd++;
+            while (bodyEnd < end && hasCharClass(*bodyEnd, CC_DIGIT | CC_UNDERSCORE)) {
+                bodyEnd++;
+            }
+        }
+        if (bodyEnd < end && (*bodyEnd == 'e' || *bodyEnd == 'E')) {
+            const char* exponent = bodyEnd + 1;
+            if (exponent < end && (*exponent == '+' || *exponent == '-')) {
+                exponent++;
+            }
+            if (exponent < end && isDecimalDigit(*exponent)) {
+                result.isFloat = true;
+                bodyEnd = exponent;
+                while (bodyEnd < end && hasCharClass(*bodyEnd, CC_DIGIT | CC_UNDERSCORE)) {
+                    bodyEnd++;
+                }
+            }
+        }
+
+        result.suffix = parseSuffix(std::string_view(bodyEnd, size_t(end - bodyEnd)));
+        if (isFloatSuffix(result.suffix)) {
+            result.isFloat = true;
+        } else if (result.isFloat && result.suffix != NumericSuffix::None) {
+            // 浮点数只能带 f32/f64 后缀
+            result.suffix = NumericSuffix::Invalid;
+        }
+        if (result.suffix == NumericSuffix::Invalid || integerEnd == p) {
+            result.malformed = true;
+        }
+
+        if (result.isFloat) {
+            // from_chars 不接受 '_'，去掉后再转换；绝大多数字面量用栈上缓冲
+            char buffer[128];
+            std::string heap;
+            char* text = buffer;
+            size_t bodyLength = size_t(bodyEnd - p);
+            if (bodyLength > sizeof(buffer)) {
+                heap.resize(bodyLength);
+                text = &heap[0];
+            }
+            size_t length = 0;
+            for (const char* q = p; q < bodyEnd; q++) {
+                if (*q != '_') {
+                    text[length++] = *q;
+                }
+            }
+            std::from_chars_result parsed = std::from_chars(text, text + length, result.floating);
+            if (parsed.ec == std::errc::result_out_of_range) {
+                result.overflow = true;
+            } else if (parsed.ec != std::errc() || parsed.ptr != text + length) {
+                result.malformed = true;
+            }
+            if (result.suffix == NumericSuffix::F32 && !result.overflow) {
+                float single = static_cast<float>(result.floating);
+                if (std::isinf(single) && !std::isinf(result.floating)) {
+                    result.overflow = true;
+                }
+                result.floating = single;
+            }
+            return result;
+        }
+
+        if (!accumulateDecimal(p, integerEnd, result.integer)) {
+            result.overflow = true;
+        }
+    }
+
+    if (!result.overflow && result.suffix != NumericSuffix::None && result.suffix != NumericSuffix::Invalid
+        && !lessOrEqual(result.integer, suffixLimit(result.suffix))) {
+        result.overflow = true;
+    }
+    return result;
+}
+
+std::string UInt128::toString() const
+{
+    if (high == 0) {
+        return std::to_string(low);
+    }
+    // 按32位分段做长除法，每次除以10得到一位；余数小于10，每步都在64位内
+    uint32_t parts[4] = {uint32_t(high >> 32), uint32_t(high), uint32_t(low >> 32), uint32_t(low)};
+    std::string digits;
+    bool nonZero = true;
+    while (nonZero) {
+        uint64_t remainder = 0;
+        nonZero = false;
+        for (uint32_t& part : parts) {
+            uint64_t current = (remainder << 32) | part;
+            part = static_cast<uint32_t>(current / 10);
+            remainder = current % 10;
+            nonZero |= part != 0;
+        }
+        digits.push_back(static_cast<char>('0' + remainder));
+    }
+    std::reverse(digits.begin(), digits.end());
+    return digits;
+}
+
+std::string NumericValue::toString() const
+{
+    std::string text;
+    if (isFloat) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.17g", floating);
+        text = buffer;
+    } else {
+        text = integer.toString();
+    }
+    if (suffix != NumericSuffix::None && suffix != NumericSuffix::Invalid) {
+        text += " (";
+        text += suffixName(suffix);
+        text += ')';
+    }
+    if (overflow) {
+        text += "，溢出";
+    }
+    if (malformed) {
+        text += "，格式错误";
+    }
+    return text;
+}
+
+const char* suffixName(NumericSuffix suffix)
+{
+    switch (suffix) {
+    case NumericSuffix::U8:    return "u8";
+    case NumericSuffix::U16:   return "u16";
+    case NumericSuffix::U32:   return "u32";
+    case NumericSuffix::U64:   return "u64";
+    case NumericSuffix::U128:  return "u128";
+    case NumericSuffix::Usize: return "usize";
+    case NumericSuffix::I8:    return "i8";
+    case NumericSuffix::I16:   return "i16";
+    case NumericSuffix::I32:   return "i32";
+    case NumericSuffix::I64:   return "i64";
+    case NumericSuffix::I128:  return "i128";
+    case NumericSuffix::Isize: return "isize";
+    case NumericSuffix::F32:   return "f32";
+    case NumericSuffix::F64:   return "f64";
+    case NumericSuffix::Invalid: return "?";
+    default:                   return "";
+    }
+}
+
+void NumberTable::clear()
+{
+    tokens.clear();
+    values.clear();
+}
+
+void NumberTable::reserve(size_t count)
+{
+    tokens.reserve(count);
+    values.reserve(count);
+}
+
+void NumberTable::add(size_t tokenIndex, const NumericValue& value)
+{
+    tokens.push_back(static_cast<uint32_t>(tokenIndex));
+    values.push_back(value);
+}
+
+const NumericValue* NumberTable::find(size_t tokenIndex) const
+{
+    auto it = std::lower_bound(tokens.begin(), tokens.end(), static_cast<uint32_t>(tokenIndex));
+    if (it == tokens.end() || *it != tokenIndex) {
+        return nullptr;
+    }
+    return &values[size_t(it - tokens.begin())];
+}
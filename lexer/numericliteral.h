@@ -0,0 +1,74 @@
+#ifndef NUMERICLITERAL_H
+#define NUMERICLITERAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 128位无符号整数（u128），不依赖编译器扩展
+struct UInt128 {
+    uint64_t high = 0;
+    uint64_t low = 0;
+
+    bool operator==(const UInt128& other) const { return high == other.high && low == other.low; }
+    bool operator!=(const UInt128& other) const { return !(*this == other); }
+
+    std::string toString() const;
+};
+
+// 数字字面量的类型后缀
+enum class NumericSuffix : uint8_t {
+    None,
+    U8, U16, U32, U64, U128, Usize,
+    I8, I16, I32, I64, I128, Isize,
+    F32, F64,
+    Invalid         // 不是合法的后缀，如 1abc、1.5u8
+};
+
+// 数字字面量解码后的值
+struct NumericValue {
+    UInt128 integer;        // 整数字面量的值，超出 u128 时为0
+    double floating = 0.0;  // 浮点字面量的值，f32 后缀时已舍入到单精度；超出 f64 范围时为0
+    NumericSuffix suffix = NumericSuffix::None;
+    uint8_t radix = 10;     // 2、8、10 或 16
+    bool isFloat = false;
+    // 整数超出 u128 或后缀类型的范围，浮点数超出 f64 或 f32 的范围。
+    // 负号是单独的运算符单词，有符号类型允许到 2^(n-1)（即 -128i8 中的 128）
+    bool overflow = false;
+    bool malformed = false; // 没有数字（如 0x）或后缀不合法
+
+    std::string toString() const;
+};
+
+// 解码一个数字字面量词素（RustLexer::number() 产生的 INTEGER_LITERAL 或 FLOAT_LITERAL）。
+// 十进制数字每8个一组按SWAR方式转换，二/八/十六进制直接按位累加，浮点数用 std::from_chars
+NumericValue decodeNumber(std::string_view lexeme);
+
+const char* suffixName(NumericSuffix suffix);
+
+// 数字字面量的值表：按单词下标升序保存，与 RustLexer::tokenize(NumberTable&) 产生的单词序列对应。
+// 单词序列经 applyEdit() 增量更新后下标会变化，需要重新生成
+class NumberTable {
+public:
+    size_t size() const { return values.size(); }
+    bool empty() const { return values.empty(); }
+    void clear();
+    void reserve(size_t count);
+
+    // tokenIndex 必须大于已添加的所有下标
+    void add(size_t tokenIndex, const NumericValue& value);
+
+    // 第 tokenIndex 个单词的值，不是数字字面量时返回 nullptr
+    const NumericValue* find(size_t tokenIndex) const;
+
+    size_t tokenIndex(size_t i) const { return tokens[i]; }
+    const NumericValue& value(size_t i) const { return values[i]; }
+
+private:
+    std::vector<uint32_t> tokens;
+    std::vector<NumericValue> values;
+};
+
+#endif // NUMERICLITERAL_H
@@ -0,0 +1,172 @@
+#ifndef OPERATORS_H
+#define OPERATORS_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+
+// 运算符与分隔符的紧凑编号，随Token一起保存，下游代码无需再比较字符串
+enum class OperatorId : uint8_t {
+    None,
+    // 算术与位运算
+    Plus, Minus, Star, Slash, Percent, Caret, Not, Tilde, And, Or, AndAnd, OrOr, Shl, Shr,
+    // 复合赋值
+    PlusEq, MinusEq, StarEq, SlashEq, PercentEq, CaretEq, AndEq, OrEq, ShlEq, ShrEq,
+    // 比较与赋值
+    Eq, EqEq, Ne, Gt, Lt, Ge, Le,
+    // 其他运算符
+    At, DotDot, DotDotDot, DotDotEq, RArrow, FatArrow, LArrow, Question,
+    // 分隔符
+    Dot, Comma, Semi, Colon, PathSep, Pound, Dollar,
+    OpenParen, CloseParen, OpenBrace, CloseBrace, OpenBracket, CloseBracket,
+    Count
+};
+
+struct OperatorDef {
+    std::string_view text;
+    OperatorId id;
+    bool delimiter;     // true 时归类为分隔符，否则为运算符
+};
+
+// Rust标点符号表
+constexpr OperatorDef OPERATOR_DEFS[] = {
+    {"+", OperatorId::Plus, false},        {"-", OperatorId::Minus, false},
+    {"*", OperatorId::Star, false},        {"/", OperatorId::Slash, false},
+    {"%", OperatorId::Percent, false},     {"^", OperatorId::Caret, false},
+    {"!", OperatorId::Not, false},         {"~", OperatorId::Tilde, false},
+    {"&", OperatorId::And, false},         {"|", OperatorId::Or, false},
+    {"&&", OperatorId::AndAnd, false},     {"||", OperatorId::OrOr, false},
+    {"<<", OperatorId::Shl, false},        {">>", OperatorId::Shr, false},
+    {"+=", OperatorId::PlusEq, false},     {"-=", OperatorId::MinusEq, false},
+    {"*=", OperatorId::StarEq, false},     {"/=", OperatorId::SlashEq, false},
+    {"%=", OperatorId::PercentEq, false},  {"^=", OperatorId::CaretEq, false},
+    {"&=", OperatorId::AndEq, false},      {"|=", OperatorId::OrEq, false},
+    {"<<=", OperatorId::ShlEq, false},     {">>=", OperatorId::ShrEq, false},
+    {"=", OperatorId::Eq, false},          {"==", OperatorId::EqEq, false},
+    {"!=", OperatorId::Ne, false},         {">", OperatorId::Gt, false},
+    {"<", OperatorId::Lt, false},          {">=", OperatorId::Ge, false},
+    {"<=", OperatorId::Le, false},         {"@", OperatorId::At, false},
+    {"..", OperatorId::DotDot, false},     {"...", OperatorId::DotDotDot, false},
+    {"..=", OperatorId::DotDotEq, false},  {"->", OperatorId::RArrow, false},
+    {"=>", OperatorId::FatArrow, false},   {"<-", OperatorId::LArrow, false},
+    {"?", OperatorId::Question, false},
+    {".", OperatorId::Dot, true},          {",", OperatorId::Comma, true},
+    {";", OperatorId::Semi, true},         {":", OperatorId::Colon, true},
+    {"::", OperatorId::PathSep, true},     {"#", OperatorId::Pound, true},
+    {"$", OperatorId::Dollar, true},
+    {"(", OperatorId::OpenParen, true},    {")", OperatorId::CloseParen, true},
+    {"{", OperatorId::OpenBrace, true},    {"}", OperatorId::CloseBrace, true},
+    {"[", OperatorId::OpenBracket, true},  {"]", OperatorId::CloseBracket, true}
+};
+
+constexpr size_t OPERATOR_DEF_COUNT = sizeof(OPERATOR_DEFS) / sizeof(OPERATOR_DEFS[0]);
+static_assert(OPERATOR_DEF_COUNT == size_t(OperatorId::Count) - 1, "每个 OperatorId 都应在 OPERATOR_DEFS 中出现一次");
+
+// 编译期生成的运算符字典树。标点字符先压缩为连续编号，节点0为根；
+// 转移为0表示没有后继。扫描时只向前走，不回退。
+constexpr size_t OPERATOR_TRIE_MAX_NODES = 64;
+constexpr size_t OPERATOR_TRIE_MAX_CHARS = 32;
+constexpr uint8_t OPERATOR_NO_CHAR = 0xff;
+
+struct OperatorTrie {
+    uint8_t charIndex[256];                                         // 字节 -> 标点编号
+    uint8_t next[OPERATOR_TRIE_MAX_NODES][OPERATOR_TRIE_MAX_CHARS]; // 状态转移
+    OperatorId accept[OPERATOR_TRIE_MAX_NODES];                     // 节点对应的运算符
+    bool delimiter[OPERATOR_TRIE_MAX_NODES];
+    size_t nodeCount;
+    size_t charCount;
+    bool valid;
+
+    // 返回后继节点，0 表示无法继续匹配
+    constexpr unsigned step(unsigned node, char c) const
+    {
+        uint8_t index = charIndex[static_cast<unsigned char>(c)];
+        return index == OPERATOR_NO_CHAR ? 0 : next[node][index];
+    }
+};
+
+constexpr OperatorTrie buildOperatorTrie()
+{
+    OperatorTrie trie{};
+    trie.nodeCount = 1;
+    trie.charCount = 0;
+    trie.valid = true;
+    for (size_t c = 0; c < 256; c++) {
+        trie.charIndex[c] = OPERATOR_NO_CHAR;
+    }
+
+    for (size_t i = 0; i < OPERATOR_DEF_COUNT; i++) {
+        const OperatorDef& def = OPERATOR_DEFS[i];
+        unsigned node = 0;
+        for (char ch : def.text) {
+            unsigned char c = static_cast<unsigned char>(ch);
+            if (trie.charIndex[c] == OPERATOR_NO_CHAR) {
+                if (trie.charCount == OPERATOR_TRIE_MAX_CHARS) {
+                    trie.valid = false;
+                    return trie;
+                }
+                trie.charIndex[c] = uint8_t(trie.charCount++);
+            }
+            uint8_t index = trie.charIndex[c];
+            if (trie.next[node][index] == 0) {
+                if (trie.nodeCount == OPERATOR_TRIE_MAX_NODES) {
+                    trie.valid = false;
+                    return trie;
+                }
+                trie.next[node][index] = uint8_t(trie.nodeCount++);
+            }
+            node = trie.next[node][index];
+        }
+        if (trie.accept[node] != OperatorId::None) {
+            trie.valid = false;     // 重复定义
+        }
+        trie.accept[node] = def.id;
+        trie.delimiter[node] = def.delimiter;
+    }
+
+    // 每个非根节点都必须是完整的运算符：这样最长匹配停在第一个无法转移的字符处即可，
+    // 不需要记录最后一个可接受位置再回退
+    for (size_t node = 1; node < trie.nodeCount; node++) {
+        if (trie.accept[node] == OperatorId::None) {
+            trie.valid = false;
+        }
+    }
+    return trie;
+}
+
+constexpr OperatorTrie OPERATOR_TRIE = buildOperatorTrie();
+static_assert(OPERATOR_TRIE.valid, "运算符表超出字典树容量，或存在不是完整运算符的前缀");
+
+// 按运算符编号查是否为分隔符
+struct OperatorKindTable {
+    bool delimiter[size_t(OperatorId::Count)];
+};
+
+constexpr OperatorKindTable buildOperatorKindTable()
+{
+    OperatorKindTable table{};
+    for (const OperatorDef& def : OPERATOR_DEFS) {
+        table.delimiter[size_t(def.id)] = def.delimiter;
+    }
+    return table;
+}
+
+constexpr OperatorKindTable OPERATOR_KINDS = buildOperatorKindTable();
+
+constexpr bool isDelimiter(OperatorId id)
+{
+    return OPERATOR_KINDS.delimiter[size_t(id)];
+}
+
+// 运算符编号对应的文本
+inline std::string_view operatorText(OperatorId id)
+{
+    for (const OperatorDef& def : OPERATOR_DEFS) {
+        if (def.id == id) {
+            return def.text;
+        }
+    }
+    return {};
+}
+
+#endif // OPERATORS_H
@@ -0,0 +1,949 @@
+#include "rustlexer.h"
+#include "keywords.h"
+#include "charclass.h"
+#include "fastskip.h"
+#include "threadpool.h"
+#include "unicodeident.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef RUSTLEXER_STATS
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+#endif
+
+// 子扫描器分派表，下标为 ScanClass
+const RustLexer::Scanner RustLexer::SCANNERS[] = {
+    &RustLexer::operatorOrDelimiter,    // ScanClass::Operator
+    &RustLexer::operatorOrDelimiter,    // ScanClass::Whitespace（skipWhitespace之后不会出现）
+    &RustLexer::identifier,             // ScanClass::Identifier
+    &RustLexer::number,                 // ScanClass::Number
+    &RustLexer::string,                 // ScanClass::String
+    &RustLexer::character,              // ScanClass::Char
+    &RustLexer::slash,                  // ScanClass::Slash
+    &RustLexer::unicode                 // ScanClass::Unicode
+};
+
+namespace {
+
+// 单词序列以32位保存偏移和长度，超过 MAX_SOURCE_SIZE 的源码无法表示：直接拒绝，不静默截断
+void requireCompactSize(size_t length)
+{
+    if (length > TokenStream::MAX_SOURCE_SIZE) {
+        throw std::length_error("RustLexer: source exceeds TokenStream::MAX_SOURCE_SIZE");
+    }
+}
+
+} // namespace
+
+LexOptions LexOptions::withoutComments()
+{
+    LexOptions options;
+    options.types = ALL_TOKEN_TYPES & ~tokenTypeBit(TokenType::COMMENT);
+    return options;
+}
+
+LexOptions LexOptions::only(std::initializer_list<TokenType> list)
+{
+    LexOptions options;
+    options.types = 0;
+    for (TokenType type : list) {
+        options.types |= tokenTypeBit(type);
+    }
+    return options;
+}
+
+uint64_t TokenCounts::total() const
+{
+    uint64_t sum = 0;
+    for (uint64_t count : byType) {
+        sum += count;
+    }
+    return sum;
+}
+
+RustLexer::RustLexer(std::string source)
+    : storage(std::move(source)), source(storage), position(0)
+{
+}
+
+RustLexer::RustLexer(const char* data, size_t length)
+    : source(data, length), position(0)
+{
+}
+
+TokenStream RustLexer::tokenize()
+{
+    return tokenize(std::pmr::get_default_resource());
+}
+
+TokenStream RustLexer::tokenize(std::pmr::memory_resource* resource)
+{
+    requireCompactSize(source.length());
+    TokenStream tokens(resource);
+    tokens.reserve(TokenStream::estimateTokenCount(source.length() - std::min(position, source.length())));
+    Token token;
+    
+    while (nextToken(token)) {
+        // 添加到结果中
+        tokens.append(token);
+    }
+    
+    return tokens;
+}
+
+TokenStream RustLexer::tokenize(NumberTable& numbers, std::pmr::memory_resource* resource)
+{
+    requireCompactSize(source.length());
+    TokenStream tokens(resource);
+    tokens.reserve(TokenStream::estimateTokenCount(source.length() - std::min(position, source.length())));
+    numbers.clear();
+    Token token;
+    
+    while (nextToken(token)) {
+        // 词素刚扫描过，仍在缓存中，立即解码
+        if (token.type == TokenType::INTEGER_LITERAL || token.type == TokenType::FLOAT_LITERAL) {
+            numbers.add(tokens.size(), decodeNumber(lexeme(token)));
+        }
+        tokens.append(token);
+    }
+    
+    return tokens;
+}
+
+TokenStream RustLexer::tokenize(SymbolCache& symbols, std::vector<uint32_t>& symbolIds,
+                                std::pmr::memory_resource* resource)
+{
+    requireCompactSize(source.length());
+    TokenStream tokens(resource);
+    size_t estimate = TokenStream::estimateTokenCount(source.length() - std::min(position, source.length()));
+    tokens.reserve(estimate);
+    symbolIds.clear();
+    symbolIds.reserve(estimate);
+    Token token;
+    
+    while (nextToken(token)) {
+        if (token.type == TokenType::IDENTIFIER || token.type == TokenType::KEYWORD ||
+            token.type == TokenType::MACRO_CALL) {
+            symbolIds.push_back(symbols.intern(lexeme(token)));
+        } else {
+            symbolIds.push_back(NO_SYMBOL);
+        }
+        tokens.append(token);
+    }
+    
+    return tokens;
+}
+
+TokenStream RustLexer::tokenize(LexStats& stats)
+{
+    LexStats before = statistics;
+    statistics.reset();
+    TokenStream tokens = tokenize();
+    stats = statistics;
+    statistics.merge(before);
+    return tokens;
+}
+
+TokenStream RustLexer::tokenize(const LexOptions& options, std::pmr::memory_resource* resource)
+{
+    TokenStream tokens(resource);
+    size_t estimate = TokenStream::estimateTokenCount(source.length() - std::min(position, source.length()));
+    Token token;
+    
+    if (options.lexemes) {
+        requireCompactSize(source.length());
+        tokens.reserve(estimate);
+        while (nextToken(token, options.types)) {
+            tokens.append(token);
+        }
+    } else {
+        tokens.reserveKinds(estimate);
+        while (nextToken(token, options.types)) {
+            tokens.appendKind(token.type, token.op);
+        }
+    }
+    
+    return tokens;
+}
+
+TokenCounts RustLexer::countTokens(const LexOptions& options)
+{
+    // 类型先顺序攒在一小块缓冲区中，攒满后再成批累加。逐个累加时写入的地址取决于刚扫描出的类型，
+    // 下一个单词的读取要等这个地址算出来，实测比保存整个单词序列还慢
+    TokenCounts counts;
+    uint8_t batch[256];
+    size_t pending = 0;
+    auto flush = [&]() {
+        for (size_t i = 0; i < pending; i++) {
+            counts.byType[batch[i]]++;
+        }
+        pending = 0;
+    };
+    Token token;
+    
+    while (nextToken(token, options.types)) {
+        batch[pending++] = uint8_t(token.type);
+        if (pending == sizeof(batch)) {
+            flush();
+        }
+    }
+    flush();
+    
+    return counts;
+}
+
+bool RustLexer::nextToken(Token& token, TokenTypeMask types)
+{
+    if (types == ALL_TOKEN_TYPES) {
+        return nextToken(token);
+    }
+    
+    // 不输出的注释和标识符只推进位置：注释按块跳过，标识符不必查关键字表
+    const bool skipComments = (types & tokenTypeBit(TokenType::COMMENT)) == 0;
+    const bool skipIdentifiers = (types & (tokenTypeBit(TokenType::IDENTIFIER) | tokenTypeBit(TokenType::KEYWORD)
+                                           | tokenTypeBit(TokenType::MACRO_CALL))) == 0;
+    while (true) {
+        skipWhitespace();
+        if (isAtEnd()) {
+            return false;
+        }
+        
+        ScanClass scanClass = scanClassOf(peek());
+        if (skipComments && scanClass == ScanClass::Slash && (peek(1) == '/' || peek(1) == '*')) {
+            skipComment();
+            continue;
+        }
+        if (skipIdentifiers && scanClass == ScanClass::Identifier) {
+            skipIdentifier();
+            continue;
+        }
+        
+        token = scanToken();
+        if ((types & tokenTypeBit(token.type)) != 0) {
+            return true;
+        }
+    }
+}
+
+bool RustLexer::nextToken(Token& token)
+{
+    // 跳过空白字符，只剩空白时结束
+#ifdef RUSTLEXER_STATS
+    size_t whitespaceStart = position;
+    skipWhitespace();
+    statistics.whitespaceBytes += position - whitespaceStart;
+#else
+    skipWhitespace();
+#endif
+    if (isAtEnd()) {
+        return false;
+    }
+    
+    token = scanToken();
+    return true;
+}
+
+namespace {
+
+#ifdef RUSTLEXER_STATS
+// 采样计时用的时间戳：x86 上读时间戳计数器，其他平台用单调时钟的纳秒数
+inline uint64_t readTicks()
+{
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// 首字节类别对应的子扫描器；'/' 开头的单词按结果区分注释和运算符
+constexpr ScannerId SCANNER_OF_CLASS[] = {
+    ScannerId::OperatorOrDelimiter,     // ScanClass::Operator
+    ScannerId::OperatorOrDelimiter,     // ScanClass::Whitespace
+    ScannerId::Identifier,              // ScanClass::Identifier
+    ScannerId::Number,                  // ScanClass::Number
+    ScannerId::String,                  // ScanClass::String
+    ScannerId::Character,               // ScanClass::Char
+    ScannerId::OperatorOrDelimiter,     // ScanClass::Slash
+    ScannerId::Identifier               // ScanClass::Unicode
+};
+static_assert(sizeof(SCANNER_OF_CLASS) / sizeof(SCANNER_OF_CLASS[0]) == size_t(ScanClass::Count),
+              "SCANNER_OF_CLASS 必须覆盖所有 ScanClass");
+#endif
+
+// 并行分析时单块的最小字节数，过小的块线程调度开销会超过分析本身
+constexpr size_t MIN_PARALLEL_CHUNK_SIZE = 64 * 1024;
+
+// 推测性分析的一块源码
+struct SpeculativeChunk {
+    size_t begin = 0;           // 块起点，紧跟在换行之后（第一块为0）
+    size_t end = 0;
+    size_t exit = 0;            // 块内最后一个单词的结束位置，没有单词时为 begin
+    TokenStream tokens;
+};
+
+// 子扫描器在单词结尾之后最多向前查看的字节数（如 `1e+5` 的判断），
+// 结尾距编辑位置不足此距离的单词可能因编辑而改变，必须重新分析
+constexpr size_t EDIT_LOOKAHEAD = 4;
+
+// 扫描单词时实际消费到的位置：宏调用的词素不含 '!'，但 '!' 已被消费
+size_t scannedEnd(const TokenStream& tokens, size_t index)
+{
+    return tokens.end(index) + (tokens.type(index) == TokenType::MACRO_CALL ? 1 : 0);
+}
+
+bool containsQuoteOrBackslash(std::string_view text)
+{
+    return text.find_first_of("\"\\") != std::string_view::npos;
+}
+
+// 下标小于 limit 的第一个未闭合字符串（以 '"' 开头的未知单词），没有时返回 limit
+size_t firstUnclosedString(const TokenStream& tokens, size_t limit, std::string_view source)
+{
+    const uint8_t* kinds = tokens.view().kindData();
+    const uint8_t unknown = TokenKind::encode(TokenType::UNKNOWN, OperatorId::None);
+    size_t index = 0;
+    while (index < limit) {
+        const void* found = std::memchr(kinds + index, unknown, limit - index);
+        if (!found) {
+            break;
+        }
+        index = size_t(static_cast<const uint8_t*>(found) - kinds);
+        if (source[tokens.offset(index)] == '"') {
+            return index;
+        }
+        index++;
+    }
+    return limit;
+}
+
+} // namespace
+
+TokenStream RustLexer::tokenizeParallel(ThreadPool& pool, size_t chunkSize,
+                                        std::pmr::memory_resource* resource) const
+{
+    const size_t length = source.length();
+    requireCompactSize(length);
+    if (chunkSize == 0) {
+        chunkSize = std::max(MIN_PARALLEL_CHUNK_SIZE, length / (pool.threadCount() * 4) + 1);
+    }
+    
+    // 在换行之后切分，保证每块都从行首开始
+    std::vector<size_t> bounds{0};
+    while (bounds.back() + chunkSize < length) {
+        size_t newline = source.find('\n', bounds.back() + chunkSize);
+        if (newline == std::string_view::npos || newline + 1 >= length) {
+            break;
+        }
+        bounds.push_back(newline + 1);
+    }
+    bounds.push_back(length);
+    
+    const size_t chunkCount = bounds.size() - 1;
+    if (chunkCount < 2) {
+        RustLexer lexer(source.data(), length);
+        return lexer.tokenize(resource);
+    }
+    
+    // 第一阶段：各块假定入口处于单词边界，并行分析。
+    // 单词起点落在块内即属于本块，最后一个单词可以越过块尾
+    std::vector<SpeculativeChunk> chunks(chunkCount);
+    pool.parallelFor(chunkCount, [&](size_t i) {
+        SpeculativeChunk& chunk = chunks[i];
+        chunk.begin = bounds[i];
+        chunk.end = bounds[i + 1];
+        chunk.exit = chunk.begin;
+        chunk.tokens.reserve(TokenStream::estimateTokenCount(chunk.end - chunk.begin));
+        
+        RustLexer lexer(source.data(), length);
+        lexer.seek(chunk.begin);
+        while (true) {
+            lexer.skipWhitespace();
+            if (lexer.isAtEnd() || lexer.position >= chunk.end) {
+                break;
+            }
+            chunk.tokens.append(lexer.scanToken());
+            chunk.exit = lexer.position;
+        }
+    });
+    
+    size_t totalTokens = 0;
+    for (const SpeculativeChunk& chunk : chunks) {
+        totalTokens += chunk.tokens.size();
+    }
+    TokenStream tokens(resource);
+    tokens.reserve(totalTokens);
+    
+    // 第二阶段：顺序校正。词法分析器在单词之间不保留任何状态，
+    // 因此只要真实的单词起点与某块推测出的单词起点重合，此后的结果必然一致
+    size_t resume = 0;  // 真实扫描位置：已输出的最后一个单词的结束位置
+    size_t i = 0;
+    while (i < chunkCount) {
+        if (resume <= chunks[i].begin) {
+            // 前面的单词没有跨入本块，入口就是单词边界，推测结果可直接使用
+            tokens.append(chunks[i].tokens);
+            resume = std::max(resume, chunks[i].exit);
+            i++;
+            continue;
+        }
+        
+        // 前一个单词（块注释或多行字符串）跨入了本块：
+        // 从 resume 起顺序重新分析，直到与某块的推测结果重新同步
+        size_t c = i;
+        RustLexer lexer(source.data(), length);
+        lexer.seek(resume);
+        size_t k = 0;
+        i = chunkCount;
+        while (true) {
+            lexer.skipWhitespace();
+            if (lexer.isAtEnd()) {
+                break;
+            }
+            size_t start = lexer.position;
+            while (c + 1 < chunkCount && start >= chunks[c + 1].begin) {
+                c++;
+                k = 0;
+            }
+            const TokenStream& speculative = chunks[c].tokens;
+            while (k < speculative.size() && speculative.offset(k) < start) {
+                k++;
+            }
+            if (k < speculative.size() && speculative.offset(k) == start) {
+                // 重新同步：本块余下的推测结果有效
+                tokens.append(speculative, k);
+                resume = chunks[c].exit;
+                i = c + 1;
+                break;
+            }
+            tokens.append(lexer.scanToken());
+            resume = lexer.position;
+        }
+    }
+    
+    return tokens;
+}
+
+TokenEdit RustLexer::applyEdit(TokenStream& tokens, size_t offset, size_t removed, std::string_view inserted)
+{
+    // 借用外部缓冲区时先复制，之后在自有存储上修改
+    if (storage.data() != source.data()) {
+        storage.assign(source.data(), source.length());
+    }
+    offset = std::min(offset, storage.length());
+    removed = std::min(removed, storage.length() - offset);
+    requireCompactSize(storage.length() - removed + inserted.length());
+    const bool quotesChanged = containsQuoteOrBackslash(std::string_view(storage).substr(offset, removed))
+                               || containsQuoteOrBackslash(inserted);
+    storage.replace(offset, removed, inserted.data(), inserted.length());
+    source = storage;
+    unclosedStringFrom = SIZE_MAX;
+    
+    const size_t oldEditEnd = offset + removed;
+    const size_t newEditEnd = offset + inserted.length();
+    
+    // 安全重启点：最后一个结尾距编辑位置至少 EDIT_LOOKAHEAD 字节的单词之后。
+    // 单词按偏移有序且互不重叠，结尾也有序，可以二分查找
+    size_t first = 0;
+    size_t last = tokens.size();
+    while (first < last) {
+        size_t middle = first + (last - first) / 2;
+        if (scannedEnd(tokens, middle) + EDIT_LOOKAHEAD <= offset) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+    
+    // 未闭合字符串在行尾结束，但它是否闭合取决于其后直到源码结尾的引号和反斜杠。
+    // 编辑增删了这两种字节、使编辑之前第一个未闭合的字符串变为闭合时，从它重新分析；
+    // 它仍未闭合时，其后开始的字符串也都不会闭合，编辑之前的单词不受影响
+    if (quotesChanged) {
+        size_t unclosed = firstUnclosedString(tokens, first, source);
+        if (unclosed < first) {
+            RustLexer probe(source.data(), source.length());
+            probe.seek(tokens.offset(unclosed));
+            if (probe.scanToken().type != TokenType::UNKNOWN) {
+                first = unclosed;
+            }
+        }
+    }
+    size_t restart = first > 0 ? scannedEnd(tokens, first - 1) : 0;
+    
+    // 从重启点重新分析，直到某个新单词起点与编辑之后的某个旧单词起点重合。
+    // 词法分析器在单词之间不保留任何状态，此后的结果必然与旧序列平移后一致
+    RustLexer lexer(source.data(), source.length());
+    lexer.seek(restart);
+    TokenStream fresh;
+    size_t sync = first;
+    bool synced = false;
+    while (true) {
+        lexer.skipWhitespace();
+        if (lexer.isAtEnd()) {
+            break;
+        }
+        size_t start = lexer.position;
+        if (start >= newEditEnd) {
+            size_t oldStart = start - newEditEnd + oldEditEnd;
+            while (sync < tokens.size() && tokens.offset(sync) < oldStart) {
+                sync++;
+            }
+            if (sync < tokens.size() && tokens.offset(sync) == oldStart) {
+                synced = true;
+                break;
+            }
+        }
+        fresh.append(lexer.scanToken());
+    }
+    if (!synced) {
+        sync = tokens.size();
+    }
+    
+    // 平移同步点之后的旧单词，再用新单词替换重启点与同步点之间的旧单词
+    tokens.shiftOffsets(sync, static_cast<std::ptrdiff_t>(newEditEnd) - static_cast<std::ptrdiff_t>(oldEditEnd));
+    TokenEdit edit{first, sync - first, fresh.size()};
+    tokens.replace(first, edit.removed, fresh);
+    return edit;
+}
+
+void RustLexer::seek(size_t offset)
+{
+    position = offset;
+}
+
+char RustLexer::peek(int offset) const
+{
+    if (position + offset >= source.length()) {
+        return '\0';
+    }
+    return source[position + offset];
+}
+
+char RustLexer::advance()
+{
+    // 已到末尾时不再前进，保证 position 不会越过源码长度
+    if (isAtEnd()) {
+        return '\0';
+    }
+    
+    // 行列号由 LineIndex 按需计算，这里只推进位置
+    return source[position++];
+}
+
+bool RustLexer::isAtEnd() const
+{
+    return position >= source.length();
+}
+
+bool RustLexer::match(char expected)
+{
+    if (isAtEnd() || peek() != expected) {
+        return false;
+    }
+    
+    advance();
+    return true;
+}
+
+Token RustLexer::makeToken(size_t start, TokenType type) const
+{
+    // 只记录词素的位置，不复制文本
+    return {type, OperatorId::None, start, position - start};
+}
+
+void RustLexer::advanceCodePoint()
+{
+    // 前进一个 UTF-8 码点，非法字节只前进一个字节
+    char32_t codePoint;
+    size_t count = decodeUtf8(source.data() + position, source.length() - position, codePoint);
+    if (count != 0) {
+        position += count;
+    } else {
+        advance();
+    }
+}
+
+void RustLexer::skipWhitespace()
+{
+    position += skipSpaces(source.data() + position, source.length() - position);
+}
+
+void RustLexer::advanceWhile(uint16_t classMask)
+{
+    const size_t length = source.length();
+    while (position < length && hasCharClass(source[position], classMask)) {
+        position++;
+    }
+}
+
+Token RustLexer::scanToken()
+{
+    // 调用方已跳过空白，根据首字节类别分派到对应的子扫描器。
+    // 单词只记录起点偏移，行列号由 LineIndex 按起点计算
+    static_assert(sizeof(SCANNERS) / sizeof(SCANNERS[0]) == size_t(ScanClass::Count),
+                  "SCANNERS 必须覆盖所有 ScanClass");
+#ifdef RUSTLEXER_STATS
+    const size_t scanClass = static_cast<size_t>(scanClassOf(peek()));
+    const size_t start = position;
+    const bool sampled = sampleCountdown-- == 0;
+    if (sampled) {
+        sampleCountdown = LexStats::SAMPLE_INTERVAL - 1;
+    }
+    const uint64_t begin = sampled ? readTicks() : 0;
+    
+    Token token = (this->*SCANNERS[scanClass])();
+    
+    const uint64_t ticks = sampled ? readTicks() - begin : 0;
+    ScannerId id = token.type == TokenType::COMMENT ? ScannerId::Comment : SCANNER_OF_CLASS[scanClass];
+    LexStats::Scanner& scanner = statistics.scanners[size_t(id)];
+    scanner.calls++;
+    scanner.bytes += position - start;
+    if (sampled) {
+        scanner.sampledCalls++;
+        scanner.sampledTicks += ticks;
+    }
+    statistics.tokensByType[size_t(token.type)]++;
+    return token;
+#else
+    return (this->*SCANNERS[static_cast<size_t>(scanClassOf(peek()))])();
+#endif
+}
+
+Token RustLexer::identifier()
+{
+    size_t start = position;
+    
+    // 第一个字符可以是字母或下划线
+    advance();
+    
+    return finishIdentifier(start);
+}
+
+Token RustLexer::unicode()
+{
+    size_t start = position;
+    
+    // XID_Start 码点开始一个标识符；其他码点（如 '→'）整个作为一个未知单词，
+    // 非法的 UTF-8 字节单独成为一个未知单词
+    char32_t codePoint;
+    size_t count = decodeUtf8(source.data() + position, source.length() - position, codePoint);
+    if (count == 0) {
+        advance();
+        return makeToken(start, TokenType::UNKNOWN);
+    }
+    position += count;
+    if (!isXidStart(codePoint)) {
+        return makeToken(start, TokenType::UNKNOWN);
+    }
+    
+    return finishIdentifier(start);
+}
+
+void RustLexer::advanceIdentifier()
+{
+    // ASCII 段按字符类别表整段跳过，只有停在非ASCII字节上时才解码，
+    // 纯ASCII的标识符只多一次比较
+    const size_t length = source.length();
+    while (true) {
+        advanceWhile(CC_IDENT_CONTINUE);
+        if (position >= length || static_cast<unsigned char>(source[position]) < 0x80) {
+            return;
+        }
+        char32_t codePoint;
+        size_t count = decodeUtf8(source.data() + position, length - position, codePoint);
+        if (count == 0 || !isXidContinue(codePoint)) {
+            return;
+        }
+        position += count;
+    }
+}
+
+void RustLexer::skipIdentifier()
+{
+    // 与 identifier() 消费相同的字节，只有后面紧跟 '!' 时才需要区分关键字和宏调用名
+    size_t start = position;
+    advance();
+    advanceIdentifier();
+    if (peek() == '!' && peek(1) != '=') {
+        std::string_view text(source.data() + start, position - start);
+        if (!isRustKeyword(text) && text != "r" && text != "b") {
+            advance(); // 宏调用的 '!'
+        }
+    }
+}
+
+Token RustLexer::finishIdentifier(size_t start)
+{
+    // 后续字符为 XID_Continue：字母、数字、下划线及其他语言的文字
+    advanceIdentifier();
+    
+    // 标识符文本直接引用源码缓冲区
+    std::string_view text(source.data() + start, position - start);
+    
+    // 检查是否是关键字（编译期完美哈希，直接比较源码字节）
+    Token token = makeToken(start, TokenType::IDENTIFIER);
+    if (isRustKeyword(text)) {
+        token.type = TokenType::KEYWORD;
+    }
+    // 检查是否是宏调用（词素不包含 '!'），注意 `a!=b` 中的 '!' 属于运算符 "!="
+    else if (peek() == '!' && peek(1) != '=' && text != "r" && text != "b") {
+        advance(); // 消费 '!'
+        token.type = TokenType::MACRO_CALL;
+    }
+    
+    return token;
+}
+
+Token RustLexer::number()
+{
+    size_t start = position;
+    TokenType type = TokenType::INTEGER_LITERAL;
+    bool isFloat = false;
+    
+    // 检查是否是十六进制、八进制或二进制字面量
+    if (peek() == '0') {
+        advance();
+        
+        if (match('x') || match('X')) {
+            // 十六进制
+            advanceWhile(CC_HEX_DIGIT | CC_UNDERSCORE);
+        }
+        else if (match('o') || match('O')) {
+            // 八进制
+            advanceWhile(CC_OCTAL_DIGIT | CC_UNDERSCORE);
+        }
+        else if (match('b') || match('B')) {
+            // 二进制
+            advanceWhile(CC_BINARY_DIGIT | CC_UNDERSCORE);
+        }
+        else {
+            // 可能是小数点开头的浮点数或普通的0
+            // 继续处理
+            if (peek() == '.') {
+                isFloat = true;
+                advance();
+                advanceWhile(CC_DIGIT | CC_UNDERSCORE);
+            }
+        }
+    }
+    else {
+        // 处理普通十进制数
+        advanceWhile(CC_DIGIT | CC_UNDERSCORE);
+        
+        // 检查是否是浮点数
+        if (peek() == '.' && isDigit(peek(1))) {
+            isFloat = true;
+            advance(); // 消费 '.'
+            
+            // 小数部分
+            advanceWhile(CC_DIGIT | CC_UNDERSCORE);
+        }
+    }
+    
+    // 处理科学计数法表示
+    if ((peek() == 'e' || peek() == 'E') && (isDigit(peek(1)) || 
+        ((peek(1) == '+' || peek(1) == '-') && isDigit(peek(2))))) {
+        
+        isFloat = true;
+        advance(); // 消费 'e' 或 'E'
+        
+        if (match('+') || match('-')) {
+            // 消费 '+' 或 '-'
+        }
+        
+        advanceWhile(CC_DIGIT | CC_UNDERSCORE);
+    }
+    
+    // 处理类型后缀，比如 u8, i32, f32 等
+    if (isAlpha(peek())) {
+        size_t typeStart = position;
+        advanceWhile(CC_ALPHA | CC_DIGIT);
+        // 如果类型后缀以'f'开头，将类型设为浮点数
+        if (position > typeStart && source[typeStart] == 'f') {
+            isFloat = true;
+        }
+    }
+    
+    // 根据是否有小数点或科学计数法决定类型
+    if (isFloat) {
+        type = TokenType::FLOAT_LITERAL;
+    }
+    
+    return makeToken(start, type);
+}
+
+Token RustLexer::string()
+{
+    size_t start = position;
+    
+    advance(); // 消费开头的引号
+    
+    // 处理字符串内容直到找到结束引号，中间的普通字节由快速跳过内核整段跳过。
+    // 从某处开始的字符串扫到文件结尾仍未闭合时，其后任何位置开始的字符串也不会闭合
+    // （后面的引号都已被转义），不必再扫描
+    if (start < unclosedStringFrom) {
+        while (true) {
+            position += scanUntil(source.data() + position, source.length() - position, '"', '\\');
+            if (isAtEnd() || peek() == '"') {
+                break;
+            }
+            advance(); // 消费转义字符 '\'
+            advance(); // 消费被转义的字符（包括 '"' 和 '\\'）
+        }
+        
+        if (!isAtEnd()) {
+            advance(); // 消费结尾的引号
+            return makeToken(start, TokenType::STRING_LITERAL);
+        }
+        unclosedStringFrom = start;
+    }
+    
+    // 字符串未闭合：不吞掉其后的全部源码，在同步点（开头引号所在行的行尾）结束，
+    // 之后的源码照常分析
+    position = start + 1;
+    position += scanUntil(source.data() + position, source.length() - position, '\n', '\n');
+    return makeToken(start, TokenType::UNKNOWN);
+}
+
+Token RustLexer::character()
+{
+    size_t start = position;
+    
+    advance(); // 消费开头的单引号
+    
+    // 单引号之后的第一个码点，源码结束时为0
+    char32_t first = 0;
+    size_t count = decodeUtf8(source.data() + position, source.length() - position, first);
+    
+    // 'x'：单个码点（不是转义）后紧跟结尾的单引号
+    if (count != 0 && first != '\\' && first != '\n' && first != '\'' && peek(int(count)) == '\'') {
+        position += count + 1;
+        return makeToken(start, TokenType::CHAR_LITERAL);
+    }
+    
+    // 'a、'static、'_：单引号后是标识符且其后没有单引号，为生命周期或循环标签
+    if (count != 0 && (first == '_' || isXidStart(first))) {
+        position += count;
+        advanceIdentifier();
+        if (peek() != '\'') {
+            return makeToken(start, TokenType::LIFETIME);
+        }
+        advance(); // 'ab'：多个字符的字符字面量，格式错误
+        return makeToken(start, TokenType::UNKNOWN);
+    }
+    
+    // 转义（'\n'、'\x7F'、'\u{1F600}'）或格式错误的字符字面量：扫描到结尾的单引号为止，
+    // 遇到换行、'/' 或源码结尾时停止，错误不会越过本行
+    bool escaped = peek() == '\\';
+    while (!isAtEnd()) {
+        char c = peek();
+        if (c == '\'') {
+            advance();
+            return makeToken(start, escaped ? TokenType::CHAR_LITERAL : TokenType::UNKNOWN);
+        }
+        if (c == '\n' || c == '/') {
+            break;
+        }
+        if (c == '\\') {
+            advance();
+            if (isAtEnd() || peek() == '\n') {
+                break;
+            }
+        }
+        advanceCodePoint();
+    }
+    
+    // 字符字面量未闭合
+    return makeToken(start, TokenType::UNKNOWN);
+}
+
+Token RustLexer::comment()
+{
+    size_t start = position;
+    skipComment();
+    return makeToken(start, TokenType::COMMENT);
+}
+
+void RustLexer::skipComment()
+{
+    advance(); // 消费第一个'/'
+    
+    if (match('/')) {
+        // 行注释：直接跳到行尾
+        position += scanUntil(source.data() + position, source.length() - position, '\n', '\n');
+    } else if (match('*')) {
+        // 块注释：只有 '/' 和 '*' 可能改变嵌套层数，其余字节整段跳过
+        int nesting = 1;
+        while (!isAtEnd() && nesting > 0) {
+            position += scanUntil(source.data() + position, source.length() - position, '*', '/');
+            if (isAtEnd()) {
+                break;
+            }
+            if (peek() == '/' && peek(1) == '*') {
+                advance(); advance();
+                nesting++;
+            } else if (peek() == '*' && peek(1) == '/') {
+                advance(); advance();
+                nesting--;
+            } else {
+                advance();
+            }
+        }
+    }
+}
+
+Token RustLexer::slash()
+{
+    // '/' 之后是 '/' 或 '*' 时为注释，否则按运算符处理
+    if (peek(1) == '/' || peek(1) == '*') {
+        return comment();
+    }
+    return operatorOrDelimiter();
+}
+
+Token RustLexer::operatorOrDelimiter()
+{
+    size_t start = position;
+    
+    // 沿运算符字典树向前走到无法转移为止，即为最长匹配。
+    // 字典树的每个节点都是完整的运算符，因此无需回退
+    const size_t length = source.length();
+    unsigned node = 0;
+    while (position < length) {
+        unsigned next = OPERATOR_TRIE.step(node, source[position]);
+        if (next == 0) {
+            break;
+        }
+        node = next;
+        position++;
+    }
+    
+    if (node == 0) {
+        // 如果未识别出任何运算符，则消费一个字符并返回未知类型
+        advance();
+        return makeToken(start, TokenType::UNKNOWN);
+    }
+    
+    Token token = makeToken(start, OPERATOR_TRIE.delimiter[node] ? TokenType::DELIMITER
+                                                                 : TokenType::OPERATOR);
+    token.op = OPERATOR_TRIE.accept[node];
+    return token;
+}
+
+bool RustLexer::isDigit(char c) const
+{
+    return hasCharClass(c, CC_DIGIT);
+}
+
+bool RustLexer::isAlpha(char c) const
+{
+    return hasCharClass(c, CC_ALPHA);
+}
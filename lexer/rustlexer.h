@@ -0,0 +1,160 @@
+#ifndef RUSTLEXER_H
+#define RUSTLEXER_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "lexstats.h"
+#include "numericliteral.h"
+#include "symboltable.h"
+#include "token.h"
+#include "tokenstream.h"
+
+class ThreadPool;
+
+// 一次编辑对单词序列的影响：从下标 first 起的 removed 个旧单词被替换为 inserted 个新单词，
+// 其后的单词只平移了偏移
+struct TokenEdit {
+    size_t first;
+    size_t removed;
+    size_t inserted;
+};
+
+// 输出配置：选择输出哪些类型的单词，以及是否记录词素的位置。
+// 未选中的类型照常扫描以确定单词边界，但不构造结果：注释和标识符走只推进位置的快速路径，
+// 其余单词扫描后直接丢弃，结果与完整分析后按类型过滤相同
+struct LexOptions {
+    TokenTypeMask types = ALL_TOKEN_TYPES;
+    // false 时 tokenize() 只保存种类列，不保存偏移和长度（见 TokenStream::hasExtents()）
+    bool lexemes = true;
+
+    bool emits(TokenType type) const { return (types & tokenTypeBit(type)) != 0; }
+
+    // 除注释之外的全部单词
+    static LexOptions withoutComments();
+    // 只输出给定的类型
+    static LexOptions only(std::initializer_list<TokenType> list);
+};
+
+// 各类单词的个数，按 TokenType 编号下标
+struct TokenCounts {
+    uint64_t byType[TOKEN_TYPE_COUNT] = {};
+
+    uint64_t total() const;
+    uint64_t operator[](TokenType type) const { return byType[size_t(type)]; }
+};
+
+class RustLexer {
+public:
+    // 持有源码：传入的字符串移动到词法分析器内部
+    explicit RustLexer(std::string source);
+    // 借用外部缓冲区（如内存映射的文件），不复制；调用方保证其在词法分析器存活期间有效
+    RustLexer(const char* data, size_t length);
+
+    // 源码视图可能指向内部存储，因此不可复制或移动
+    RustLexer(const RustLexer&) = delete;
+    RustLexer& operator=(const RustLexer&) = delete;
+
+    // 分析整个源码，结果存为紧凑的单词序列。源码超过 TokenStream::MAX_SOURCE_SIZE 时
+    // 偏移无法以32位表示，抛出 std::length_error（只保存种类时不受此限制）。
+    // 按源码大小估计单词数一次预留容量
+    TokenStream tokenize();
+    // 同上，结果的存储从 resource 分配（如每个线程一个 TokenArena）
+    TokenStream tokenize(std::pmr::memory_resource* resource);
+    // 同上，并在同一遍扫描中解码所有数字字面量的值，按单词下标存入 numbers（先清空）
+    TokenStream tokenize(NumberTable& numbers,
+                         std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    // 同上，并把关键字、标识符和宏名驻留到 symbols，symbolIds 按单词下标保存编号
+    // （先清空，其他单词为 NO_SYMBOL），之后可按整数比较和哈希标识符
+    TokenStream tokenize(SymbolCache& symbols, std::vector<uint32_t>& symbolIds,
+                         std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    // 同上，并把本次分析的热路径统计写入 stats（见 LexStats）
+    TokenStream tokenize(LexStats& stats);
+    // 只保存 options 选中的类型；不记录词素时每个单词只占1字节
+    TokenStream tokenize(const LexOptions& options,
+                         std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    // 只统计各类单词的个数，不保存单词序列。未选中的类型不计数
+    TokenCounts countTokens(const LexOptions& options = LexOptions());
+
+    // 逐个取出单词，源码结束时返回 false
+    bool nextToken(Token& token);
+    // 只取出 types 中的类型，跳过其余单词。快速跳过的注释和标识符不计入热路径统计
+    bool nextToken(Token& token, TokenTypeMask types);
+
+    // 并行分析整个源码：按换行把源码切成若干块，各块假定从单词边界开始推测性地分析，
+    // 再顺序校正入口状态不同的块（上一块的块注释或多行字符串跨入本块）。
+    // 结果与从头调用 tokenize() 逐个相同；不改变本对象的扫描位置。
+    // chunkSize 为0时按源码大小和线程数自动选择
+    // 结果的存储从 resource 分配，各块的中间结果仍使用全局堆。源码大小的限制与 tokenize() 相同
+    TokenStream tokenizeParallel(ThreadPool& pool, size_t chunkSize = 0,
+                                 std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
+
+    // 增量重新分析：在源码 offset 处删除 removed 个字节并插入 inserted，然后就地更新 tokens。
+    // tokens 必须是编辑前对本对象源码完整分析的结果。只从编辑前最近的安全重启点重新分析，
+    // 直到新单词与旧单词序列重新同步，其余单词只平移偏移。
+    // 借用外部缓冲区时先复制为自有存储；不改变本对象的扫描位置。
+    // 编辑后的源码超过 TokenStream::MAX_SOURCE_SIZE 时抛出 std::length_error，源码和 tokens 不变
+    TokenEdit applyEdit(TokenStream& tokens, size_t offset, size_t removed, std::string_view inserted);
+
+    // 源码缓冲区，Token的偏移均相对于它
+    std::string_view sourceText() const { return source; }
+
+    // 按需取出词素：视图在词法分析器存活期间有效，字符串为独立副本
+    std::string_view lexeme(const Token& token) const { return token.text(source); }
+    std::string lexemeString(const Token& token) const { return std::string(lexeme(token)); }
+
+    // 构造或上次 resetStats() 以来 nextToken() 的累计统计；未以 RUSTLEXER_STATS 编译时始终为0
+    const LexStats& stats() const { return statistics; }
+    void resetStats() { statistics.reset(); }
+
+private:
+    friend class StreamingLexer;
+
+    std::string storage;        // 持有源码时的存储，借用外部缓冲区时为空
+    std::string_view source;    // 正在扫描的源码
+    size_t position;
+    // 已知扫到源码结尾仍未闭合的字符串起点：此后开始的字符串同样不会闭合，直接按未闭合处理，
+    // 保证大量未闭合引号时分析仍是线性的。只是缓存，不影响结果；源码改变时重置
+    size_t unclosedStringFrom = SIZE_MAX;
+    LexStats statistics;
+    uint32_t sampleCountdown = 0;   // 距下一次采样计时还有多少个单词
+    
+    // 辅助方法
+    char peek(int offset = 0) const;
+    char advance();
+    bool isAtEnd() const;
+    bool match(char expected);
+    Token makeToken(size_t start, TokenType type) const;
+    void skipWhitespace();
+    void advanceWhile(uint16_t classMask);
+    void advanceCodePoint();
+    void seek(size_t offset);
+    
+    // 单词识别方法
+    // 按首字节的 ScanClass 查表选择子扫描器
+    using Scanner = Token (RustLexer::*)();
+    static const Scanner SCANNERS[];
+
+    Token scanToken();
+    Token identifier();
+    Token unicode();
+    Token finishIdentifier(size_t start);
+    void advanceIdentifier();
+    Token number();
+    Token string();
+    Token character();
+    Token comment();
+    void skipComment();
+    void skipIdentifier();
+    Token slash();
+    Token operatorOrDelimiter();
+    
+    // 判断字符类型
+    bool isDigit(char c) const;
+    bool isAlpha(char c) const;
+};
+
+#endif // RUSTLEXER_H
\ No newline at end of file
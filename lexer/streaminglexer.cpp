@@ -0,0 +1,91 @@
+#include "streaminglexer.h"
+
+#include <algorithm>
+
+StreamingLexer::StreamingLexer(Reader reader, size_t chunkSize)
+    : reader(std::move(reader)),
+      chunkSize(std::max<size_t>(chunkSize, 1)),
+      exhausted(false),
+      lexer(std::string()),
+      base(0)
+{
+}
+
+StreamingLexer::StreamingLexer(std::istream& in, size_t chunkSize)
+    : StreamingLexer([&in](char* buffer, size_t capacity) -> size_t {
+          in.read(buffer, static_cast<std::streamsize>(capacity));
+          return static_cast<size_t>(in.gcount());
+      }, chunkSize)
+{
+}
+
+bool StreamingLexer::next(Token& token)
+{
+    // 同一个单词需要补充数据的次数越多，每次读取越多，
+    // 使超长单词的重新扫描总代价保持线性
+    size_t readSize = chunkSize;
+
+    while (true) {
+        lexer.skipWhitespace();
+
+        if (lexer.isAtEnd()) {
+            if (exhausted) {
+                return false;
+            }
+            discardConsumed();
+            refill(readSize);
+            continue;
+        }
+
+        // 保存单词起点，单词可能未完整时据此回退
+        size_t startPosition = lexer.position;
+
+        token = lexer.scanToken();
+
+        if (!exhausted && (lexer.position + LOOKAHEAD > lexer.source.length()
+                           || lexer.unclosedStringFrom != SIZE_MAX)) {
+            // 单词触及窗口末尾，可能被块边界截断；字符串扫到窗口末尾仍未闭合时，
+            // 要读到输入结束才能确定。补充数据后从起点重新扫描
+            lexer.position = startPosition;
+            lexer.unclosedStringFrom = SIZE_MAX;
+            discardConsumed();
+            refill(readSize);
+            readSize = std::max(readSize, lexer.source.length());
+            continue;
+        }
+
+        token.offset += base;
+        return true;
+    }
+}
+
+std::string_view StreamingLexer::lexeme(const Token& token) const
+{
+    return lexer.source.substr(token.offset - base, token.length);
+}
+
+void StreamingLexer::discardConsumed()
+{
+    // 丢弃当前扫描位置之前的数据，窗口从未完成的单词起点开始
+    lexer.storage.erase(0, lexer.position);
+    lexer.source = lexer.storage;
+    base += lexer.position;
+    // 输入已结束时未闭合字符串的缓存仍然有效，此后的扫描位置都不早于它
+    if (lexer.unclosedStringFrom != SIZE_MAX) {
+        lexer.unclosedStringFrom -= std::min(lexer.unclosedStringFrom, lexer.position);
+    }
+    lexer.position = 0;
+}
+
+void StreamingLexer::refill(size_t bytes)
+{
+    std::string& window = lexer.storage;
+    size_t oldLength = window.length();
+    window.resize(oldLength + bytes);
+    size_t received = reader(&window[oldLength], bytes);
+    window.resize(oldLength + received);
+    lexer.source = window;
+    if (received == 0) {
+        exhausted = true;
+    }
+}
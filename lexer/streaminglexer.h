@@ -0,0 +1,48 @@
+#ifndef STREAMINGLEXER_H
+#define STREAMINGLEXER_H
+
+#include <functional>
+#include <istream>
+#include <string_view>
+#include "rustlexer.h"
+
+// 流式词法分析器：按固定大小的块从输入拉取数据，逐个产生单词。
+// 只保留当前单词起点之后的数据，内存上限约为块大小加上最长单词的长度。
+// 字符串是否闭合要看到结尾引号或输入结束才能确定，与 tokenize() 的结果一致：
+// 仍未闭合的字符串使窗口继续增长，而不是在某个长度上截断。
+// 跨越块边界的单词（嵌套块注释、长字符串等）会在补充数据后从单词起点重新扫描。
+class StreamingLexer {
+public:
+    // 读取回调：向 buffer 写入至多 capacity 个字节，返回实际字节数，0 表示输入结束
+    using Reader = std::function<size_t(char* buffer, size_t capacity)>;
+
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    explicit StreamingLexer(Reader reader, size_t chunkSize = DEFAULT_CHUNK_SIZE);
+    explicit StreamingLexer(std::istream& in, size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    // 取出下一个单词，输入结束时返回 false。
+    // Token::offset 为相对整个输入的偏移
+    bool next(Token& token);
+
+    // 最近一次 next() 返回的单词的词素，视图在下一次调用 next() 之前有效
+    std::string_view lexeme(const Token& token) const;
+
+    // 当前窗口占用的缓冲区容量（字节）
+    size_t bufferCapacity() const { return lexer.storage.capacity(); }
+
+private:
+    // 单词末尾之后最多还会向前查看的字节数（数字字面量的 "e+5"、宏调用的 "!=" 等）
+    static constexpr size_t LOOKAHEAD = 4;
+
+    Reader reader;
+    size_t chunkSize;
+    bool exhausted;
+    RustLexer lexer;    // 在当前窗口上扫描，窗口内容保存在 lexer.storage 中
+    size_t base;        // 窗口起点在整个输入中的偏移
+
+    void discardConsumed();
+    void refill(size_t bytes);
+};
+
+#endif // STREAMINGLEXER_H
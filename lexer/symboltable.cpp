@@ -0,0 +1,196 @@
+#include "symboltable.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+// 最高置位的位置，value 不为0
+unsigned highestBit(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - static_cast<unsigned>(__builtin_clzll(value));
+#else
+    unsigned bit = 0;
+    while (value >>= 1) {
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+}
+
+uint64_t hashSymbol(std::string_view name)
+{
+    // FNV-1a：标识符平均只有几个字节，逐字节处理比分块的哈希更快
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : name) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+SymbolTable::SymbolTable()
+    : shards(new Shard[SHARD_COUNT])
+{
+}
+
+SymbolTable::~SymbolTable()
+{
+    for (std::atomic<Entry*>& chunk : chunks) {
+        delete[] chunk.load(std::memory_order_relaxed);
+    }
+}
+
+SymbolTable::Entry& SymbolTable::entry(uint32_t id) const
+{
+    uint64_t biased = uint64_t(id) + FIRST_CHUNK_SIZE;
+    unsigned chunk = highestBit(biased) - FIRST_CHUNK_BITS;
+    Entry* entries = chunks[chunk].load(std::memory_order_acquire);
+    return entries[biased - (FIRST_CHUNK_SIZE << chunk)];
+}
+
+SymbolTable::Entry& SymbolTable::createEntry(uint32_t id)
+{
+    uint64_t biased = uint64_t(id) + FIRST_CHUNK_SIZE;
+    unsigned chunk = highestBit(biased) - FIRST_CHUNK_BITS;
+    Entry* entries = chunks[chunk].load(std::memory_order_acquire);
+    if (!entries) {
+        // 不同分片的线程可能同时需要新块，只保留先装入的一个
+        Entry* created = new Entry[FIRST_CHUNK_SIZE << chunk];
+        if (chunks[chunk].compare_exchange_strong(entries, created, std::memory_order_acq_rel)) {
+            entries = created;
+        } else {
+            delete[] created;
+        }
+    }
+    return entries[biased - (FIRST_CHUNK_SIZE << chunk)];
+}
+
+uint32_t SymbolTable::intern(std::string_view name, uint64_t occurrences)
+{
+    // 高位选分片，低位留给 SymbolCache 的开放寻址
+    Shard& shard = shards[hashSymbol(name) >> 58];
+    uint32_t id;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.ids.find(name);
+        if (it != shard.ids.end()) {
+            id = it->second;
+        } else {
+            id = nextId.fetch_add(1, std::memory_order_acq_rel);
+            if (id == NO_SYMBOL) {
+                throw std::length_error("SymbolTable: too many symbols");
+            }
+            char* text = static_cast<char*>(shard.names.allocate(std::max<size_t>(name.size(), 1), 1));
+            std::memcpy(text, name.data(), name.size());
+            Entry& created = createEntry(id);
+            created.name = std::string_view(text, name.size());
+            shard.ids.emplace(created.name, id);
+        }
+    }
+    if (occurrences != 0) {
+        addOccurrences(id, occurrences);
+    }
+    return id;
+}
+
+uint32_t SymbolTable::find(std::string_view name) const
+{
+    const Shard& shard = shards[hashSymbol(name) >> 58];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.ids.find(name);
+    return it != shard.ids.end() ? it->second : NO_SYMBOL;
+}
+
+void SymbolTable::addOccurrences(uint32_t id, uint64_t count)
+{
+    entry(id).occurrences.fetch_add(count, std::memory_order_relaxed);
+}
+
+std::vector<std::pair<uint32_t, uint64_t>> SymbolTable::mostFrequent(size_t limit) const
+{
+    std::vector<std::pair<uint32_t, uint64_t>> result;
+    size_t count = size();
+    result.reserve(count);
+    for (uint32_t id = 0; id < count; ++id) {
+        result.emplace_back(id, occurrences(id));
+    }
+
+    auto byCount = [](const std::pair<uint32_t, uint64_t>& a, const std::pair<uint32_t, uint64_t>& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    };
+    limit = std::min(limit, result.size());
+    std::partial_sort(result.begin(), result.begin() + limit, result.end(), byCount);
+    result.resize(limit);
+    return result;
+}
+
+SymbolCache::SymbolCache(SymbolTable& table)
+    : table(table), slots(256)
+{
+}
+
+SymbolCache::~SymbolCache()
+{
+    flush();
+}
+
+uint32_t SymbolCache::intern(std::string_view name)
+{
+    if ((used + 1) * 2 > slots.size()) {
+        grow();
+    }
+
+    uint32_t hash = static_cast<uint32_t>(hashSymbol(name));
+    size_t mask = slots.size() - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        Slot& slot = slots[i];
+        if (slot.id == NO_SYMBOL) {
+            // 本地未命中：到共享表中查找或分配，出现次数仍在本地累积
+            slot.id = table.intern(name, 0);
+            slot.name = table.name(slot.id);
+            slot.hash = hash;
+            slot.pending = 1;
+            ++used;
+            return slot.id;
+        }
+        if (slot.hash == hash && slot.name == name) {
+            if (++slot.pending == UINT32_MAX) {
+                table.addOccurrences(slot.id, slot.pending);
+                slot.pending = 0;
+            }
+            return slot.id;
+        }
+    }
+}
+
+void SymbolCache::flush()
+{
+    for (Slot& slot : slots) {
+        if (slot.pending != 0) {
+            table.addOccurrences(slot.id, slot.pending);
+            slot.pending = 0;
+        }
+    }
+}
+
+void SymbolCache::grow()
+{
+    std::vector<Slot> old(slots.size() * 2);
+    old.swap(slots);
+    size_t mask = slots.size() - 1;
+    for (const Slot& slot : old) {
+        if (slot.id == NO_SYMBOL) {
+            continue;
+        }
+        size_t i = slot.hash & mask;
+        while (slots[i].id != NO_SYMBOL) {
+            i = (i + 1) & mask;
+        }
+        slots[i] = slot;
+    }
+}
@@ -0,0 +1,112 @@
+#ifndef SYMBOLTABLE_H
+#define SYMBOLTABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "tokenarena.h"
+
+// 不是标识符的单词在符号列中的值
+constexpr uint32_t NO_SYMBOL = UINT32_MAX;
+
+// 标识符驻留表：把每个不同的标识符映射为从0开始连续的32位编号，同时统计出现次数。
+// 同一张表可以在多个线程、多个文件之间共享：查找和插入按哈希分片加锁，
+// name() 和 occurrences() 不加锁。编号和名称在表的生存期内保持不变
+class SymbolTable {
+public:
+    SymbolTable();
+    ~SymbolTable();
+
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    // 返回 name 的编号，不存在时分配新编号；计一次出现
+    uint32_t intern(std::string_view name) { return intern(name, 1); }
+    uint32_t intern(std::string_view name, uint64_t occurrences);
+
+    // 已存在时返回编号，否则返回 NO_SYMBOL
+    uint32_t find(std::string_view name) const;
+
+    std::string_view name(uint32_t id) const { return entry(id).name; }
+    uint64_t occurrences(uint32_t id) const { return entry(id).occurrences.load(std::memory_order_relaxed); }
+    void addOccurrences(uint32_t id, uint64_t count);
+
+    // 不同标识符的个数。与 mostFrequent() 一样，需要在没有线程正在驻留时读取
+    size_t size() const { return nextId.load(std::memory_order_acquire); }
+
+    // 出现次数最多的 limit 个标识符，按次数降序
+    std::vector<std::pair<uint32_t, uint64_t>> mostFrequent(size_t limit) const;
+
+private:
+    struct Entry {
+        std::string_view name;
+        std::atomic<uint64_t> occurrences{0};
+    };
+
+    // 编号 id 存放在第 k 块中，第 k 块容量为 FIRST_CHUNK_SIZE << k；
+    // 块只增不移，读取不必加锁
+    static constexpr unsigned FIRST_CHUNK_BITS = 10;
+    static constexpr size_t FIRST_CHUNK_SIZE = size_t(1) << FIRST_CHUNK_BITS;
+    static constexpr size_t CHUNK_COUNT = 32 - FIRST_CHUNK_BITS + 1;
+
+    static constexpr size_t SHARD_COUNT = 64;
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string_view, uint32_t> ids;     // 键指向 names 中的名称
+        TokenArena names{4096};
+    };
+
+    std::atomic<Entry*> chunks[CHUNK_COUNT] = {};
+    std::atomic<uint32_t> nextId{0};
+    std::unique_ptr<Shard[]> shards;
+
+    Entry& entry(uint32_t id) const;
+    Entry& createEntry(uint32_t id);
+};
+
+// 标识符的哈希值，SymbolTable 和 SymbolCache 共用
+uint64_t hashSymbol(std::string_view name);
+
+// 单线程使用的驻留缓存：放在共享的 SymbolTable 之前，文件内重复出现的标识符
+// 只在本地的开放寻址哈希表中查找，不加锁；出现次数在本地累积，flush() 或析构时写回表中。
+// 每个线程（或每个文件）使用各自的缓存
+class SymbolCache {
+public:
+    explicit SymbolCache(SymbolTable& table);
+    ~SymbolCache();
+
+    SymbolCache(const SymbolCache&) = delete;
+    SymbolCache& operator=(const SymbolCache&) = delete;
+
+    // 返回 name 的编号并计一次出现
+    uint32_t intern(std::string_view name);
+
+    // 把本地累积的出现次数写回表中
+    void flush();
+
+    SymbolTable& symbolTable() const { return table; }
+
+private:
+    struct Slot {
+        std::string_view name;      // 指向表中保存的名称，命中时直接比较，不必再查表
+        uint32_t hash = 0;
+        uint32_t id = NO_SYMBOL;    // NO_SYMBOL 表示空槽
+        uint32_t pending = 0;       // 尚未写回的出现次数
+    };
+
+    SymbolTable& table;
+    std::vector<Slot> slots;        // 容量为2的幂，负载不超过一半
+    size_t used = 0;
+
+    void grow();
+};
+
+#endif // SYMBOLTABLE_H
@@ -0,0 +1,195 @@
+#include "threadpool.h"
+
+namespace {
+
+// 当前线程所属的线程池及其队列编号，用于在任务内部提交时找到自己的队列
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local size_t currentQueue = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t threadCount)
+{
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+
+    for (size_t i = 0; i < threadCount; i++) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (size_t i = 0; i < threadCount; i++) {
+        threads.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(Task task)
+{
+    size_t index = currentPool == this
+        ? currentQueue
+        : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+
+    pending.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+        queued.fetch_add(1);
+    }
+
+    // 先经过 stateMutex 再通知，避免与正在进入等待的工作线程错过唤醒
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+    }
+    workAvailable.notify_one();
+}
+
+void ThreadPool::wait()
+{
+    std::unique_lock<std::mutex> lock(stateMutex);
+    allDone.wait(lock, [this]() { return pending.load() == 0; });
+
+    if (firstError) {
+        std::exception_ptr error = firstError;
+        firstError = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& body)
+{
+    struct Batch {
+        std::mutex mutex;
+        std::condition_variable done;
+        size_t remaining;
+        std::exception_ptr error;   // 这一批中第一个异常，不进入线程池的 firstError
+    } batch;
+    batch.remaining = count;
+
+    for (size_t i = 0; i < count; i++) {
+        submit([&batch, &body, i]() {
+            // 无论 body 是否抛出异常都要计数，否则等待方永远不会返回
+            struct Finish {
+                Batch& batch;
+                ~Finish()
+                {
+                    std::lock_guard<std::mutex> lock(batch.mutex);
+                    if (--batch.remaining == 0) {
+                        batch.done.notify_all();
+                    }
+                }
+            } finish{batch};
+            try {
+                body(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(batch.mutex);
+                if (!batch.error) {
+                    batch.error = std::current_exception();
+                }
+            }
+        });
+    }
+
+    size_t self = currentPool == this ? currentQueue : 0;
+    Task task;
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(batch.mutex);
+            if (batch.remaining == 0) {
+                break;
+            }
+        }
+        if (takeTask(self, task)) {
+            runTask(task);
+            continue;
+        }
+        // 队列已空，剩下的任务都在其他线程上执行
+        std::unique_lock<std::mutex> lock(batch.mutex);
+        batch.done.wait(lock, [&batch]() { return batch.remaining == 0; });
+        break;
+    }
+
+    // 所有任务都已结束，batch 不再被其他线程访问
+    if (batch.error) {
+        std::rethrow_exception(batch.error);
+    }
+}
+
+bool ThreadPool::takeTask(size_t self, Task& task)
+{
+    // 先取自己队列的队尾（最近提交、缓存最热的任务）
+    {
+        WorkQueue& own = *queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+
+    // 再从其他队列的队首窃取
+    for (size_t i = 1; i < queues.size(); i++) {
+        WorkQueue& victim = *queues[(self + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::runTask(Task& task)
+{
+    try {
+        task();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if (!firstError) {
+            firstError = std::current_exception();
+        }
+    }
+    task = nullptr;
+
+    if (pending.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        allDone.notify_all();
+    }
+}
+
+void ThreadPool::workerLoop(size_t index)
+{
+    currentPool = this;
+    currentQueue = index;
+
+    Task task;
+    while (true) {
+        if (takeTask(index, task)) {
+            runTask(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(stateMutex);
+        workAvailable.wait(lock, [this]() { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 工作窃取线程池：每个工作线程有自己的任务队列，从队尾取自己的任务，
+// 空闲时从其他线程的队首窃取。外部提交的任务轮流分配到各个队列。
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    // threadCount 为0时使用硬件线程数
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // 提交任务；在工作线程内提交时放入该线程自己的队列
+    void submit(Task task);
+
+    // 等待所有已提交的任务完成。任务抛出的第一个异常在此重新抛出
+    void wait();
+
+    // 并行执行 body(0..count-1)，只等待这一批任务；等待期间调用线程也会执行队列中的任务，
+    // 因此可以在工作线程内部调用而不会死锁。body 抛出的第一个异常在这一批全部结束后
+    // 从本调用重新抛出，不会留给 wait()
+    void parallelFor(size_t count, const std::function<void(size_t)>& body);
+
+    size_t threadCount() const { return threads.size(); }
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> threads;
+
+    std::mutex stateMutex;
+    std::condition_variable workAvailable;
+    std::condition_variable allDone;
+    std::atomic<size_t> queued{0};      // 在队列中尚未取出的任务数
+    std::atomic<size_t> pending{0};     // 已提交尚未完成的任务数
+    std::atomic<size_t> nextQueue{0};
+    bool stopping = false;
+    std::exception_ptr firstError;
+
+    bool takeTask(size_t self, Task& task);
+    void runTask(Task& task);
+    void workerLoop(size_t index);
+};
+
+#endif // THREADPOOL_H
@@ -0,0 +1,55 @@
+#ifndef TOKEN_H
+#define TOKEN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include "operators.h"
+
+// 单词类型枚举
+enum class TokenType : uint8_t {
+    KEYWORD,         // 关键字
+    IDENTIFIER,      // 标识符
+    INTEGER_LITERAL, // 整数字面量
+    FLOAT_LITERAL,   // 浮点数字面量
+    STRING_LITERAL,  // 字符串字面量
+    CHAR_LITERAL,    // 字符字面量
+    OPERATOR,        // 运算符
+    DELIMITER,       // 分隔符
+    COMMENT,         // 注释
+    MACRO_CALL,      // 宏调用
+    LIFETIME,        // 生命周期或循环标签（'a、'static、'outer）
+    UNKNOWN          // 未知类型，包括未闭合或格式错误的字面量（见 diagnostics.h）
+};
+
+constexpr size_t TOKEN_TYPE_COUNT = size_t(TokenType::UNKNOWN) + 1;
+
+// 单词类型的集合，第 n 位对应编号为 n 的 TokenType
+using TokenTypeMask = uint16_t;
+
+constexpr TokenTypeMask tokenTypeBit(TokenType type)
+{
+    return TokenTypeMask(1u << unsigned(type));
+}
+
+constexpr TokenTypeMask ALL_TOKEN_TYPES = TokenTypeMask((1u << TOKEN_TYPE_COUNT) - 1);
+static_assert(TOKEN_TYPE_COUNT <= sizeof(TokenTypeMask) * 8, "TokenTypeMask 容纳不下所有单词类型");
+
+// 单词结构
+// 词素不复制到Token中，而是以偏移和长度引用词法分析器持有的源码缓冲区，
+// 需要文本时通过 RustLexer::lexeme() 或 Token::text() 按需取出。
+// 行号和列号不随单词保存，需要时由 LineIndex 按偏移计算
+struct Token {
+    TokenType type;      // 词素类型
+    OperatorId op;       // 运算符/分隔符编号，其他类型为 OperatorId::None
+    size_t offset;       // 词素在源码缓冲区中的起始偏移（字节）
+    size_t length;       // 词素长度（字节）
+
+    // 取出词素视图，source 必须是产生该Token的源码缓冲区
+    std::string_view text(std::string_view source) const
+    {
+        return source.substr(offset, length);
+    }
+};
+
+#endif // TOKEN_H
@@ -0,0 +1,82 @@
+#include "tokenarena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+TokenArena::TokenArena(size_t initialBlockSize, std::pmr::memory_resource* upstream)
+    : upstream(upstream), nextBlockSize(std::max<size_t>(initialBlockSize, 256))
+{
+}
+
+TokenArena::~TokenArena()
+{
+    release();
+}
+
+void TokenArena::reset()
+{
+    if (blocks.size() > 1) {
+        // 合并为一块，下次同样规模的分配不必再逐块增长
+        size_t total = reserved;
+        release();
+        nextBlockSize = total;
+        addBlock(total);
+    }
+    used = 0;
+    totalUsed = 0;
+}
+
+void TokenArena::release()
+{
+    for (const Block& block : blocks) {
+        upstream->deallocate(block.data, block.size, alignof(std::max_align_t));
+    }
+    blocks.clear();
+    used = 0;
+    totalUsed = 0;
+    reserved = 0;
+}
+
+void TokenArena::addBlock(size_t minimumSize)
+{
+    size_t size = std::max(nextBlockSize, minimumSize);
+    char* data = static_cast<char*>(upstream->allocate(size, alignof(std::max_align_t)));
+    blocks.push_back({data, size});
+    reserved += size;
+    used = 0;
+    // 块大小按几何级数增长，块数随总量对数增长
+    nextBlockSize = size * 2;
+}
+
+void* TokenArena::do_allocate(size_t bytes, size_t alignment)
+{
+    if (!blocks.empty()) {
+        const Block& block = blocks.back();
+        uintptr_t top = reinterpret_cast<uintptr_t>(block.data) + used;
+        size_t padding = (alignment - top % alignment) % alignment;
+        if (padding + bytes <= block.size - used) {
+            used += padding + bytes;
+            totalUsed += padding + bytes;
+            return reinterpret_cast<void*>(top + padding);
+        }
+    }
+
+    // 新块的起点按 max_align_t 对齐，更严格的对齐要求预留填充
+    size_t extra = alignment > alignof(std::max_align_t) ? alignment : 0;
+    addBlock(bytes + extra);
+    return do_allocate(bytes, alignment);
+}
+
+void TokenArena::do_deallocate(void* p, size_t bytes, size_t)
+{
+    // 只有最近一次分配可以就地收回，其余留到 reset()/release() 时整体释放
+    if (!blocks.empty() && static_cast<char*>(p) + bytes == blocks.back().data + used) {
+        used -= bytes;
+        totalUsed -= bytes;
+    }
+}
+
+bool TokenArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
@@ -0,0 +1,53 @@
+#ifndef TOKENARENA_H
+#define TOKENARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+// 单调递增的内存区：只向前分配，单独释放不回收，整个分析结果一次性释放。
+// 配合 RustLexer::tokenize(resource) 使用，批量分析大量文件时每个线程持有一个，
+// 每个文件分析完后 reset()，下一个文件直接复用同一块内存，不再经过全局堆。
+// 不是线程安全的；分配出的内存在 reset()/release() 之后失效，
+// 使用其中内存的 TokenStream 必须先销毁
+class TokenArena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit TokenArena(size_t initialBlockSize = DEFAULT_BLOCK_SIZE,
+                        std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    ~TokenArena() override;
+
+    TokenArena(const TokenArena&) = delete;
+    TokenArena& operator=(const TokenArena&) = delete;
+
+    // 丢弃所有分配但保留内存。用过多块时合并为一块总大小相同的块，
+    // 之后同样规模的分析只需一块
+    void reset();
+    // 丢弃所有分配并把内存归还上游
+    void release();
+
+    size_t bytesUsed() const { return totalUsed; }      // 当前已分配出的字节（含对齐填充）
+    size_t bytesReserved() const { return reserved; }   // 从上游申请的字节
+
+private:
+    struct Block {
+        char* data;
+        size_t size;
+    };
+
+    std::pmr::memory_resource* upstream;
+    std::vector<Block> blocks;
+    size_t nextBlockSize;
+    size_t used = 0;        // 最后一块中已使用的字节
+    size_t totalUsed = 0;
+    size_t reserved = 0;
+
+    void addBlock(size_t minimumSize);
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
+
+#endif // TOKENARENA_H
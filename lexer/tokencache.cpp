@@ -0,0 +1,247 @@
+#include "tokencache.h"
+#include "rustlexer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+static_assert(sizeof(TokenCacheHeader) == 32, "缓存文件头必须为32字节，保证后面的数组按4字节对齐");
+
+namespace {
+
+// ---- xxHash64 ----
+
+constexpr uint64_t PRIME1 = 11400714785074694791ULL;
+constexpr uint64_t PRIME2 = 14029467366897019727ULL;
+constexpr uint64_t PRIME3 = 1609587929392839161ULL;
+constexpr uint64_t PRIME4 = 9650029242287828579ULL;
+constexpr uint64_t PRIME5 = 2870177450012600261ULL;
+
+inline uint64_t rotateLeft(uint64_t x, int bits)
+{
+    return (x << bits) | (x >> (64 - bits));
+}
+
+inline uint64_t read64(const char* p)
+{
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint32_t read32(const char* p)
+{
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint64_t hashRound(uint64_t acc, uint64_t input)
+{
+    acc += input * PRIME2;
+    acc = rotateLeft(acc, 31);
+    return acc * PRIME1;
+}
+
+inline uint64_t mergeRound(uint64_t acc, uint64_t value)
+{
+    acc ^= hashRound(0, value);
+    return acc * PRIME1 + PRIME4;
+}
+
+// ---- 缓存内容校验 ----
+
+// 缓存文件可能被截断以外的方式损坏或篡改，使用前逐个检查单词：
+// 种类必须是已知的类型或运算符编号，单词按偏移递增、互不重叠，且不越过源码末尾。
+// 通过检查的视图即使内容不对，按偏移取词素也不会越界
+bool validTokens(const uint32_t* offsets, const uint32_t* lengths, const uint8_t* kinds,
+                 size_t count, uint64_t sourceSize)
+{
+    uint64_t previousEnd = 0;
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t kind = kinds[i];
+        if (kind < TokenKind::OPERATOR_KIND_BASE) {
+            if (kind > uint8_t(TokenType::UNKNOWN)) {
+                return false;
+            }
+        } else if (kind == TokenKind::OPERATOR_KIND_BASE
+                   || kind - TokenKind::OPERATOR_KIND_BASE >= int(OperatorId::Count)) {
+            return false;
+        }
+        const uint64_t end = uint64_t(offsets[i]) + lengths[i];
+        if (offsets[i] < previousEnd || end > sourceSize) {
+            return false;
+        }
+        previousEnd = end;
+    }
+    return true;
+}
+
+} // namespace
+
+uint64_t contentHash(std::string_view data)
+{
+    const char* p = data.data();
+    const char* end = p + data.size();
+    uint64_t hash;
+
+    if (data.size() >= 32) {
+        // 四路并行累加，每次处理32字节
+        uint64_t v1 = PRIME1 + PRIME2;
+        uint64_t v2 = PRIME2;
+        uint64_t v3 = 0;
+        uint64_t v4 = 0 - PRIME1;
+        const char* limit = end - 32;
+        do {
+            v1 = hashRound(v1, read64(p));
+            v2 = hashRound(v2, read64(p + 8));
+            v3 = hashRound(v3, read64(p + 16));
+            v4 = hashRound(v4, read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+
+        hash = rotateLeft(v1, 1) + rotateLeft(v2, 7) + rotateLeft(v3, 12) + rotateLeft(v4, 18);
+        hash = mergeRound(hash, v1);
+        hash = mergeRound(hash, v2);
+        hash = mergeRound(hash, v3);
+        hash = mergeRound(hash, v4);
+    } else {
+        hash = PRIME5;
+    }
+
+    hash += static_cast<uint64_t>(data.size());
+
+    for (; p + 8 <= end; p += 8) {
+        hash ^= hashRound(0, read64(p));
+        hash = rotateLeft(hash, 27) * PRIME1 + PRIME4;
+    }
+    if (p + 4 <= end) {
+        hash ^= static_cast<uint64_t>(read32(p)) * PRIME1;
+        hash = rotateLeft(hash, 23) * PRIME2 + PRIME3;
+        p += 4;
+    }
+    for (; p < end; p++) {
+        hash ^= static_cast<uint64_t>(static_cast<unsigned char>(*p)) * PRIME5;
+        hash = rotateLeft(hash, 11) * PRIME1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= PRIME2;
+    hash ^= hash >> 29;
+    hash *= PRIME3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+TokenCache::TokenCache(std::string directory)
+    : directory(std::move(directory))
+{
+    std::error_code ec;
+    fs::create_directories(fs::u8path(this->directory), ec);
+}
+
+CachedTokens TokenCache::tokenize(std::string_view source, std::pmr::memory_resource* resource)
+{
+    CachedTokens result(resource);
+    if (source.size() > TokenStream::MAX_SOURCE_SIZE) {
+        // 超出紧凑格式的范围，与 RustLexer::tokenize() 一样拒绝
+        throw std::length_error("TokenCache: source exceeds TokenStream::MAX_SOURCE_SIZE");
+    }
+
+    uint64_t hash = contentHash(source);
+    if (load(hash, source.size(), result)) {
+        hitCount++;
+        return result;
+    }
+
+    missCount++;
+    RustLexer lexer(source.data(), source.size());
+    result.stream = lexer.tokenize(resource);
+    result.tokens = result.stream.view();
+    store(hash, source.size(), result.stream);
+    return result;
+}
+
+bool TokenCache::load(uint64_t hash, size_t sourceSize, CachedTokens& result) const
+{
+    MappedFile mapped;
+    if (!mapped.open(pathFor(hash)) || mapped.size() < sizeof(TokenCacheHeader)) {
+        return false;
+    }
+
+    TokenCacheHeader header;
+    std::memcpy(&header, mapped.data(), sizeof(header));
+    if (header.magic != TOKEN_CACHE_MAGIC || header.version != TOKEN_CACHE_VERSION
+        || header.contentHash != hash || header.sourceSize != sourceSize) {
+        return false;
+    }
+    // 文件长度必须与单词数一致，防止读到被截断的文件
+    const uint64_t count = header.tokenCount;
+    if (count > (mapped.size() - sizeof(TokenCacheHeader)) / 9
+        || mapped.size() != sizeof(TokenCacheHeader) + count * 9) {
+        return false;
+    }
+
+    // 头部为32字节，偏移和长度数组都按4字节对齐，可直接使用；内容损坏时按未命中处理
+    const char* base = mapped.data() + sizeof(TokenCacheHeader);
+    const uint32_t* offsets = reinterpret_cast<const uint32_t*>(base);
+    const uint32_t* lengths = reinterpret_cast<const uint32_t*>(base + count * 4);
+    const uint8_t* kinds = reinterpret_cast<const uint8_t*>(base + count * 8);
+    if (!validTokens(offsets, lengths, kinds, static_cast<size_t>(count), sourceSize)) {
+        return false;
+    }
+    result.tokens = TokenView(offsets, lengths, kinds, static_cast<size_t>(count));
+    result.mapped = std::move(mapped);
+    result.hit = true;
+    return true;
+}
+
+bool TokenCache::store(uint64_t hash, size_t sourceSize, const TokenStream& tokens) const
+{
+    TokenCacheHeader header{TOKEN_CACHE_MAGIC, TOKEN_CACHE_VERSION, hash, sourceSize, tokens.size()};
+    TokenView view = tokens.view();
+
+    // 临时文件名包含线程标识和时间，并发写入互不干扰
+    std::string path = pathFor(hash);
+    std::string temporary = path + ".tmp"
+        + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()))
+        + "-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+    std::error_code ec;
+    {
+        std::ofstream out(fs::u8path(temporary), std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(view.offsetData()), std::streamsize(view.size() * 4));
+        out.write(reinterpret_cast<const char*>(view.lengthData()), std::streamsize(view.size() * 4));
+        out.write(reinterpret_cast<const char*>(view.kindData()), std::streamsize(view.size()));
+        out.close();
+        if (!out) {
+            fs::remove(fs::u8path(temporary), ec);
+            return false;
+        }
+    }
+
+    fs::rename(fs::u8path(temporary), fs::u8path(path), ec);
+    if (ec) {
+        fs::remove(fs::u8path(temporary), ec);
+        return false;
+    }
+    return true;
+}
+
+std::string TokenCache::pathFor(uint64_t hash) const
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.rltk", static_cast<unsigned long long>(hash));
+    return (fs::u8path(directory) / name).u8string();
+}
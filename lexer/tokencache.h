@@ -0,0 +1,82 @@
+#ifndef TOKENCACHE_H
+#define TOKENCACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "mappedfile.h"
+#include "tokenstream.h"
+
+// 二进制单词缓存文件格式（整数均为本机字节序）：
+//   TokenCacheHeader
+//   uint32_t offsets[tokenCount]
+//   uint32_t lengths[tokenCount]
+//   uint8_t  kinds[tokenCount]
+// 与 TokenStream 的按列布局相同，映射后直接作为 TokenView 使用，无需解码
+struct TokenCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t contentHash;   // 源码的 contentHash()
+    uint64_t sourceSize;    // 源码字节数
+    uint64_t tokenCount;
+};
+
+constexpr uint32_t TOKEN_CACHE_MAGIC = 0x4b544c52;  // 小端序下为 "RLTK"
+// 词法规则或种类编码变化时必须递增，旧缓存随之失效
+constexpr uint32_t TOKEN_CACHE_VERSION = 5;
+
+// 源码内容的64位哈希（xxHash64 算法，种子为0）
+uint64_t contentHash(std::string_view data);
+
+// 一个源文件的单词序列：命中缓存时引用映射的缓存文件，未命中时持有新分析的结果。
+// 移动后视图仍然有效
+class CachedTokens {
+public:
+    CachedTokens() = default;
+
+    TokenView view() const { return tokens; }
+    bool fromCache() const { return hit; }
+
+private:
+    friend class TokenCache;
+
+    explicit CachedTokens(std::pmr::memory_resource* resource) : stream(resource) {}
+
+    MappedFile mapped;
+    TokenStream stream;
+    TokenView tokens;
+    bool hit = false;
+};
+
+// 以内容哈希为键的单词缓存目录，每个源码内容对应一个 <哈希>.rltk 文件。
+// 内容不变的文件即使改名或移动也能命中。可以在多个线程中同时使用
+class TokenCache {
+public:
+    // 目录不存在时自动创建
+    explicit TokenCache(std::string directory);
+
+    // 返回 source 的单词序列：命中时直接映射缓存文件，不做词法分析；
+    // 未命中时分析并写入缓存（写入失败不影响结果），分析结果从 resource 分配。
+    // 源码超过 TokenStream::MAX_SOURCE_SIZE 时抛出 std::length_error
+    CachedTokens tokenize(std::string_view source,
+                          std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    // 读取缓存，文件不存在、与源码不符或内容损坏（未知种类、单词重叠或越界）时返回 false
+    bool load(uint64_t hash, size_t sourceSize, CachedTokens& result) const;
+    // 写入缓存：先写临时文件再改名，并发写入同一内容时不会留下不完整的文件
+    bool store(uint64_t hash, size_t sourceSize, const TokenStream& tokens) const;
+
+    const std::string& directoryPath() const { return directory; }
+    size_t hits() const { return hitCount.load(); }
+    size_t misses() const { return missCount.load(); }
+
+private:
+    std::string directory;
+    std::atomic<size_t> hitCount{0};
+    std::atomic<size_t> missCount{0};
+
+    std::string pathFor(uint64_t hash) const;
+};
+
+#endif // TOKENCACHE_H
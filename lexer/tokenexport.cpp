@@ -0,0 +1,472 @@
+#include "tokenexport.h"
+#include "fastskip.h"
+#include "rustlexer.h"
+#include "unicodeident.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+namespace {
+
+// 单条记录中除路径和词素以外部分的上限：类型名、字段名和4个十进制整数
+constexpr size_t MAX_RECORD_OVERHEAD = 160;
+
+// 转义词素时每次处理的输入字节数；每个字节最多展开为6个字节（\u00XX）
+constexpr size_t ESCAPE_CHUNK = 4096;
+constexpr size_t MAX_ESCAPE_EXPANSION = 6;
+
+constexpr uint8_t BINARY_FILE_RECORD = 0xFE;
+
+// 与 TokenType 的枚举名一致，作为稳定的机器可读名称
+const std::string_view KIND_NAMES[] = {
+    "KEYWORD", "IDENTIFIER", "INTEGER_LITERAL", "FLOAT_LITERAL", "STRING_LITERAL",
+    "CHAR_LITERAL", "OPERATOR", "DELIMITER", "COMMENT", "MACRO_CALL", "LIFETIME", "UNKNOWN"
+};
+static_assert(sizeof(KIND_NAMES) / sizeof(KIND_NAMES[0]) == size_t(TokenType::UNKNOWN) + 1,
+              "KIND_NAMES 必须覆盖所有 TokenType");
+
+std::string_view kindName(TokenType type)
+{
+    size_t index = static_cast<size_t>(type);
+    return KIND_NAMES[std::min(index, size_t(TokenType::UNKNOWN))];
+}
+
+inline char* appendText(char* p, std::string_view text)
+{
+    std::memcpy(p, text.data(), text.size());
+    return p + text.size();
+}
+
+inline char* appendNumber(char* p, uint64_t value)
+{
+    return std::to_chars(p, p + 20, value).ptr;
+}
+
+inline char* appendVarint(char* p, uint64_t value)
+{
+    while (value >= 0x80) {
+        *p++ = char(uint8_t(value) | 0x80);
+        value >>= 7;
+    }
+    *p++ = char(value);
+    return p;
+}
+
+// 把 text 中 [i, chunkEnd) 按 JSON 字符串的规则转义后写到 p（不含两侧引号），返回写入的末尾。
+// 非法的 UTF-8 字节替换为 U+FFFD，保证输出是合法的 JSON 文本；
+// 多字节序列可以越过 chunkEnd，i 停在下一个未处理的字节
+char* appendJsonEscaped(char* p, std::string_view text, size_t& i, size_t chunkEnd)
+{
+    static const char HEX[] = "0123456789abcdef";
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(text.data());
+    char32_t codePoint;
+    while (i < chunkEnd) {
+        unsigned char c = data[i];
+        if (c >= 0x20 && c < 0x80 && c != '"' && c != '\\') {
+            *p++ = char(c);
+            i++;
+            continue;
+        }
+        if (c >= 0x80) {
+            size_t count = decodeUtf8(text.data() + i, text.size() - i, codePoint);
+            if (count != 0) {
+                std::memcpy(p, data + i, count);
+                p += count;
+                i += count;
+            } else {
+                p = appendText(p, "\\ufffd");
+                i++;
+            }
+            continue;
+        }
+        *p++ = '\\';
+        switch (c) {
+        case '"':  *p++ = '"'; break;
+        case '\\': *p++ = '\\'; break;
+        case '\n': *p++ = 'n'; break;
+        case '\r': *p++ = 'r'; break;
+        case '\t': *p++ = 't'; break;
+        default:
+            *p++ = 'u';
+            *p++ = '0';
+            *p++ = '0';
+            *p++ = HEX[c >> 4];
+            *p++ = HEX[c & 0xF];
+            break;
+        }
+        i++;
+    }
+    return p;
+}
+
+// 分段转义写出，每段预留最坏情况的空间
+void writeJsonEscaped(BufferedWriter& out, std::string_view text)
+{
+    size_t i = 0;
+    while (i < text.size()) {
+        size_t chunk = std::min(ESCAPE_CHUNK, (out.capacity() - 8) / MAX_ESCAPE_EXPANSION);
+        size_t chunkEnd = std::min(text.size(), i + chunk);
+        out.reserve((chunkEnd - i) * MAX_ESCAPE_EXPANSION + 8);
+        char* begin = out.cursor();
+        out.commit(size_t(appendJsonEscaped(begin, text, i, chunkEnd) - begin));
+    }
+}
+
+bool csvNeedsQuotes(std::string_view text)
+{
+    return text.find_first_of(",\"\r\n") != std::string_view::npos;
+}
+
+// CSV 字段：含逗号、引号或换行时整体加引号，内部的引号写两次
+void writeCsvField(BufferedWriter& out, std::string_view text)
+{
+    if (!csvNeedsQuotes(text)) {
+        out.write(text);
+        return;
+    }
+    out.put('"');
+    size_t start = 0;
+    while (true) {
+        size_t quote = text.find('"', start);
+        if (quote == std::string_view::npos) {
+            out.write(text.substr(start));
+            break;
+        }
+        out.write(text.substr(start, quote + 1 - start));
+        out.put('"');
+        start = quote + 1;
+    }
+    out.put('"');
+}
+
+} // namespace
+
+bool parseExportFormat(std::string_view name, ExportFormat& format)
+{
+    if (name == "jsonl" || name == "json") {
+        format = ExportFormat::JsonLines;
+    } else if (name == "csv") {
+        format = ExportFormat::Csv;
+    } else if (name == "binary" || name == "bin") {
+        format = ExportFormat::Binary;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* exportFormatName(ExportFormat format)
+{
+    switch (format) {
+    case ExportFormat::JsonLines: return "jsonl";
+    case ExportFormat::Csv:       return "csv";
+    case ExportFormat::Binary:    return "binary";
+    }
+    return "?";
+}
+
+BufferedWriter::BufferedWriter(std::FILE* file, std::mutex* lock, size_t capacity)
+    : file(file), lock(lock), buffer(new char[std::max<size_t>(capacity, 256)]),
+      size(std::max<size_t>(capacity, 256))
+{
+}
+
+BufferedWriter::~BufferedWriter()
+{
+    flush();
+}
+
+bool BufferedWriter::reserve(size_t bytes)
+{
+    if (size - used >= bytes) {
+        return true;
+    }
+    flush();
+    return bytes <= size;
+}
+
+void BufferedWriter::write(const char* data, size_t length)
+{
+    if (length <= size - used) {
+        std::memcpy(buffer.get() + used, data, length);
+        used += length;
+        return;
+    }
+    flush();
+    if (length >= size) {
+        // 比整个缓冲区还大的数据直接写出，不经过缓冲区
+        writeOut(data, length);
+    } else {
+        std::memcpy(buffer.get(), data, length);
+        used = length;
+    }
+}
+
+void BufferedWriter::put(char c)
+{
+    if (used == size) {
+        flush();
+    }
+    buffer[used++] = c;
+}
+
+bool BufferedWriter::flush()
+{
+    if (used != 0) {
+        writeOut(buffer.get(), used);
+        used = 0;
+    }
+    return !failed;
+}
+
+void BufferedWriter::writeOut(const char* data, size_t length)
+{
+    if (failed) {
+        return;
+    }
+    size_t count;
+    if (lock && !held.owns_lock()) {
+        if (inRecord) {
+            // 记录要分段写出：持有锁直到 endRecord()
+            held = std::unique_lock<std::mutex>(*lock);
+            count = std::fwrite(data, 1, length, file);
+        } else {
+            std::lock_guard<std::mutex> guard(*lock);
+            count = std::fwrite(data, 1, length, file);
+        }
+    } else {
+        count = std::fwrite(data, 1, length, file);
+    }
+    written += count;
+    failed = count != length;
+}
+
+void BufferedWriter::endRecord()
+{
+    inRecord = false;
+    if (held.owns_lock()) {
+        flush();
+        held.unlock();
+    }
+}
+
+TokenExporter::TokenExporter(BufferedWriter& out, ExportFormat format)
+    : out(out), format(format)
+{
+}
+
+void TokenExporter::writeHeader()
+{
+    switch (format) {
+    case ExportFormat::JsonLines:
+        break;
+    case ExportFormat::Csv:
+        out.write("file,kind,offset,line,column,lexeme\n");
+        break;
+    case ExportFormat::Binary: {
+        const char header[] = {'R', 'L', 'X', 'E', char(BINARY_VERSION)};
+        out.write(header, sizeof(header));
+        break;
+    }
+    }
+}
+
+size_t TokenExporter::exportSource(std::string_view path, std::string_view source, TokenTypeMask types)
+{
+    beginFile(path, source);
+    RustLexer lexer(source.data(), source.size());
+    Token token;
+    size_t count = 0;
+    while (lexer.nextToken(token, types)) {
+        writeToken(token.type, token.offset, token.length);
+        count++;
+    }
+    return count;
+}
+
+size_t TokenExporter::exportTokens(std::string_view path, std::string_view source, const TokenStream& tokens,
+                                   TokenTypeMask types)
+{
+    beginFile(path, source);
+    size_t count = 0;
+    for (size_t i = 0; i < tokens.size(); i++) {
+        if ((types & tokenTypeBit(tokens.type(i))) != 0) {
+            writeToken(tokens.type(i), tokens.offset(i), tokens.length(i));
+            count++;
+        }
+    }
+    return count;
+}
+
+void TokenExporter::beginFile(std::string_view path, std::string_view source)
+{
+    this->path = path;
+    this->source = source;
+    scanned = 0;
+    line = 1;
+    lineStart = 0;
+    counted = 0;
+    column = 0;
+
+    // 路径每个文件只转义一次，之后的每条记录直接复制
+    escapedPath.clear();
+    if (format == ExportFormat::Csv) {
+        if (csvNeedsQuotes(path)) {
+            escapedPath += '"';
+            for (char c : path) {
+                escapedPath += c;
+                if (c == '"') {
+                    escapedPath += '"';
+                }
+            }
+            escapedPath += '"';
+        } else {
+            escapedPath.assign(path);
+        }
+        return;
+    }
+    if (format == ExportFormat::JsonLines) {
+        escapedPath.resize(path.size() * MAX_ESCAPE_EXPANSION);
+        size_t i = 0;
+        char* end = appendJsonEscaped(&escapedPath[0], path, i, path.size());
+        escapedPath.resize(size_t(end - escapedPath.data()));
+    } else {
+        escapedPath.assign(path);
+    }
+    out.beginRecord();
+    writeFileRecord();
+    out.endRecord();
+}
+
+void TokenExporter::writeFileRecord()
+{
+    previousEnd = 0;
+    previousLine = 1;
+    if (format == ExportFormat::Csv) {
+        return;
+    }
+
+    if (format == ExportFormat::JsonLines) {
+        out.write("{\"file\":\"");
+        out.write(escapedPath);
+        out.write("\"}\n");
+    } else {
+        out.reserve(MAX_RECORD_OVERHEAD);
+        char* begin = out.cursor();
+        char* p = begin;
+        *p++ = char(BINARY_FILE_RECORD);
+        p = appendVarint(p, escapedPath.size());
+        out.commit(size_t(p - begin));
+        out.write(escapedPath);
+    }
+}
+
+void TokenExporter::writeToken(TokenType type, size_t offset, size_t length)
+{
+    // 行号游标只向前推进，换行由快速跳过内核定位
+    while (scanned < offset) {
+        size_t found = scanUntil(source.data() + scanned, offset - scanned, '\n', '\n');
+        if (found == offset - scanned) {
+            scanned = offset;
+            break;
+        }
+        line++;
+        lineStart = scanned + found + 1;
+        scanned = lineStart;
+        counted = lineStart;
+        column = 0;
+    }
+    // 列号以码点计，同一行上从上一个单词处接着数
+    column += countCodePoints(source.data() + counted, offset - counted);
+    counted = offset;
+
+    // 整条记录（连同可能需要重复的文件记录）一次预留，记录不会跨越两次写出；
+    // 只有路径或词素很长、记录超过缓冲区容量时才会分段写出，这时各段在同一次持锁中写出
+    size_t estimate = 2 * (MAX_RECORD_OVERHEAD + escapedPath.size()) + length * MAX_ESCAPE_EXPANSION;
+    out.beginRecord();
+    out.reserve(estimate);
+    if (out.buffered() == 0) {
+        writeFileRecord();
+    }
+
+    switch (format) {
+    case ExportFormat::JsonLines:
+        writeJsonToken(type, offset, length);
+        break;
+    case ExportFormat::Csv:
+        writeCsvToken(type, offset, length);
+        break;
+    case ExportFormat::Binary:
+        writeBinaryToken(type, offset, length);
+        break;
+    }
+    out.endRecord();
+}
+
+void TokenExporter::writeJsonToken(TokenType type, size_t offset, size_t length)
+{
+    std::string_view lexeme = source.substr(offset, length);
+    size_t worst = MAX_RECORD_OVERHEAD + length * MAX_ESCAPE_EXPANSION;
+    bool whole = out.reserve(worst);
+    char* begin = out.cursor();
+    char* p = begin;
+    p = appendText(p, "{\"kind\":\"");
+    p = appendText(p, kindName(type));
+    p = appendText(p, "\",\"offset\":");
+    p = appendNumber(p, offset);
+    p = appendText(p, ",\"line\":");
+    p = appendNumber(p, line);
+    p = appendText(p, ",\"column\":");
+    p = appendNumber(p, column);
+    p = appendText(p, ",\"lexeme\":\"");
+    if (whole) {
+        // 常见情形：整条记录直接格式化到缓冲区
+        size_t i = 0;
+        p = appendJsonEscaped(p, lexeme, i, length);
+        p = appendText(p, "\"}\n");
+        out.commit(size_t(p - begin));
+        return;
+    }
+    out.commit(size_t(p - begin));
+    writeJsonEscaped(out, lexeme);
+    out.write("\"}\n");
+}
+
+void TokenExporter::writeCsvToken(TokenType type, size_t offset, size_t length)
+{
+    out.write(escapedPath);
+    out.reserve(MAX_RECORD_OVERHEAD);
+    char* begin = out.cursor();
+    char* p = begin;
+    *p++ = ',';
+    p = appendText(p, kindName(type));
+    *p++ = ',';
+    p = appendNumber(p, offset);
+    *p++ = ',';
+    p = appendNumber(p, line);
+    *p++ = ',';
+    p = appendNumber(p, column);
+    *p++ = ',';
+    out.commit(size_t(p - begin));
+
+    writeCsvField(out, source.substr(offset, length));
+    out.put('\n');
+}
+
+void TokenExporter::writeBinaryToken(TokenType type, size_t offset, size_t length)
+{
+    out.reserve(MAX_RECORD_OVERHEAD);
+    char* begin = out.cursor();
+    char* p = begin;
+    *p++ = char(type);
+    p = appendVarint(p, offset - previousEnd);
+    p = appendVarint(p, line - previousLine);
+    p = appendVarint(p, column);
+    p = appendVarint(p, length);
+    out.commit(size_t(p - begin));
+    out.write(source.data() + offset, length);
+
+    previousEnd = offset + length;
+    previousLine = line;
+}
@@ -0,0 +1,128 @@
+#ifndef TOKENEXPORT_H
+#define TOKENEXPORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include "tokenstream.h"
+
+// 单词导出格式
+enum class ExportFormat {
+    JsonLines,  // 每行一个 JSON 对象
+    Csv,        // RFC 4180，首行为列名
+    Binary      // 紧凑的变长整数编码，格式见 TokenExporter
+};
+
+// 按名称（jsonl、csv、binary）解析导出格式，不认识时返回 false
+bool parseExportFormat(std::string_view name, ExportFormat& format);
+const char* exportFormatName(ExportFormat format);
+
+// 带大缓冲区的顺序输出：数据先写入缓冲区，攒满后一次 fwrite。
+// 传入 lock 时每次写出都持有它，多个线程可各用一个 BufferedWriter 写同一个文件，
+// 每次写出的内容是连续的一整块。beginRecord() 和 endRecord() 之间的记录超过缓冲区容量、
+// 需要分段写出时，从第一段起一直持有 lock 到记录写完，其他线程的块不会插入记录中间
+class BufferedWriter {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1024 * 1024;
+
+    explicit BufferedWriter(std::FILE* file, std::mutex* lock = nullptr, size_t capacity = DEFAULT_CAPACITY);
+    ~BufferedWriter();
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    // 保证缓冲区中至少还有 bytes 个字节的空位，不够时先写出已有内容。
+    // bytes 超过容量时只写出已有内容，返回 false，调用方应改用 write()
+    bool reserve(size_t bytes);
+    // 可直接写入的位置，写完后调用 commit()
+    char* cursor() { return buffer.get() + used; }
+    void commit(size_t bytes) { used += bytes; }
+
+    void write(const char* data, size_t length);
+    void write(std::string_view text) { write(text.data(), text.size()); }
+    void put(char c);
+
+    // 写出缓冲区中的内容。任何一次写出失败后返回 false，之后的写入都被丢弃
+    bool flush();
+
+    // 一条不可拆开的记录的开始和结束，不能嵌套。endRecord() 时若记录已经开始分段写出，
+    // 先写出剩余部分再释放 lock
+    void beginRecord() { inRecord = true; }
+    void endRecord();
+
+    size_t buffered() const { return used; }
+    size_t capacity() const { return size; }
+    uint64_t bytesWritten() const { return written; }
+    bool ok() const { return !failed; }
+
+private:
+    std::FILE* file;
+    std::mutex* lock;
+    std::unique_ptr<char[]> buffer;
+    size_t size;
+    size_t used = 0;
+    uint64_t written = 0;
+    bool failed = false;
+    bool inRecord = false;
+    std::unique_lock<std::mutex> held;  // 分段写出当前记录期间持有的 lock
+
+    void writeOut(const char* data, size_t length);
+};
+
+// 单词导出：每个单词输出类型、偏移（字节）、行号（从1开始）、列号（从0开始，以码点计）和词素。
+// exportSource() 边扫描边写出，不保存单词序列，也不为单词分配字符串。
+//
+// 每个源文件的单词之前有一条文件记录；同一文件的输出跨越缓冲区边界时，
+// 新的一块开头会重复这条记录，因此多个线程共享输出文件时各块仍可独立解析。
+// 超过缓冲区容量的记录分段写出时一直持有共享输出的锁，与前一块连续：
+//   JSON Lines：{"file":"a.rs"} 之后是 {"kind":"KEYWORD","offset":0,"line":1,"column":0,"lexeme":"fn"}
+//   CSV：      首行 file,kind,offset,line,column,lexeme，每行都带文件路径，没有单独的文件记录
+//   二进制：   文件开头为 "RLXE" 和1字节版本号；文件记录为 0xFE、路径长度、路径；
+//              单词记录为1字节类型（TokenType）、与上一个单词末尾的偏移差、与上一个单词的行号差、
+//              列号、长度（均为 LEB128 变长整数），再跟词素字节。文件记录之后差值从0和第1行重新开始
+class TokenExporter {
+public:
+    // TokenType 的编号变化时递增
+    static constexpr uint8_t BINARY_VERSION = 2;
+
+    TokenExporter(BufferedWriter& out, ExportFormat format);
+
+    // 写出整个输出的开头（CSV 的列名、二进制的文件头），整个输出只调用一次
+    void writeHeader();
+
+    // 分析 source 并写出 types 中的单词，返回写出的单词数。其余类型只扫描不写出
+    size_t exportSource(std::string_view path, std::string_view source, TokenTypeMask types = ALL_TOKEN_TYPES);
+    // 写出已有的分析结果中 types 的单词，返回写出的单词数
+    size_t exportTokens(std::string_view path, std::string_view source, const TokenStream& tokens,
+                        TokenTypeMask types = ALL_TOKEN_TYPES);
+
+private:
+    BufferedWriter& out;
+    ExportFormat format;
+
+    // 当前文件：预先转义好的路径、行列号游标和二进制差值的基准
+    std::string_view path;
+    std::string escapedPath;
+    std::string_view source;
+    size_t scanned = 0;         // 已统计换行的位置
+    size_t line = 1;
+    size_t lineStart = 0;
+    size_t counted = 0;         // 本行已数过码点的位置
+    size_t column = 0;          // counted 处的列号
+    size_t previousEnd = 0;
+    size_t previousLine = 1;
+
+    void beginFile(std::string_view path, std::string_view source);
+    void writeFileRecord();
+    void writeToken(TokenType type, size_t offset, size_t length);
+
+    void writeJsonToken(TokenType type, size_t offset, size_t length);
+    void writeCsvToken(TokenType type, size_t offset, size_t length);
+    void writeBinaryToken(TokenType type, size_t offset, size_t length);
+};
+
+#endif // TOKENEXPORT_H
@@ -0,0 +1,675 @@
+#include "tokenindex.h"
+#include "rustlexer.h"
+#include "threadpool.h"
+#include "tokencache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <system_error>
+#include <thread>
+#include <unordered_set>
+
+namespace fs = std::filesystem;
+
+static_assert(sizeof(TokenIndexHeader) == 72 && sizeof(TokenIndexFile) == 40 && sizeof(TokenIndexTerm) == 40,
+              "索引文件的记录大小必须是8的倍数，保证各节按8字节对齐");
+
+namespace {
+
+constexpr uint32_t DEAD_FILE = UINT32_MAX;
+
+// 建立索引的单词类型，分析时其余类型直接跳过
+constexpr TokenTypeMask INDEXED_TYPES = tokenTypeBit(TokenType::IDENTIFIER) | tokenTypeBit(TokenType::INTEGER_LITERAL)
+                                        | tokenTypeBit(TokenType::FLOAT_LITERAL)
+                                        | tokenTypeBit(TokenType::STRING_LITERAL)
+                                        | tokenTypeBit(TokenType::CHAR_LITERAL) | tokenTypeBit(TokenType::MACRO_CALL)
+                                        | tokenTypeBit(TokenType::LIFETIME);
+
+inline void appendVarint(std::vector<uint8_t>& out, uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back(uint8_t(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(uint8_t(value));
+}
+
+inline bool readVarint(const uint8_t*& p, const uint8_t* end, uint64_t& value)
+{
+    value = 0;
+    for (unsigned shift = 0; p < end && shift < 64; shift += 7) {
+        uint8_t byte = *p++;
+        value |= uint64_t(byte & 0x7F) << shift;
+        if (byte < 0x80) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 跳过 count 个变长整数
+inline bool skipVarints(const uint8_t*& p, const uint8_t* end, uint64_t count)
+{
+    for (; count > 0; count--) {
+        while (p < end && *p >= 0x80) {
+            p++;
+        }
+        if (p == end) {
+            return false;
+        }
+        p++;
+    }
+    return true;
+}
+
+// 倒排表中的一段：文件编号和该文件的 n 个偏移（变长编码的原始字节，重新编号时原样复制）
+struct Block {
+    uint32_t file;
+    uint32_t count;
+    const uint8_t* begin;
+    const uint8_t* end;
+};
+
+// 逐段解析倒排表。deltaFiles 为 true 时文件编号是与上一段的差值（索引文件），否则是绝对值（内存中）
+bool parseBlocks(const uint8_t* p, const uint8_t* end, bool deltaFiles, std::vector<Block>& blocks)
+{
+    uint64_t file = 0;
+    while (p < end) {
+        uint64_t value;
+        uint64_t count;
+        if (!readVarint(p, end, value) || !readVarint(p, end, count) || count == 0) {
+            return false;
+        }
+        file = deltaFiles ? file + value : value;
+        const uint8_t* begin = p;
+        if (file >= DEAD_FILE || !skipVarints(p, end, count)) {
+            return false;
+        }
+        blocks.push_back({uint32_t(file), uint32_t(count), begin, p});
+    }
+    return true;
+}
+
+} // namespace
+
+bool isIndexedKind(TokenType type)
+{
+    return (INDEXED_TYPES & tokenTypeBit(type)) != 0;
+}
+
+// ---- TokenIndex ----
+
+bool TokenIndex::open(const std::string& path)
+{
+    close();
+    if (!mapped.open(path)) {
+        error = mapped.errorString();
+        return false;
+    }
+
+    const uint64_t size = mapped.size();
+    if (size < sizeof(TokenIndexHeader)) {
+        error = "不是索引文件：" + path;
+        mapped.close();
+        return false;
+    }
+    std::memcpy(&header, mapped.data(), sizeof(header));
+    if (header.magic != TOKEN_INDEX_MAGIC) {
+        error = "不是索引文件：" + path;
+        mapped.close();
+        return false;
+    }
+    if (header.version != TOKEN_INDEX_VERSION) {
+        error = "索引文件的版本不符，需要重新建立：" + path;
+        mapped.close();
+        return false;
+    }
+
+    // 各节依次排列、按8字节对齐且不越过文件末尾；倒排表的内容在取出时才检查
+    bool valid = header.filesOffset == sizeof(TokenIndexHeader)
+        && header.fileCount <= (size - header.filesOffset) / sizeof(TokenIndexFile)
+        && header.termsOffset == header.filesOffset + uint64_t(header.fileCount) * sizeof(TokenIndexFile)
+        && header.termCount <= (size - header.termsOffset) / sizeof(TokenIndexTerm)
+        && header.stringsOffset == header.termsOffset + header.termCount * sizeof(TokenIndexTerm)
+        && header.postingsOffset >= header.stringsOffset && header.postingsOffset <= size
+        && header.postingsSize == size - header.postingsOffset;
+    if (!valid) {
+        error = "索引文件已损坏：" + path;
+        mapped.close();
+        return false;
+    }
+
+    const char* base = mapped.data();
+    files = reinterpret_cast<const TokenIndexFile*>(base + header.filesOffset);
+    terms = reinterpret_cast<const TokenIndexTerm*>(base + header.termsOffset);
+    strings = base + header.stringsOffset;
+    stringsSize = size_t(header.postingsOffset - header.stringsOffset);
+    postingData = reinterpret_cast<const uint8_t*>(base + header.postingsOffset);
+    error.clear();
+    return true;
+}
+
+void TokenIndex::close()
+{
+    mapped.close();
+    header = TokenIndexHeader{};
+    files = nullptr;
+    terms = nullptr;
+    strings = nullptr;
+    stringsSize = 0;
+    postingData = nullptr;
+}
+
+std::string_view TokenIndex::filePath(uint32_t id) const
+{
+    const TokenIndexFile& record = files[id];
+    if (record.pathOffset > stringsSize || record.pathLength > stringsSize - record.pathOffset) {
+        return std::string_view();
+    }
+    return std::string_view(strings + record.pathOffset, record.pathLength);
+}
+
+std::string_view TokenIndex::lexeme(const TokenIndexTerm& term) const
+{
+    if (term.lexemeOffset > stringsSize || term.lexemeLength > stringsSize - term.lexemeOffset) {
+        return std::string_view();
+    }
+    return std::string_view(strings + term.lexemeOffset, term.lexemeLength);
+}
+
+TokenIndex::TermRange TokenIndex::find(std::string_view text) const
+{
+    // 同一词素的各类型词条相邻，至多几个，找到第一个后顺序向后
+    const TokenIndexTerm* first = std::lower_bound(termsBegin(), termsEnd(), text,
+                                                   [this](const TokenIndexTerm& term, std::string_view value) {
+                                                       return lexeme(term) < value;
+                                                   });
+    const TokenIndexTerm* last = first;
+    while (last != termsEnd() && lexeme(*last) == text) {
+        ++last;
+    }
+    return TermRange{first, last};
+}
+
+const TokenIndexTerm* TokenIndex::find(TokenType type, std::string_view text) const
+{
+    for (const TokenIndexTerm& term : find(text)) {
+        if (term.kind == uint8_t(type)) {
+            return &term;
+        }
+    }
+    return nullptr;
+}
+
+bool TokenIndex::postingRange(const TokenIndexTerm& term, const uint8_t*& begin, const uint8_t*& end) const
+{
+    if (term.postingsOffset > header.postingsSize || term.postingsSize > header.postingsSize - term.postingsOffset) {
+        return false;
+    }
+    begin = postingData + term.postingsOffset;
+    end = begin + term.postingsSize;
+    return true;
+}
+
+bool TokenIndex::postings(const TokenIndexTerm& term, std::vector<Posting>& out) const
+{
+    const uint8_t* p;
+    const uint8_t* end;
+    if (!postingRange(term, p, end)) {
+        return false;
+    }
+    // 每次出现至少占1字节，按此上限预留
+    out.reserve(out.size() + size_t(std::min<uint64_t>(term.occurrences, term.postingsSize)));
+    uint64_t file = 0;
+    while (p < end) {
+        uint64_t delta;
+        uint64_t count;
+        if (!readVarint(p, end, delta) || !readVarint(p, end, count)) {
+            return false;
+        }
+        file += delta;
+        if (file >= header.fileCount) {
+            return false;
+        }
+        uint64_t offset = 0;
+        for (; count > 0; count--) {
+            uint64_t value;
+            if (!readVarint(p, end, value)) {
+                return false;
+            }
+            offset += value;
+            out.push_back({uint32_t(file), uint32_t(offset)});
+        }
+    }
+    return true;
+}
+
+// ---- TokenIndexBuilder ----
+
+TokenIndexBuilder::TokenIndexBuilder()
+    : shards(new Shard[SHARD_COUNT])
+{
+}
+
+TokenIndexBuilder::TokenIndexBuilder(const TokenIndex& index)
+    : TokenIndexBuilder()
+{
+    files.reserve(index.fileCount());
+    for (uint32_t id = 0; id < index.fileCount(); id++) {
+        const TokenIndexFile& record = index.file(id);
+        FileEntry entry;
+        entry.path.assign(index.filePath(id));
+        entry.contentHash = record.contentHash;
+        entry.size = record.size;
+        entry.modified = record.modified;
+        fileIds[entry.path] = id;
+        files.push_back(std::move(entry));
+    }
+
+    // 词素编号连续，各分片的词条数相近，预留后复制时不必反复扩容
+    size_t perShard = index.termCount() / SHARD_COUNT + index.termCount() / SHARD_COUNT / 8 + 16;
+    for (size_t s = 0; s < SHARD_COUNT; s++) {
+        shards[s].terms.reserve(perShard);
+    }
+
+    // 文件编号不变，倒排表只把编号差还原为绝对编号，偏移部分原样复制。格式不对的词条丢弃
+    std::vector<Block> blocks;
+    for (const TokenIndexTerm* term = index.termsBegin(); term != index.termsEnd(); ++term) {
+        const uint8_t* begin;
+        const uint8_t* end;
+        std::string_view text = index.lexeme(*term);
+        blocks.clear();
+        if (text.empty() || !index.postingRange(*term, begin, end) || !parseBlocks(begin, end, true, blocks)
+            || (!blocks.empty() && blocks.back().file >= files.size())) {
+            continue;
+        }
+        uint32_t symbol = symbols.intern(text, term->occurrences);
+        Term& target = termFor(shards[symbol % SHARD_COUNT], symbol, TokenType(term->kind));
+        target.postings.reserve(target.postings.size() + term->postingsSize + blocks.size() * 4);
+        for (const Block& block : blocks) {
+            appendVarint(target.postings, block.file);
+            appendVarint(target.postings, block.count);
+            target.postings.insert(target.postings.end(), block.begin, block.end);
+        }
+    }
+}
+
+TokenIndexBuilder::~TokenIndexBuilder() = default;
+
+TokenIndexBuilder::Term& TokenIndexBuilder::termFor(Shard& shard, uint32_t symbol, TokenType kind)
+{
+    size_t slot = symbol / SHARD_COUNT;
+    if (slot >= shard.firstTerm.size()) {
+        shard.firstTerm.resize(std::max(slot + 1, shard.firstTerm.size() * 2), NO_TERM);
+    }
+    // 同一词素至多有几个类型，顺着链表找
+    for (uint32_t id = shard.firstTerm[slot]; id != NO_TERM; id = shard.terms[id].next) {
+        if (shard.terms[id].kind == kind) {
+            return shard.terms[id];
+        }
+    }
+    shard.terms.push_back(Term{symbol, kind, shard.firstTerm[slot], {}});
+    shard.firstTerm[slot] = uint32_t(shard.terms.size() - 1);
+    return shard.terms.back();
+}
+
+uint32_t TokenIndexBuilder::registerFile(std::string_view path, uint64_t hash, uint64_t size, int64_t modified)
+{
+    std::lock_guard<std::mutex> guard(filesMutex);
+    uint32_t id = uint32_t(files.size());
+    auto inserted = fileIds.emplace(std::string(path), id);
+    if (!inserted.second) {
+        // 旧编号的记录留在倒排表中，save() 时剔除
+        files[inserted.first->second].live = false;
+        inserted.first->second = id;
+    }
+    FileEntry entry;
+    entry.path.assign(path);
+    entry.contentHash = hash;
+    entry.size = size;
+    entry.modified = modified;
+    files.push_back(std::move(entry));
+    return id;
+}
+
+void TokenIndexBuilder::addFile(std::string_view path, std::string_view source, int64_t modified)
+{
+    indexFile(path, source, contentHash(source), modified);
+}
+
+void TokenIndexBuilder::indexFile(std::string_view path, std::string_view source, uint64_t hash, int64_t modified)
+{
+    // 分析和驻留不加锁：每次出现记为（分片，词素编号，类型）和偏移，排序后同一词条的出现相邻，
+    // 同一分片的词条也相邻，每个分片只加一次锁
+    thread_local std::vector<std::pair<uint64_t, uint32_t>> occurrences;
+    occurrences.clear();
+
+    std::unique_ptr<SymbolCache> cache;
+    {
+        std::lock_guard<std::mutex> guard(cachesMutex);
+        if (!idleCaches.empty()) {
+            cache = std::move(idleCaches.back());
+            idleCaches.pop_back();
+        }
+    }
+    if (!cache) {
+        cache = std::make_unique<SymbolCache>(symbols);
+    }
+    {
+        // 关键字、运算符、分隔符和注释只确定单词边界，不保存单词序列
+        RustLexer lexer(source.data(), source.size());
+        Token token;
+        while (lexer.nextToken(token, INDEXED_TYPES)) {
+            uint32_t symbol = cache->intern(lexer.lexeme(token));
+            uint64_t key = uint64_t(symbol % SHARD_COUNT) << 40 | uint64_t(symbol) << 8 | uint8_t(token.type);
+            occurrences.emplace_back(key, uint32_t(token.offset));
+        }
+    }
+    {
+        std::lock_guard<std::mutex> guard(cachesMutex);
+        idleCaches.push_back(std::move(cache));
+    }
+    std::sort(occurrences.begin(), occurrences.end());
+
+    uint32_t id = registerFile(path, hash, source.size(), modified);
+    size_t i = 0;
+    while (i < occurrences.size()) {
+        Shard& shard = shards[occurrences[i].first >> 40];
+        std::lock_guard<std::mutex> guard(shard.mutex);
+        const uint64_t shardBits = occurrences[i].first >> 40;
+        while (i < occurrences.size() && occurrences[i].first >> 40 == shardBits) {
+            const uint64_t key = occurrences[i].first;
+            size_t end = i;
+            while (end < occurrences.size() && occurrences[end].first == key) {
+                end++;
+            }
+            Term& term = termFor(shard, uint32_t(key >> 8), TokenType(key & 0xFF));
+            appendVarint(term.postings, id);
+            appendVarint(term.postings, end - i);
+            uint32_t previous = 0;
+            for (; i < end; i++) {
+                appendVarint(term.postings, occurrences[i].second - previous);
+                previous = occurrences[i].second;
+            }
+        }
+    }
+}
+
+bool TokenIndexBuilder::removeFile(std::string_view path)
+{
+    std::lock_guard<std::mutex> guard(filesMutex);
+    auto it = fileIds.find(std::string(path));
+    if (it == fileIds.end()) {
+        return false;
+    }
+    files[it->second].live = false;
+    fileIds.erase(it);
+    return true;
+}
+
+TokenIndexUpdate TokenIndexBuilder::update(const std::vector<std::string>& paths, ThreadPool& pool)
+{
+    TokenIndexUpdate result;
+    // 重复给出的路径只处理一次：同一路径不能在两个线程中同时加入
+    std::vector<const std::string*> unique;
+    std::unordered_set<std::string_view> wanted;
+    for (const std::string& path : paths) {
+        if (wanted.insert(path).second) {
+            unique.push_back(&path);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> guard(filesMutex);
+        for (auto it = fileIds.begin(); it != fileIds.end();) {
+            if (wanted.count(it->first) == 0) {
+                files[it->second].live = false;
+                it = fileIds.erase(it);
+                result.removed++;
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    std::atomic<size_t> unchanged{0};
+    std::atomic<size_t> added{0};
+    std::atomic<size_t> updated{0};
+    std::atomic<size_t> touched{0};
+    std::atomic<size_t> removed{0};
+    std::atomic<uint64_t> bytesLexed{0};
+    std::mutex errorsMutex;
+    pool.parallelFor(unique.size(), [&](size_t index) {
+        const std::string& path = *unique[index];
+        auto fail = [&](std::string message) {
+            std::lock_guard<std::mutex> guard(errorsMutex);
+            result.errors.push_back(std::move(message));
+        };
+
+        bool known = false;
+        FileEntry previous;
+        {
+            std::lock_guard<std::mutex> guard(filesMutex);
+            auto it = fileIds.find(path);
+            if (it != fileIds.end()) {
+                known = true;
+                previous = files[it->second];
+            }
+        }
+
+        std::error_code ec;
+        fs::path file = fs::u8path(path);
+        uintmax_t size = fs::file_size(file, ec);
+        fs::file_time_type time = ec ? fs::file_time_type() : fs::last_write_time(file, ec);
+        if (ec == std::errc::no_such_file_or_directory && known) {
+            // 索引中的文件已被删除
+            removeFile(path);
+            removed++;
+            return;
+        }
+        if (ec) {
+            fail(path + ": " + ec.message());
+            return;
+        }
+        int64_t modified = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+        if (known && previous.size == size && previous.modified == modified) {
+            unchanged++;
+            return;
+        }
+
+        MappedFile mapped;
+        if (!mapped.open(path)) {
+            fail(mapped.errorString());
+            return;
+        }
+        if (mapped.size() > TokenStream::MAX_SOURCE_SIZE) {
+            fail(path + ": 文件超过 4 GiB，不建立索引");
+            return;
+        }
+        uint64_t hash = contentHash(mapped.view());
+        if (known && previous.contentHash == hash && previous.size == mapped.size()) {
+            std::lock_guard<std::mutex> guard(filesMutex);
+            auto it = fileIds.find(path);
+            if (it != fileIds.end()) {
+                files[it->second].modified = modified;
+            }
+            touched++;
+            return;
+        }
+
+        indexFile(path, mapped.view(), hash, modified);
+        (known ? updated : added)++;
+        bytesLexed += mapped.size();
+    });
+
+    result.unchanged = unchanged;
+    result.added = added;
+    result.updated = updated;
+    result.touched = touched;
+    result.removed += removed;
+    result.failed = result.errors.size();
+    result.bytesLexed = bytesLexed;
+    return result;
+}
+
+size_t TokenIndexBuilder::fileCount() const
+{
+    std::lock_guard<std::mutex> guard(filesMutex);
+    return fileIds.size();
+}
+
+std::vector<std::string> TokenIndexBuilder::filePaths() const
+{
+    std::lock_guard<std::mutex> guard(filesMutex);
+    std::vector<std::string> paths;
+    paths.reserve(fileIds.size());
+    for (const FileEntry& entry : files) {
+        if (entry.live) {
+            paths.push_back(entry.path);
+        }
+    }
+    return paths;
+}
+
+bool TokenIndexBuilder::save(const std::string& path) const
+{
+    std::lock_guard<std::mutex> guard(filesMutex);
+
+    // 有效的文件按原顺序重新编号；路径放在字符串节开头
+    std::vector<uint32_t> remap(files.size(), DEAD_FILE);
+    std::vector<TokenIndexFile> fileRecords;
+    std::string strings;
+    for (size_t id = 0; id < files.size(); id++) {
+        const FileEntry& entry = files[id];
+        if (!entry.live) {
+            continue;
+        }
+        remap[id] = uint32_t(fileRecords.size());
+        TokenIndexFile record{};
+        record.contentHash = entry.contentHash;
+        record.size = entry.size;
+        record.modified = entry.modified;
+        record.pathOffset = strings.size();
+        record.pathLength = uint32_t(entry.path.size());
+        fileRecords.push_back(record);
+        strings += entry.path;
+    }
+
+    // 词条按（词素，类型）排序
+    struct SortedTerm {
+        std::string_view lexeme;
+        const Term* term;
+    };
+    std::vector<SortedTerm> sorted;
+    for (size_t s = 0; s < SHARD_COUNT; s++) {
+        for (const Term& term : shards[s].terms) {
+            sorted.push_back({symbols.name(term.symbol), &term});
+        }
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const SortedTerm& a, const SortedTerm& b) {
+        int order = a.lexeme.compare(b.lexeme);
+        return order != 0 ? order < 0 : a.term->kind < b.term->kind;
+    });
+
+    // 剔除失效文件的段，其余按新编号排序后改为编号差；只剩失效记录的词条不写出
+    std::vector<TokenIndexTerm> termRecords;
+    termRecords.reserve(sorted.size());
+    std::vector<uint8_t> postings;
+    std::vector<Block> blocks;
+    uint64_t postingCount = 0;
+    std::string_view previousLexeme;
+    uint64_t previousLexemeOffset = 0;
+    for (const SortedTerm& entry : sorted) {
+        const std::vector<uint8_t>& data = entry.term->postings;
+        blocks.clear();
+        parseBlocks(data.data(), data.data() + data.size(), false, blocks);
+        size_t kept = 0;
+        for (const Block& block : blocks) {
+            if (remap[block.file] != DEAD_FILE) {
+                blocks[kept] = block;
+                blocks[kept].file = remap[block.file];
+                kept++;
+            }
+        }
+        blocks.resize(kept);
+        if (blocks.empty()) {
+            continue;
+        }
+        if (!std::is_sorted(blocks.begin(), blocks.end(),
+                            [](const Block& a, const Block& b) { return a.file < b.file; })) {
+            std::sort(blocks.begin(), blocks.end(), [](const Block& a, const Block& b) { return a.file < b.file; });
+        }
+
+        TokenIndexTerm record{};
+        record.kind = uint8_t(entry.term->kind);
+        record.postingsOffset = postings.size();
+        record.fileCount = uint32_t(blocks.size());
+        uint32_t previousFile = 0;
+        for (const Block& block : blocks) {
+            appendVarint(postings, block.file - previousFile);
+            appendVarint(postings, block.count);
+            postings.insert(postings.end(), block.begin, block.end);
+            previousFile = block.file;
+            record.occurrences += block.count;
+        }
+        record.postingsSize = uint32_t(postings.size() - record.postingsOffset);
+        postingCount += record.occurrences;
+
+        // 同一词素的不同类型共用一份文本
+        if (termRecords.empty() || entry.lexeme != previousLexeme) {
+            previousLexemeOffset = strings.size();
+            previousLexeme = entry.lexeme;
+            strings += entry.lexeme;
+        }
+        record.lexemeOffset = previousLexemeOffset;
+        record.lexemeLength = uint32_t(entry.lexeme.size());
+        termRecords.push_back(record);
+    }
+
+    TokenIndexHeader header{};
+    header.magic = TOKEN_INDEX_MAGIC;
+    header.version = TOKEN_INDEX_VERSION;
+    header.fileCount = uint32_t(fileRecords.size());
+    header.termCount = termRecords.size();
+    header.postingCount = postingCount;
+    header.filesOffset = sizeof(TokenIndexHeader);
+    header.termsOffset = header.filesOffset + fileRecords.size() * sizeof(TokenIndexFile);
+    header.stringsOffset = header.termsOffset + termRecords.size() * sizeof(TokenIndexTerm);
+    header.postingsOffset = header.stringsOffset + strings.size();
+    header.postingsSize = postings.size();
+
+    // 与单词缓存相同，临时文件名包含线程标识和时间
+    std::string temporary = path + ".tmp"
+        + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()))
+        + "-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+    std::error_code ec;
+    {
+        std::ofstream out(fs::u8path(temporary), std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(fileRecords.data()),
+                  std::streamsize(fileRecords.size() * sizeof(TokenIndexFile)));
+        out.write(reinterpret_cast<const char*>(termRecords.data()),
+                  std::streamsize(termRecords.size() * sizeof(TokenIndexTerm)));
+        out.write(strings.data(), std::streamsize(strings.size()));
+        out.write(reinterpret_cast<const char*>(postings.data()), std::streamsize(postings.size()));
+        out.close();
+        if (!out) {
+            fs::remove(fs::u8path(temporary), ec);
+            return false;
+        }
+    }
+
+    fs::rename(fs::u8path(temporary), fs::u8path(path), ec);
+    if (ec) {
+        fs::remove(fs::u8path(temporary), ec);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,220 @@
+#ifndef TOKENINDEX_H
+#define TOKENINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "mappedfile.h"
+#include "symboltable.h"
+#include "token.h"
+
+class ThreadPool;
+
+// 跨文件的单词倒排索引：每个不同的（类型，词素）对应一张倒排表，记录它在哪些文件的哪些偏移出现。
+// 只为标识符、宏名、生命周期和各类字面量建立索引；关键字、运算符和分隔符出现得太多而几乎不会被检索，
+// 注释不是单个词素，都不建立索引
+bool isIndexedKind(TokenType type);
+
+// 索引文件格式（整数均为本机字节序）：
+//   TokenIndexHeader
+//   TokenIndexFile  files[fileCount]
+//   TokenIndexTerm  terms[termCount]     按（词素字节序，类型）升序，可二分查找
+//   char            strings[]            路径和词素，不以0结尾
+//   uint8_t         postings[]
+// 每个词条的倒排表按文件编号升序，每个文件一段：与上一段的文件编号差、出现次数 n、
+// 第一个偏移、其后 n-1 个偏移差，均为 LEB128 变长整数。映射后直接查询，打开时不解码
+struct TokenIndexHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t fileCount;
+    uint32_t reserved;
+    uint64_t termCount;
+    uint64_t postingCount;      // 全部出现次数
+    uint64_t filesOffset;       // 各节相对文件开头的偏移
+    uint64_t termsOffset;
+    uint64_t stringsOffset;
+    uint64_t postingsOffset;
+    uint64_t postingsSize;
+};
+
+struct TokenIndexFile {
+    uint64_t contentHash;       // 源码的 contentHash()
+    uint64_t size;
+    int64_t modified;           // 建立索引时文件的修改时间，只用于判断文件是否变化
+    uint64_t pathOffset;        // 相对 strings 节
+    uint32_t pathLength;
+    uint32_t reserved;
+};
+
+struct TokenIndexTerm {
+    uint64_t lexemeOffset;      // 相对 strings 节
+    uint64_t postingsOffset;    // 相对 postings 节
+    uint64_t occurrences;
+    uint32_t lexemeLength;
+    uint32_t postingsSize;
+    uint32_t fileCount;
+    uint8_t kind;               // TokenType
+    uint8_t reserved[3];
+};
+
+constexpr uint32_t TOKEN_INDEX_MAGIC = 0x58494c52;  // 小端序下为 "RLIX"
+// 文件格式、词法规则或 TokenType 的编号变化时必须递增
+constexpr uint32_t TOKEN_INDEX_VERSION = 3;
+
+// 一次出现：文件编号和词素在该文件中的字节偏移
+struct Posting {
+    uint32_t file;
+    uint32_t offset;
+};
+
+// 只读的索引文件。整个文件被映射，查找是在词条数组上二分，倒排表在取出时才解码
+class TokenIndex {
+public:
+    // 同一词素的各个类型的词条，按类型升序
+    struct TermRange {
+        const TokenIndexTerm* first = nullptr;
+        const TokenIndexTerm* last = nullptr;
+
+        const TokenIndexTerm* begin() const { return first; }
+        const TokenIndexTerm* end() const { return last; }
+        bool empty() const { return first == last; }
+    };
+
+    TokenIndex() = default;
+
+    // 映射并检查文件头，失败时返回 false，原因见 errorString()
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return mapped.isOpen(); }
+    const std::string& errorString() const { return error; }
+
+    size_t fileCount() const { return header.fileCount; }
+    size_t termCount() const { return size_t(header.termCount); }
+    uint64_t postingCount() const { return header.postingCount; }
+    size_t byteSize() const { return mapped.size(); }
+
+    const TokenIndexFile& file(uint32_t id) const { return files[id]; }
+    std::string_view filePath(uint32_t id) const;
+
+    const TokenIndexTerm* termsBegin() const { return terms; }
+    const TokenIndexTerm* termsEnd() const { return terms + header.termCount; }
+    std::string_view lexeme(const TokenIndexTerm& term) const;
+
+    TermRange find(std::string_view lexeme) const;
+    const TokenIndexTerm* find(TokenType type, std::string_view lexeme) const;
+
+    // 解码词条的倒排表并追加到 out（按文件编号、偏移升序）。倒排表越界或格式不对时返回 false
+    bool postings(const TokenIndexTerm& term, std::vector<Posting>& out) const;
+
+private:
+    friend class TokenIndexBuilder;
+
+    MappedFile mapped;
+    TokenIndexHeader header{};
+    const TokenIndexFile* files = nullptr;
+    const TokenIndexTerm* terms = nullptr;
+    const char* strings = nullptr;
+    size_t stringsSize = 0;
+    const uint8_t* postingData = nullptr;
+    std::string error;
+
+    // 词条的倒排表在映射中的范围，越界时返回 false
+    bool postingRange(const TokenIndexTerm& term, const uint8_t*& begin, const uint8_t*& end) const;
+};
+
+// 一次 update() 的结果
+struct TokenIndexUpdate {
+    size_t unchanged = 0;       // 大小和修改时间未变，未读取
+    size_t added = 0;
+    size_t updated = 0;         // 内容变化，重新分析
+    size_t touched = 0;         // 修改时间变了但内容未变，只更新记录
+    size_t removed = 0;
+    size_t failed = 0;
+    uint64_t bytesLexed = 0;
+    std::vector<std::string> errors;
+};
+
+// 可修改的索引，在内存中建立和增量更新，save() 写出索引文件。
+//
+// 每个文件有一个编号；文件被重新分析或删除时只把旧编号标记为失效，新内容以新编号追加到各倒排表末尾，
+// 不改动其他文件的记录，因此一次更新的代价只与变化的文件有关。失效的记录在 save() 时剔除，
+// 写出的文件中编号重新连续。词素驻留在一张 SymbolTable 中，倒排表按词素编号分片加锁，
+// addFile()、removeFile() 和 update() 可以在多个线程中同时调用（同一路径除外）
+class TokenIndexBuilder {
+public:
+    TokenIndexBuilder();
+    // 从已有的索引文件开始增量更新：复制全部文件记录和倒排表，不重新分析源码。
+    // 复制完成后 index 可以关闭，save() 可以覆盖它的文件
+    explicit TokenIndexBuilder(const TokenIndex& index);
+    ~TokenIndexBuilder();
+
+    TokenIndexBuilder(const TokenIndexBuilder&) = delete;
+    TokenIndexBuilder& operator=(const TokenIndexBuilder&) = delete;
+
+    // 分析 source 并加入索引；路径已在索引中时替换旧内容
+    void addFile(std::string_view path, std::string_view source, int64_t modified = 0);
+    // 从索引中删除文件，不在索引中时返回 false
+    bool removeFile(std::string_view path);
+
+    // 使索引恰好包含 paths 中的文件：大小和修改时间都未变的文件不读取，
+    // 内容哈希未变的文件不重新分析，不在 paths 中或已不存在的文件从索引删除。文件在线程池上并行读取和分析
+    TokenIndexUpdate update(const std::vector<std::string>& paths, ThreadPool& pool);
+
+    // 写出索引文件：先写临时文件再改名。失效的记录不写出。不能与修改同时进行
+    bool save(const std::string& path) const;
+
+    size_t fileCount() const;       // 有效的文件数
+    std::vector<std::string> filePaths() const;
+
+private:
+    struct FileEntry {
+        std::string path;
+        uint64_t contentHash = 0;
+        uint64_t size = 0;
+        int64_t modified = 0;
+        bool live = true;
+    };
+
+    static constexpr uint32_t NO_TERM = UINT32_MAX;
+
+    // 一个（词素，类型）的倒排表。内存中的每段以绝对的文件编号开头，
+    // 并发追加时各段的先后不一定按编号，save() 时排序并改为差值
+    struct Term {
+        uint32_t symbol;
+        TokenType kind;
+        uint32_t next;                  // 同一词素的下一个类型的词条
+        std::vector<uint8_t> postings;
+    };
+
+    // 词素编号 id 的词条在第 id % SHARD_COUNT 个分片中；编号连续，分片内直接按 id / SHARD_COUNT 下标查找
+    static constexpr size_t SHARD_COUNT = 64;
+
+    struct Shard {
+        std::mutex mutex;
+        std::vector<uint32_t> firstTerm;    // 各词素的第一个词条，NO_TERM 表示没有
+        std::vector<Term> terms;
+    };
+
+    SymbolTable symbols;
+    std::unique_ptr<Shard[]> shards;
+
+    // 驻留缓存跨文件复用：同一个名字在各个文件中反复出现，只在第一次遇到时查共享表。
+    // 析构时先于 symbols 销毁
+    std::mutex cachesMutex;
+    std::vector<std::unique_ptr<SymbolCache>> idleCaches;
+
+    mutable std::mutex filesMutex;
+    std::vector<FileEntry> files;
+    std::unordered_map<std::string, uint32_t> fileIds;      // 路径 -> 最新的编号
+
+    void indexFile(std::string_view path, std::string_view source, uint64_t hash, int64_t modified);
+    uint32_t registerFile(std::string_view path, uint64_t hash, uint64_t size, int64_t modified);
+    Term& termFor(Shard& shard, uint32_t symbol, TokenType kind);
+};
+
+#endif // TOKENINDEX_H
@@ -0,0 +1,68 @@
+#include "tokenstream.h"
+
+#include <algorithm>
+
+void TokenStream::reserve(size_t count)
+{
+    offsets.reserve(count);
+    lengths.reserve(count);
+    kinds.reserve(count);
+}
+
+void TokenStream::reserveKinds(size_t count)
+{
+    kinds.reserve(count);
+}
+
+void TokenStream::clear()
+{
+    offsets.clear();
+    lengths.clear();
+    kinds.clear();
+}
+
+void TokenStream::append(const TokenStream& other, size_t first)
+{
+    offsets.insert(offsets.end(), other.offsets.begin() + first, other.offsets.end());
+    lengths.insert(lengths.end(), other.lengths.begin() + first, other.lengths.end());
+    kinds.insert(kinds.end(), other.kinds.begin() + first, other.kinds.end());
+}
+
+namespace {
+
+// 把 column 中 [first, first + count) 替换为 replacement 的全部元素
+template <typename T>
+void replaceRange(std::pmr::vector<T>& column, size_t first, size_t count, const std::pmr::vector<T>& replacement)
+{
+    size_t common = std::min(count, replacement.size());
+    std::copy(replacement.begin(), replacement.begin() + common, column.begin() + first);
+    if (replacement.size() > count) {
+        column.insert(column.begin() + first + count, replacement.begin() + common, replacement.end());
+    } else {
+        column.erase(column.begin() + first + common, column.begin() + first + count);
+    }
+}
+
+} // namespace
+
+void TokenStream::replace(size_t first, size_t count, const TokenStream& replacement)
+{
+    replaceRange(offsets, first, count, replacement.offsets);
+    replaceRange(lengths, first, count, replacement.lengths);
+    replaceRange(kinds, first, count, replacement.kinds);
+}
+
+void TokenStream::shiftOffsets(size_t first, std::ptrdiff_t delta)
+{
+    // 无符号回绕加法对负的 delta 同样成立
+    const uint32_t shift = static_cast<uint32_t>(delta);
+    for (size_t i = first; i < offsets.size(); i++) {
+        offsets[i] += shift;
+    }
+}
+
+size_t TokenStream::memoryUsage() const
+{
+    return offsets.capacity() * sizeof(uint32_t) + lengths.capacity() * sizeof(uint32_t)
+        + kinds.capacity() * sizeof(uint8_t);
+}
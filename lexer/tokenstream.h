@@ -0,0 +1,171 @@
+#ifndef TOKENSTREAM_H
+#define TOKENSTREAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+#include "token.h"
+
+// 单词种类字节：合并了 TokenType 和 OperatorId。小于 OPERATOR_KIND_BASE 的值是其他类型，
+// 运算符和分隔符存为 OPERATOR_KIND_BASE + 运算符编号，类型由编号查表得到
+namespace TokenKind {
+
+constexpr uint8_t OPERATOR_KIND_BASE = 16;
+static_assert(size_t(TokenType::UNKNOWN) < OPERATOR_KIND_BASE, "TokenType 与运算符编号的种类值重叠");
+static_assert(OPERATOR_KIND_BASE + size_t(OperatorId::Count) <= 256, "种类值超出一个字节");
+
+inline uint8_t encode(TokenType type, OperatorId op)
+{
+    return op == OperatorId::None ? static_cast<uint8_t>(type)
+                                  : static_cast<uint8_t>(OPERATOR_KIND_BASE + static_cast<uint8_t>(op));
+}
+
+inline TokenType type(uint8_t kind)
+{
+    if (kind < OPERATOR_KIND_BASE) {
+        return static_cast<TokenType>(kind);
+    }
+    return isDelimiter(static_cast<OperatorId>(kind - OPERATOR_KIND_BASE)) ? TokenType::DELIMITER
+                                                                            : TokenType::OPERATOR;
+}
+
+inline OperatorId op(uint8_t kind)
+{
+    return kind < OPERATOR_KIND_BASE ? OperatorId::None
+                                     : static_cast<OperatorId>(kind - OPERATOR_KIND_BASE);
+}
+
+} // namespace TokenKind
+
+// 单词序列的只读视图，按列指向偏移、长度和种类数组。
+// 可以指向 TokenStream，也可以直接指向映射到内存的单词缓存文件
+class TokenView {
+public:
+    TokenView() = default;
+    TokenView(const uint32_t* offsets, const uint32_t* lengths, const uint8_t* kinds, size_t count)
+        : offsets(offsets), lengths(lengths), kinds(kinds), count(count)
+    {
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    size_t offset(size_t index) const { return offsets[index]; }
+    size_t length(size_t index) const { return lengths[index]; }
+    size_t end(size_t index) const { return size_t(offsets[index]) + lengths[index]; }
+    TokenType type(size_t index) const { return TokenKind::type(kinds[index]); }
+    OperatorId op(size_t index) const { return TokenKind::op(kinds[index]); }
+
+    Token token(size_t index) const
+    {
+        return {type(index), op(index), offsets[index], lengths[index]};
+    }
+
+    std::string_view text(size_t index, std::string_view source) const
+    {
+        return source.substr(offsets[index], lengths[index]);
+    }
+
+    const uint32_t* offsetData() const { return offsets; }
+    const uint32_t* lengthData() const { return lengths; }
+    const uint8_t* kindData() const { return kinds; }
+
+private:
+    const uint32_t* offsets = nullptr;
+    const uint32_t* lengths = nullptr;
+    const uint8_t* kinds = nullptr;
+    size_t count = 0;
+};
+
+// 紧凑的单词序列：按列分别存放偏移、长度和种类（结构数组），每个单词9字节。
+// 偏移和长度以32位保存，源码不能超过 MAX_SOURCE_SIZE。
+// 各列从构造时给定的 memory_resource 分配（默认为全局堆），可以放在 TokenArena 中整体释放；
+// 复制构造的序列使用默认的 memory_resource。
+// 不记录词素时（LexOptions::lexemes 为 false）只有种类列，这样的序列只能读取 type() 和 op()，
+// 也不能与完整的序列拼接或替换
+class TokenStream {
+public:
+    static constexpr size_t MAX_SOURCE_SIZE = UINT32_MAX;
+
+    // 按源码大小预留容量时假定的平均每个单词字节数（含空白）。
+    // 实际代码约为5~8字节，取偏小的值使绝大多数文件分析中途不必扩容；
+    // 多预留的部分只是未触及的虚拟内存
+    static constexpr size_t ESTIMATED_BYTES_PER_TOKEN = 4;
+
+    static size_t estimateTokenCount(size_t sourceBytes)
+    {
+        return sourceBytes / ESTIMATED_BYTES_PER_TOKEN + 16;
+    }
+
+    TokenStream() = default;
+    explicit TokenStream(std::pmr::memory_resource* resource)
+        : offsets(resource), lengths(resource), kinds(resource)
+    {
+    }
+
+    std::pmr::memory_resource* resource() const { return kinds.get_allocator().resource(); }
+
+    size_t size() const { return kinds.size(); }
+    bool empty() const { return kinds.empty(); }
+    void reserve(size_t count);
+    void reserveKinds(size_t count);    // 只预留种类列
+    void clear();
+
+    // 是否记录了偏移和长度
+    bool hasExtents() const { return offsets.size() == kinds.size(); }
+
+    void append(const Token& token)
+    {
+        offsets.push_back(static_cast<uint32_t>(token.offset));
+        lengths.push_back(static_cast<uint32_t>(token.length));
+        kinds.push_back(TokenKind::encode(token.type, token.op));
+    }
+
+    // 只追加种类，用于不记录词素的序列
+    void appendKind(TokenType type, OperatorId op)
+    {
+        kinds.push_back(TokenKind::encode(type, op));
+    }
+
+    // 追加 other 中从下标 first 开始的单词
+    void append(const TokenStream& other, size_t first = 0);
+
+    // 用 replacement 替换下标 [first, first + count) 的单词
+    void replace(size_t first, size_t count, const TokenStream& replacement);
+
+    // 下标 first 起所有单词的偏移加上 delta
+    void shiftOffsets(size_t first, std::ptrdiff_t delta);
+
+    size_t offset(size_t index) const { return offsets[index]; }
+    size_t length(size_t index) const { return lengths[index]; }
+    size_t end(size_t index) const { return size_t(offsets[index]) + lengths[index]; }
+    TokenType type(size_t index) const { return TokenKind::type(kinds[index]); }
+    OperatorId op(size_t index) const { return TokenKind::op(kinds[index]); }
+
+    Token token(size_t index) const
+    {
+        return {type(index), op(index), offsets[index], lengths[index]};
+    }
+
+    std::string_view text(size_t index, std::string_view source) const
+    {
+        return source.substr(offsets[index], lengths[index]);
+    }
+
+    TokenView view() const
+    {
+        return TokenView(offsets.data(), lengths.data(), kinds.data(), kinds.size());
+    }
+
+    // 占用的堆内存（字节）
+    size_t memoryUsage() const;
+
+private:
+    std::pmr::vector<uint32_t> offsets;
+    std::pmr::vector<uint32_t> lengths;
+    std::pmr::vector<uint8_t> kinds;
+};
+
+#endif // TOKENSTREAM_H
@@ -0,0 +1,338 @@
+#include "unicodeident.h"
+#include "charclass.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// U+0080 起按码点排序的区间表：每项为 (区间起点 << 2) | 类别，类别一直持续到下一项的起点。
+// 类别 0 为非标识符字符，1 为 XID_Start（同时也是 XID_Continue），2 为仅 XID_Continue。
+// 两种属性合并为一张表，共 1774 项、约 7 KB，按码点二分查找。
+// 由 Python 3.11 的 unicodedata（Unicode 14.0）生成：对 U+0080..U+10FFFF 逐个判断
+// chr(c).isidentifier() 与 ('a' + chr(c)).isidentifier()，记录类别变化的位置
+constexpr uint32_t XID_CLASS_TABLE[] = {
+    0x000200, 0x0002A9, 0x0002AC, 0x0002D5, 0x0002D8, 0x0002DE, 0x0002E0, 0x0002E9,
+    0x0002EC, 0x000301, 0x00035C, 0x000361, 0x0003DC, 0x0003E1, 0x000B08, 0x000B19,
+    0x000B48, 0x000B81, 0x000B94, 0x000BB1, 0x000BB4, 0x000BB9, 0x000BBC, 0x000C02,
+    0x000DC1, 0x000DD4, 0x000DD9, 0x000DE0, 0x000DED, 0x000DF8, 0x000DFD, 0x000E00,
+    0x000E19, 0x000E1E, 0x000E21, 0x000E2C, 0x000E31, 0x000E34, 0x000E39, 0x000E88,
+    0x000E8D, 0x000FD8, 0x000FDD, 0x001208, 0x00120E, 0x001220, 0x001229, 0x0014C0,
+    0x0014C5, 0x00155C, 0x001565, 0x001568, 0x001581, 0x001624, 0x001646, 0x0016F8,
+    0x0016FE, 0x001700, 0x001706, 0x00170C, 0x001712, 0x001718, 0x00171E, 0x001720,
+    0x001741, 0x0017AC, 0x0017BD, 0x0017CC, 0x001842, 0x00186C, 0x001881, 0x00192E,
+    0x0019A8, 0x0019B9, 0x0019C2, 0x0019C5, 0x001B50, 0x001B55, 0x001B5A, 0x001B74,
+    0x001B7E, 0x001B95, 0x001B9E, 0x001BA4, 0x001BAA, 0x001BB9, 0x001BC2, 0x001BE9,
+    0x001BF4, 0x001BFD, 0x001C00, 0x001C41, 0x001C46, 0x001C49, 0x001CC2, 0x001D2C,
+    0x001D35, 0x001E9A, 0x001EC5, 0x001EC8, 0x001F02, 0x001F29, 0x001FAE, 0x001FD1,
+    0x001FD8, 0x001FE9, 0x001FEC, 0x001FF6, 0x001FF8, 0x002001, 0x00205A, 0x002069,
+    0x00206E, 0x002091, 0x002096, 0x0020A1, 0x0020A6, 0x0020B8, 0x002101, 0x002166,
+    0x002170, 0x002181, 0x0021AC, 0x0021C1, 0x002220, 0x002225, 0x00223C, 0x002262,
+    0x002281, 0x00232A, 0x002388, 0x00238E, 0x002411, 0x0024EA, 0x0024F5, 0x0024FA,
+    0x002541, 0x002546, 0x002561, 0x00258A, 0x002590, 0x00259A, 0x0025C0, 0x0025C5,
+    0x002606, 0x002610, 0x002615, 0x002634, 0x00263D, 0x002644, 0x00264D, 0x0026A4,
+    0x0026A9, 0x0026C4, 0x0026C9, 0x0026CC, 0x0026D9, 0x0026E8, 0x0026F2, 0x0026F5,
+    0x0026FA, 0x002714, 0x00271E, 0x002724, 0x00272E, 0x002739, 0x00273C, 0x00275E,
+    0x002760, 0x002771, 0x002778, 0x00277D, 0x00278A, 0x002790, 0x00279A, 0x0027C1,
+    0x0027C8, 0x0027F1, 0x0027F4, 0x0027FA, 0x0027FC, 0x002806, 0x002810, 0x002815,
+    0x00282C, 0x00283D, 0x002844, 0x00284D, 0x0028A4, 0x0028A9, 0x0028C4, 0x0028C9,
+    0x0028D0, 0x0028D5, 0x0028DC, 0x0028E1, 0x0028E8, 0x0028F2, 0x0028F4, 0x0028FA,
+    0x00290C, 0x00291E, 0x002924, 0x00292E, 0x002938, 0x002946, 0x002948, 0x002965,
+    0x002974, 0x002979, 0x00297C, 0x00299A, 0x0029C9, 0x0029D6, 0x0029D8, 0x002A06,
+    0x002A10, 0x002A15, 0x002A38, 0x002A3D, 0x002A48, 0x002A4D, 0x002AA4, 0x002AA9,
+    0x002AC4, 0x002AC9, 0x002AD0, 0x002AD5, 0x002AE8, 0x002AF2, 0x002AF5, 0x002AFA,
+    0x002B18, 0x002B1E, 0x002B28, 0x002B2E, 0x002B38, 0x002B41, 0x002B44, 0x002B81,
+    0x002B8A, 0x002B90, 0x002B9A, 0x002BC0, 0x002BE5, 0x002BEA, 0x002C00, 0x002C06,
+    0x002C10, 0x002C15, 0x002C34, 0x002C3D, 0x002C44, 0x002C4D, 0x002CA4, 0x002CA9,
+    0x002CC4, 0x002CC9, 0x002CD0, 0x002CD5, 0x002CE8, 0x002CF2, 0x002CF5, 0x002CFA,
+    0x002D14, 0x002D1E, 0x002D24, 0x002D2E, 0x002D38, 0x002D56, 0x002D60, 0x002D71,
+    0x002D78, 0x002D7D, 0x002D8A, 0x002D90, 0x002D9A, 0x002DC0, 0x002DC5, 0x002DC8,
+    0x002E0A, 0x002E0D, 0x002E10, 0x002E15, 0x002E2C, 0x002E39, 0x002E44, 0x002E49,
+    0x002E58, 0x002E65, 0x002E6C, 0x002E71, 0x002E74, 0x002E79, 0x002E80, 0x002E8D,
+    0x002E94, 0x002EA1, 0x002EAC, 0x002EB9, 0x002EE8, 0x002EFA, 0x002F0C, 0x002F1A,
+    0x002F24, 0x002F2A, 0x002F38, 0x002F41, 0x002F44, 0x002F5E, 0x002F60, 0x002F9A,
+    0x002FC0, 0x003002, 0x003015, 0x003034, 0x003039, 0x003044, 0x003049, 0x0030A4,
+    0x0030A9, 0x0030E8, 0x0030F2, 0x0030F5, 0x0030FA, 0x003114, 0x00311A, 0x003124,
+    0x00312A, 0x003138, 0x003156, 0x00315C, 0x003161, 0x00316C, 0x003175, 0x003178,
+    0x003181, 0x00318A, 0x003190, 0x00319A, 0x0031C0, 0x003201, 0x003206, 0x003210,
+    0x003215, 0x003234, 0x003239, 0x003244, 0x003249, 0x0032A4, 0x0032A9, 0x0032D0,
+    0x0032D5, 0x0032E8, 0x0032F2, 0x0032F5, 0x0032FA, 0x003314, 0x00331A, 0x003324,
+    0x00332A, 0x003338, 0x003356, 0x00335C, 0x003375, 0x00337C, 0x003381, 0x00338A,
+    0x003390, 0x00339A, 0x0033C0, 0x0033C5, 0x0033CC, 0x003402, 0x003411, 0x003434,
+    0x003439, 0x003444, 0x003449, 0x0034EE, 0x0034F5, 0x0034FA, 0x003514, 0x00351A,
+    0x003524, 0x00352A, 0x003539, 0x00353C, 0x003551, 0x00355E, 0x003560, 0x00357D,
+    0x00358A, 0x003590, 0x00359A, 0x0035C0, 0x0035E9, 0x003600, 0x003606, 0x003610,
+    0x003615, 0x00365C, 0x003669, 0x0036C8, 0x0036CD, 0x0036F0, 0x0036F5, 0x0036F8,
+    0x003701, 0x00371C, 0x00372A, 0x00372C, 0x00373E, 0x003754, 0x00375A, 0x00375C,
+    0x003762, 0x003780, 0x00379A, 0x0037C0, 0x0037CA, 0x0037D0, 0x003805, 0x0038C6,
+    0x0038C9, 0x0038CE, 0x0038EC, 0x003901, 0x00391E, 0x00393C, 0x003942, 0x003968,
+    0x003A05, 0x003A0C, 0x003A11, 0x003A14, 0x003A19, 0x003A2C, 0x003A31, 0x003A90,
+    0x003A95, 0x003A98, 0x003A9D, 0x003AC6, 0x003AC9, 0x003ACE, 0x003AF5, 0x003AF8,
+    0x003B01, 0x003B14, 0x003B19, 0x003B1C, 0x003B22, 0x003B38, 0x003B42, 0x003B68,
+    0x003B71, 0x003B80, 0x003C01, 0x003C04, 0x003C62, 0x003C68, 0x003C82, 0x003CA8,
+    0x003CD6, 0x003CD8, 0x003CDE, 0x003CE0, 0x003CE6, 0x003CE8, 0x003CFA, 0x003D01,
+    0x003D20, 0x003D25, 0x003DB4, 0x003DC6, 0x003E14, 0x003E1A, 0x003E21, 0x003E36,
+    0x003E60, 0x003E66, 0x003EF4, 0x003F1A, 0x003F1C, 0x004001, 0x0040AE, 0x0040FD,
+    0x004102, 0x004128, 0x004141, 0x00415A, 0x004169, 0x00417A, 0x004185, 0x00418A,
+    0x004195, 0x00419E, 0x0041B9, 0x0041C6, 0x0041D5, 0x00420A, 0x004239, 0x00423E,
+    0x004278, 0x004281, 0x004318, 0x00431D, 0x004320, 0x004335, 0x004338, 0x004341,
+    0x0043EC, 0x0043F1, 0x004924, 0x004929, 0x004938, 0x004941, 0x00495C, 0x004961,
+    0x004964, 0x004969, 0x004978, 0x004981, 0x004A24, 0x004A29, 0x004A38, 0x004A41,
+    0x004AC4, 0x004AC9, 0x004AD8, 0x004AE1, 0x004AFC, 0x004B01, 0x004B04, 0x004B09,
+    0x004B18, 0x004B21, 0x004B5C, 0x004B61, 0x004C44, 0x004C49, 0x004C58, 0x004C61,
+    0x004D6C, 0x004D76, 0x004D80, 0x004DA6, 0x004DC8, 0x004E01, 0x004E40, 0x004E81,
+    0x004FD8, 0x004FE1, 0x004FF8, 0x005005, 0x0059B4, 0x0059BD, 0x005A00, 0x005A05,
+    0x005A6C, 0x005A81, 0x005BAC, 0x005BB9, 0x005BE4, 0x005C01, 0x005C4A, 0x005C58,
+    0x005C7D, 0x005CCA, 0x005CD4, 0x005D01, 0x005D4A, 0x005D50, 0x005D81, 0x005DB4,
+    0x005DB9, 0x005DC4, 0x005DCA, 0x005DD0, 0x005E01, 0x005ED2, 0x005F50, 0x005F5D,
+    0x005F60, 0x005F71, 0x005F76, 0x005F78, 0x005F82, 0x005FA8, 0x00602E, 0x006038,
+    0x00603E, 0x006068, 0x006081, 0x0061E4, 0x006201, 0x0062A6, 0x0062A9, 0x0062AC,
+    0x0062C1, 0x0063D8, 0x006401, 0x00647C, 0x006482, 0x0064B0, 0x0064C2, 0x0064F0,
+    0x00651A, 0x006541, 0x0065B8, 0x0065C1, 0x0065D4, 0x006601, 0x0066B0, 0x0066C1,
+    0x006728, 0x006742, 0x00676C, 0x006801, 0x00685E, 0x006870, 0x006881, 0x006956,
+    0x00697C, 0x006982, 0x0069F4, 0x0069FE, 0x006A28, 0x006A42, 0x006A68, 0x006A9D,
+    0x006AA0, 0x006AC2, 0x006AF8, 0x006AFE, 0x006B3C, 0x006C02, 0x006C15, 0x006CD2,
+    0x006D15, 0x006D34, 0x006D42, 0x006D68, 0x006DAE, 0x006DD0, 0x006E02, 0x006E0D,
+    0x006E86, 0x006EB9, 0x006EC2, 0x006EE9, 0x006F9A, 0x006FD0, 0x007001, 0x007092,
+    0x0070E0, 0x007102, 0x007128, 0x007135, 0x007142, 0x007169, 0x0071F8, 0x007201,
+    0x007224, 0x007241, 0x0072EC, 0x0072F5, 0x007300, 0x007342, 0x00734C, 0x007352,
+    0x0073A5, 0x0073B6, 0x0073B9, 0x0073D2, 0x0073D5, 0x0073DE, 0x0073E9, 0x0073EC,
+    0x007401, 0x007702, 0x007801, 0x007C58, 0x007C61, 0x007C78, 0x007C81, 0x007D18,
+    0x007D21, 0x007D38, 0x007D41, 0x007D60, 0x007D65, 0x007D68, 0x007D6D, 0x007D70,
+    0x007D75, 0x007D78, 0x007D7D, 0x007DF8, 0x007E01, 0x007ED4, 0x007ED9, 0x007EF4,
+    0x007EF9, 0x007EFC, 0x007F09, 0x007F14, 0x007F19, 0x007F34, 0x007F41, 0x007F50,
+    0x007F59, 0x007F70, 0x007F81, 0x007FB4, 0x007FC9, 0x007FD4, 0x007FD9, 0x007FF4,
+    0x0080FE, 0x008104, 0x008152, 0x008154, 0x0081C5, 0x0081C8, 0x0081FD, 0x008200,
+    0x008241, 0x008274, 0x008342, 0x008374, 0x008386, 0x008388, 0x008396, 0x0083C4,
+    0x008409, 0x00840C, 0x00841D, 0x008420, 0x008429, 0x008450, 0x008455, 0x008458,
+    0x008461, 0x008478, 0x008491, 0x008494, 0x008499, 0x00849C, 0x0084A1, 0x0084A4,
+    0x0084A9, 0x0084E8, 0x0084F1, 0x008500, 0x008515, 0x008528, 0x008539, 0x00853C,
+    0x008581, 0x008624, 0x00B001, 0x00B394, 0x00B3AD, 0x00B3BE, 0x00B3C9, 0x00B3D0,
+    0x00B401, 0x00B498, 0x00B49D, 0x00B4A0, 0x00B4B5, 0x00B4B8, 0x00B4C1, 0x00B5A0,
+    0x00B5BD, 0x00B5C0, 0x00B5FE, 0x00B601, 0x00B65C, 0x00B681, 0x00B69C, 0x00B6A1,
+    0x00B6BC, 0x00B6C1, 0x00B6DC, 0x00B6E1, 0x00B6FC, 0x00B701, 0x00B71C, 0x00B721,
+    0x00B73C, 0x00B741, 0x00B75C, 0x00B761, 0x00B77C, 0x00B782, 0x00B800, 0x00C015,
+    0x00C020, 0x00C085, 0x00C0AA, 0x00C0C0, 0x00C0C5, 0x00C0D8, 0x00C0E1, 0x00C0F4,
+    0x00C105, 0x00C25C, 0x00C266, 0x00C26C, 0x00C275, 0x00C280, 0x00C285, 0x00C3EC,
+    0x00C3F1, 0x00C400, 0x00C415, 0x00C4C0, 0x00C4C5, 0x00C63C, 0x00C681, 0x00C700,
+    0x00C7C1, 0x00C800, 0x00D001, 0x013700, 0x013801, 0x029234, 0x029341, 0x0293F8,
+    0x029401, 0x029834, 0x029841, 0x029882, 0x0298A9, 0x0298B0, 0x029901, 0x0299BE,
+    0x0299C0, 0x0299D2, 0x0299F8, 0x0299FD, 0x029A7A, 0x029A81, 0x029BC2, 0x029BC8,
+    0x029C5D, 0x029C80, 0x029C89, 0x029E24, 0x029E2D, 0x029F2C, 0x029F41, 0x029F48,
+    0x029F4D, 0x029F50, 0x029F55, 0x029F68, 0x029FC9, 0x02A00A, 0x02A00D, 0x02A01A,
+    0x02A01D, 0x02A02E, 0x02A031, 0x02A08E, 0x02A0A0, 0x02A0B2, 0x02A0B4, 0x02A101,
+    0x02A1D0, 0x02A202, 0x02A209, 0x02A2D2, 0x02A318, 0x02A342, 0x02A368, 0x02A382,
+    0x02A3C9, 0x02A3E0, 0x02A3ED, 0x02A3F0, 0x02A3F5, 0x02A3FE, 0x02A429, 0x02A49A,
+    0x02A4B8, 0x02A4C1, 0x02A51E, 0x02A550, 0x02A581, 0x02A5F4, 0x02A602, 0x02A611,
+    0x02A6CE, 0x02A704, 0x02A73D, 0x02A742, 0x02A768, 0x02A781, 0x02A796, 0x02A799,
+    0x02A7C2, 0x02A7E9, 0x02A7FC, 0x02A801, 0x02A8A6, 0x02A8DC, 0x02A901, 0x02A90E,
+    0x02A911, 0x02A932, 0x02A938, 0x02A942, 0x02A968, 0x02A981, 0x02A9DC, 0x02A9E9,
+    0x02A9EE, 0x02A9F9, 0x02AAC2, 0x02AAC5, 0x02AACA, 0x02AAD5, 0x02AADE, 0x02AAE5,
+    0x02AAFA, 0x02AB01, 0x02AB06, 0x02AB09, 0x02AB0C, 0x02AB6D, 0x02AB78, 0x02AB81,
+    0x02ABAE, 0x02ABC0, 0x02ABC9, 0x02ABD6, 0x02ABDC, 0x02AC05, 0x02AC1C, 0x02AC25,
+    0x02AC3C, 0x02AC45, 0x02AC5C, 0x02AC81, 0x02AC9C, 0x02ACA1, 0x02ACBC, 0x02ACC1,
+    0x02AD6C, 0x02AD71, 0x02ADA8, 0x02ADC1, 0x02AF8E, 0x02AFAC, 0x02AFB2, 0x02AFB8,
+    0x02AFC2, 0x02AFE8, 0x02B001, 0x035E90, 0x035EC1, 0x035F1C, 0x035F2D, 0x035FF0,
+    0x03E401, 0x03E9B8, 0x03E9C1, 0x03EB68, 0x03EC01, 0x03EC1C, 0x03EC4D, 0x03EC60,
+    0x03EC75, 0x03EC7A, 0x03EC7D, 0x03ECA4, 0x03ECA9, 0x03ECDC, 0x03ECE1, 0x03ECF4,
+    0x03ECF9, 0x03ECFC, 0x03ED01, 0x03ED08, 0x03ED0D, 0x03ED14, 0x03ED19, 0x03EEC8,
+    0x03EF4D, 0x03F178, 0x03F191, 0x03F4F8, 0x03F541, 0x03F640, 0x03F649, 0x03F720,
+    0x03F7C1, 0x03F7E8, 0x03F802, 0x03F840, 0x03F882, 0x03F8C0, 0x03F8CE, 0x03F8D4,
+    0x03F936, 0x03F940, 0x03F9C5, 0x03F9C8, 0x03F9CD, 0x03F9D0, 0x03F9DD, 0x03F9E0,
+    0x03F9E5, 0x03F9E8, 0x03F9ED, 0x03F9F0, 0x03F9F5, 0x03F9F8, 0x03F9FD, 0x03FBF4,
+    0x03FC42, 0x03FC68, 0x03FC85, 0x03FCEC, 0x03FCFE, 0x03FD00, 0x03FD05, 0x03FD6C,
+    0x03FD99, 0x03FE7A, 0x03FE81, 0x03FEFC, 0x03FF09, 0x03FF20, 0x03FF29, 0x03FF40,
+    0x03FF49, 0x03FF60, 0x03FF69, 0x03FF74, 0x040001, 0x040030, 0x040035, 0x04009C,
+    0x0400A1, 0x0400EC, 0x0400F1, 0x0400F8, 0x0400FD, 0x040138, 0x040141, 0x040178,
+    0x040201, 0x0403EC, 0x040501, 0x0405D4, 0x0407F6, 0x0407F8, 0x040A01, 0x040A74,
+    0x040A81, 0x040B44, 0x040B82, 0x040B84, 0x040C01, 0x040C80, 0x040CB5, 0x040D2C,
+    0x040D41, 0x040DDA, 0x040DEC, 0x040E01, 0x040E78, 0x040E81, 0x040F10, 0x040F21,
+    0x040F40, 0x040F45, 0x040F58, 0x041001, 0x041278, 0x041282, 0x0412A8, 0x0412C1,
+    0x041350, 0x041361, 0x0413F0, 0x041401, 0x0414A0, 0x0414C1, 0x041590, 0x0415C1,
+    0x0415EC, 0x0415F1, 0x04162C, 0x041631, 0x04164C, 0x041651, 0x041658, 0x04165D,
+    0x041688, 0x04168D, 0x0416C8, 0x0416CD, 0x0416E8, 0x0416ED, 0x0416F4, 0x041801,
+    0x041CDC, 0x041D01, 0x041D58, 0x041D81, 0x041DA0, 0x041E01, 0x041E18, 0x041E1D,
+    0x041EC4, 0x041EC9, 0x041EEC, 0x042001, 0x042018, 0x042021, 0x042024, 0x042029,
+    0x0420D8, 0x0420DD, 0x0420E4, 0x0420F1, 0x0420F4, 0x0420FD, 0x042158, 0x042181,
+    0x0421DC, 0x042201, 0x04227C, 0x042381, 0x0423CC, 0x0423D1, 0x0423D8, 0x042401,
+    0x042458, 0x042481, 0x0424E8, 0x042601, 0x0426E0, 0x0426F9, 0x042700, 0x042801,
+    0x042806, 0x042810, 0x042816, 0x04281C, 0x042832, 0x042841, 0x042850, 0x042855,
+    0x042860, 0x042865, 0x0428D8, 0x0428E2, 0x0428EC, 0x0428FE, 0x042900, 0x042981,
+    0x0429F4, 0x042A01, 0x042A74, 0x042B01, 0x042B20, 0x042B25, 0x042B96, 0x042B9C,
+    0x042C01, 0x042CD8, 0x042D01, 0x042D58, 0x042D81, 0x042DCC, 0x042E01, 0x042E48,
+    0x043001, 0x043124, 0x043201, 0x0432CC, 0x043301, 0x0433CC, 0x043401, 0x043492,
+    0x0434A0, 0x0434C2, 0x0434E8, 0x043A01, 0x043AA8, 0x043AAE, 0x043AB4, 0x043AC1,
+    0x043AC8, 0x043C01, 0x043C74, 0x043C9D, 0x043CA0, 0x043CC1, 0x043D1A, 0x043D44,
+    0x043DC1, 0x043E0A, 0x043E18, 0x043EC1, 0x043F14, 0x043F81, 0x043FDC, 0x044002,
+    0x04400D, 0x0440E2, 0x04411C, 0x04419A, 0x0441C5, 0x0441CE, 0x0441D5, 0x0441D8,
+    0x0441FE, 0x04420D, 0x0442C2, 0x0442EC, 0x04430A, 0x04430C, 0x044341, 0x0443A4,
+    0x0443C2, 0x0443E8, 0x044402, 0x04440D, 0x04449E, 0x0444D4, 0x0444DA, 0x044500,
+    0x044511, 0x044516, 0x04451D, 0x044520, 0x044541, 0x0445CE, 0x0445D0, 0x0445D9,
+    0x0445DC, 0x044602, 0x04460D, 0x0446CE, 0x044705, 0x044714, 0x044726, 0x044734,
+    0x04473A, 0x044769, 0x04476C, 0x044771, 0x044774, 0x044801, 0x044848, 0x04484D,
+    0x0448B2, 0x0448E0, 0x0448FA, 0x0448FC, 0x044A01, 0x044A1C, 0x044A21, 0x044A24,
+    0x044A29, 0x044A38, 0x044A3D, 0x044A78, 0x044A7D, 0x044AA4, 0x044AC1, 0x044B7E,
+    0x044BAC, 0x044BC2, 0x044BE8, 0x044C02, 0x044C10, 0x044C15, 0x044C34, 0x044C3D,
+    0x044C44, 0x044C4D, 0x044CA4, 0x044CA9, 0x044CC4, 0x044CC9, 0x044CD0, 0x044CD5,
+    0x044CE8, 0x044CEE, 0x044CF5, 0x044CFA, 0x044D14, 0x044D1E, 0x044D24, 0x044D2E,
+    0x044D38, 0x044D41, 0x044D44, 0x044D5E, 0x044D60, 0x044D75, 0x044D8A, 0x044D90,
+    0x044D9A, 0x044DB4, 0x044DC2, 0x044DD4, 0x045001, 0x0450D6, 0x04511D, 0x04512C,
+    0x045142, 0x045168, 0x04517A, 0x04517D, 0x045188, 0x045201, 0x0452C2, 0x045311,
+    0x045318, 0x04531D, 0x045320, 0x045342, 0x045368, 0x045601, 0x0456BE, 0x0456D8,
+    0x0456E2, 0x045704, 0x045761, 0x045772, 0x045778, 0x045801, 0x0458C2, 0x045904,
+    0x045911, 0x045914, 0x045942, 0x045968, 0x045A01, 0x045AAE, 0x045AE1, 0x045AE4,
+    0x045B02, 0x045B28, 0x045C01, 0x045C6C, 0x045C76, 0x045CB0, 0x045CC2, 0x045CE8,
+    0x045D01, 0x045D1C, 0x046001, 0x0460B2, 0x0460EC, 0x046281, 0x046382, 0x0463A8,
+    0x0463FD, 0x04641C, 0x046425, 0x046428, 0x046431, 0x046450, 0x046455, 0x04645C,
+    0x046461, 0x0464C2, 0x0464D8, 0x0464DE, 0x0464E4, 0x0464EE, 0x0464FD, 0x046502,
+    0x046505, 0x04650A, 0x046510, 0x046542, 0x046568, 0x046681, 0x0466A0, 0x0466A9,
+    0x046746, 0x046760, 0x04676A, 0x046785, 0x046788, 0x04678D, 0x046792, 0x046794,
+    0x046801, 0x046806, 0x04682D, 0x0468CE, 0x0468E9, 0x0468EE, 0x0468FC, 0x04691E,
+    0x046920, 0x046941, 0x046946, 0x046971, 0x046A2A, 0x046A68, 0x046A75, 0x046A78,
+    0x046AC1, 0x046BE4, 0x047001, 0x047024, 0x047029, 0x0470BE, 0x0470DC, 0x0470E2,
+    0x047101, 0x047104, 0x047142, 0x047168, 0x0471C9, 0x047240, 0x04724A, 0x0472A0,
+    0x0472A6, 0x0472DC, 0x047401, 0x04741C, 0x047421, 0x047428, 0x04742D, 0x0474C6,
+    0x0474DC, 0x0474EA, 0x0474EC, 0x0474F2, 0x0474F8, 0x0474FE, 0x047519, 0x04751E,
+    0x047520, 0x047542, 0x047568, 0x047581, 0x047598, 0x04759D, 0x0475A4, 0x0475A9,
+    0x04762A, 0x04763C, 0x047642, 0x047648, 0x04764E, 0x047661, 0x047664, 0x047682,
+    0x0476A8, 0x047B81, 0x047BCE, 0x047BDC, 0x047EC1, 0x047EC4, 0x048001, 0x048E68,
+    0x049001, 0x0491BC, 0x049201, 0x049510, 0x04BE41, 0x04BFC4, 0x04C001, 0x04D0BC,
+    0x051001, 0x05191C, 0x05A001, 0x05A8E4, 0x05A901, 0x05A97C, 0x05A982, 0x05A9A8,
+    0x05A9C1, 0x05AAFC, 0x05AB02, 0x05AB28, 0x05AB41, 0x05ABB8, 0x05ABC2, 0x05ABD4,
+    0x05AC01, 0x05ACC2, 0x05ACDC, 0x05AD01, 0x05AD10, 0x05AD42, 0x05AD68, 0x05AD8D,
+    0x05ADE0, 0x05ADF5, 0x05AE40, 0x05B901, 0x05BA00, 0x05BC01, 0x05BD2C, 0x05BD3E,
+    0x05BD41, 0x05BD46, 0x05BE20, 0x05BE3E, 0x05BE4D, 0x05BE80, 0x05BF81, 0x05BF88,
+    0x05BF8D, 0x05BF92, 0x05BF94, 0x05BFC2, 0x05BFC8, 0x05C001, 0x061FE0, 0x062001,
+    0x063358, 0x063401, 0x063424, 0x06BFC1, 0x06BFD0, 0x06BFD5, 0x06BFF0, 0x06BFF5,
+    0x06BFFC, 0x06C001, 0x06C48C, 0x06C541, 0x06C54C, 0x06C591, 0x06C5A0, 0x06C5C1,
+    0x06CBF0, 0x06F001, 0x06F1AC, 0x06F1C1, 0x06F1F4, 0x06F201, 0x06F224, 0x06F241,
+    0x06F268, 0x06F276, 0x06F27C, 0x073C02, 0x073CB8, 0x073CC2, 0x073D1C, 0x074596,
+    0x0745A8, 0x0745B6, 0x0745CC, 0x0745EE, 0x07460C, 0x074616, 0x074630, 0x0746AA,
+    0x0746B8, 0x07490A, 0x074914, 0x075001, 0x075154, 0x075159, 0x075274, 0x075279,
+    0x075280, 0x075289, 0x07528C, 0x075295, 0x07529C, 0x0752A5, 0x0752B4, 0x0752B9,
+    0x0752E8, 0x0752ED, 0x0752F0, 0x0752F5, 0x075310, 0x075315, 0x075418, 0x07541D,
+    0x07542C, 0x075435, 0x075454, 0x075459, 0x075474, 0x075479, 0x0754E8, 0x0754ED,
+    0x0754FC, 0x075501, 0x075514, 0x075519, 0x07551C, 0x075529, 0x075544, 0x075549,
+    0x075A98, 0x075AA1, 0x075B04, 0x075B09, 0x075B6C, 0x075B71, 0x075BEC, 0x075BF1,
+    0x075C54, 0x075C59, 0x075CD4, 0x075CD9, 0x075D3C, 0x075D41, 0x075DBC, 0x075DC1,
+    0x075E24, 0x075E29, 0x075EA4, 0x075EA9, 0x075F0C, 0x075F11, 0x075F30, 0x075F3A,
+    0x076000, 0x076802, 0x0768DC, 0x0768EE, 0x0769B4, 0x0769D6, 0x0769D8, 0x076A12,
+    0x076A14, 0x076A6E, 0x076A80, 0x076A86, 0x076AC0, 0x077C01, 0x077C7C, 0x078002,
+    0x07801C, 0x078022, 0x078064, 0x07806E, 0x078088, 0x07808E, 0x078094, 0x07809A,
+    0x0780AC, 0x078401, 0x0784B4, 0x0784C2, 0x0784DD, 0x0784F8, 0x078502, 0x078528,
+    0x078539, 0x07853C, 0x078A41, 0x078ABA, 0x078ABC, 0x078B01, 0x078BB2, 0x078BE8,
+    0x079F81, 0x079F9C, 0x079FA1, 0x079FB0, 0x079FB5, 0x079FBC, 0x079FC1, 0x079FFC,
+    0x07A001, 0x07A314, 0x07A342, 0x07A35C, 0x07A401, 0x07A512, 0x07A52D, 0x07A530,
+    0x07A542, 0x07A568, 0x07B801, 0x07B810, 0x07B815, 0x07B880, 0x07B885, 0x07B88C,
+    0x07B891, 0x07B894, 0x07B89D, 0x07B8A0, 0x07B8A5, 0x07B8CC, 0x07B8D1, 0x07B8E0,
+    0x07B8E5, 0x07B8E8, 0x07B8ED, 0x07B8F0, 0x07B909, 0x07B90C, 0x07B91D, 0x07B920,
+    0x07B925, 0x07B928, 0x07B92D, 0x07B930, 0x07B935, 0x07B940, 0x07B945, 0x07B94C,
+    0x07B951, 0x07B954, 0x07B95D, 0x07B960, 0x07B965, 0x07B968, 0x07B96D, 0x07B970,
+    0x07B975, 0x07B978, 0x07B97D, 0x07B980, 0x07B985, 0x07B98C, 0x07B991, 0x07B994,
+    0x07B99D, 0x07B9AC, 0x07B9B1, 0x07B9CC, 0x07B9D1, 0x07B9E0, 0x07B9E5, 0x07B9F4,
+    0x07B9F9, 0x07B9FC, 0x07BA01, 0x07BA28, 0x07BA2D, 0x07BA70, 0x07BA85, 0x07BA90,
+    0x07BA95, 0x07BAA8, 0x07BAAD, 0x07BAF0, 0x07EFC2, 0x07EFE8, 0x080001, 0x0A9B80,
+    0x0A9C01, 0x0ADCE4, 0x0ADD01, 0x0AE078, 0x0AE081, 0x0B3A88, 0x0B3AC1, 0x0BAF84,
+    0x0BE001, 0x0BE878, 0x0C0001, 0x0C4D2C, 0x380402, 0x3807C0,
+};
+
+constexpr uint32_t XID_NONE = 0;
+constexpr uint32_t XID_START = 1;
+constexpr uint32_t XID_CONTINUE_ONLY = 2;
+
+uint32_t xidClass(char32_t codePoint)
+{
+    // 第一个起点大于 codePoint 的项的前一项
+    const uint32_t key = (uint32_t(codePoint) << 2) | 3;
+    const uint32_t* end = XID_CLASS_TABLE + sizeof(XID_CLASS_TABLE) / sizeof(XID_CLASS_TABLE[0]);
+    const uint32_t* it = std::upper_bound(XID_CLASS_TABLE, end, key);
+    return it == XID_CLASS_TABLE ? XID_NONE : (it[-1] & 3);
+}
+
+} // namespace
+
+size_t decodeUtf8(const char* data, size_t length, char32_t& codePoint)
+{
+    if (length == 0) {
+        return 0;
+    }
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    unsigned char lead = bytes[0];
+    if (lead < 0x80) {
+        codePoint = lead;
+        return 1;
+    }
+
+    // 第二个字节的合法范围随首字节收窄，排除过长编码、代理项和超出 U+10FFFF 的码点
+    size_t count;
+    unsigned char low = 0x80;
+    unsigned char high = 0xBF;
+    char32_t value;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        count = 2;
+        value = lead & 0x1F;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        count = 3;
+        value = lead & 0x0F;
+        if (lead == 0xE0) low = 0xA0;
+        if (lead == 0xED) high = 0x9F;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        count = 4;
+        value = lead & 0x07;
+        if (lead == 0xF0) low = 0x90;
+        if (lead == 0xF4) high = 0x8F;
+    } else {
+        return 0;
+    }
+    if (length < count || bytes[1] < low || bytes[1] > high) {
+        return 0;
+    }
+    value = (value << 6) | (bytes[1] & 0x3F);
+    for (size_t i = 2; i < count; i++) {
+        if ((bytes[i] & 0xC0) != 0x80) {
+            return 0;
+        }
+        value = (value << 6) | (bytes[i] & 0x3F);
+    }
+    codePoint = value;
+    return count;
+}
+
+bool isXidStart(char32_t codePoint)
+{
+    if (codePoint < 0x80) {
+        return hasCharClass(char(codePoint), CC_ALPHA);
+    }
+    return xidClass(codePoint) == XID_START;
+}
+
+bool isXidContinue(char32_t codePoint)
+{
+    if (codePoint < 0x80) {
+        return hasCharClass(char(codePoint), CC_IDENT_CONTINUE);
+    }
+    return xidClass(codePoint) != XID_NONE;
+}
+
+size_t countCodePoints(const char* data, size_t length)
+{
+    size_t count = 0;
+    size_t i = 0;
+    while (i + 8 <= length) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        if ((word & 0x8080808080808080ull) == 0) {
+            count += 8;
+        } else {
+            // 后续字节的最高两位为 10：最高位为1且次高位为0。
+            // 各字节的标志移到最低位后乘以 0x01...01，最高字节即为标志之和
+            uint64_t continuation = (word & ~(word << 1) & 0x8080808080808080ull) >> 7;
+            count += 8 - size_t((continuation * 0x0101010101010101ull) >> 56);
+        }
+        i += 8;
+    }
+    for (; i < length; i++) {
+        count += (static_cast<unsigned char>(data[i]) & 0xC0) != 0x80;
+    }
+    return count;
+}
@@ -0,0 +1,23 @@
+#ifndef UNICODEIDENT_H
+#define UNICODEIDENT_H
+
+#include <cstddef>
+#include <cstdint>
+
+// UTF-8 解码和 Unicode 标识符字符类别（UAX #31 的 XID_Start / XID_Continue，Rust 标识符的定义）。
+// 词法分析器只在遇到非ASCII字节时才调用这里，纯ASCII的源码不经过解码
+
+// 解码 data 开头的一个码点，返回其字节数（1到4）。
+// 不是合法的 UTF-8 序列（截断、过长编码、代理项、超出 U+10FFFF）时返回0
+size_t decodeUtf8(const char* data, size_t length, char32_t& codePoint);
+
+// 标识符首字符：XID_Start，ASCII 中即字母（下划线由词法分析器单独处理）
+bool isXidStart(char32_t codePoint);
+// 标识符后续字符：XID_Continue，ASCII 中即字母、数字和下划线
+bool isXidContinue(char32_t codePoint);
+
+// [data, data + length) 中的码点数：只数 10xxxxxx 以外的字节，
+// 对合法的 UTF-8 即码点数。纯ASCII的部分每次处理8个字节
+size_t countCodePoints(const char* data, size_t length);
+
+#endif // UNICODEIDENT_H
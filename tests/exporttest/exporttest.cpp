@@ -0,0 +1,538 @@
+// 单词导出读回测试：把一组源码按 JSON Lines、CSV 和二进制三种格式导出，再按各自的格式解码，
+// 按文件归组后与 tokenize() 的结果逐个比较类型、偏移、行号、列号和词素。
+// 每种格式分别以两种方式导出：
+//   - 一个线程、256 字节的小缓冲区：每隔几条记录就跨越块边界，检查每块开头重复的文件记录
+//     以及二进制格式中随文件记录重新开始的偏移差和行号差；
+//   - 多个线程各用一个默认大小的 BufferedWriter 共享同一个输出文件，源码含有数百 KB 的
+//     注释和字符串，记录超过缓冲区时必须分段写出，其他线程的块不能插入记录中间。
+// 源码中混入引号、逗号、反斜杠、控制字符、换行和多字节字符，路径中也有逗号和引号，
+// 覆盖 JSON 和 CSV 的转义。任何不一致都打印出错的位置并返回非零。
+//
+// 用法：exporttest [选项]
+//   --threads <N>    多线程导出时的线程数（默认 8）
+//   --files <N>      含有大单词的源码个数（默认 32）
+
+#include "lineindex.h"
+#include "rustlexer.h"
+#include "tokenexport.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Options {
+    size_t threads = 8;
+    size_t files = 32;
+};
+
+// 导出的类型名，与 TokenType 的枚举名一致
+const char* const KIND_NAMES[] = {
+    "KEYWORD", "IDENTIFIER", "INTEGER_LITERAL", "FLOAT_LITERAL", "STRING_LITERAL",
+    "CHAR_LITERAL", "OPERATOR", "DELIMITER", "COMMENT", "MACRO_CALL", "LIFETIME", "UNKNOWN"
+};
+const size_t KIND_COUNT = sizeof(KIND_NAMES) / sizeof(KIND_NAMES[0]);
+
+// BufferedWriter 允许的最小容量
+constexpr size_t SMALL_CAPACITY = 256;
+
+// 读回的一条单词记录
+struct Record {
+    std::string kind;
+    uint64_t offset = 0;
+    uint64_t line = 0;
+    uint64_t column = 0;
+    std::string lexeme;
+};
+
+using RecordsByFile = std::map<std::string, std::vector<Record>>;
+
+struct Source {
+    std::string path;
+    std::string text;
+};
+
+// 需要转义的短源码：各类单词、多行字符串、制表符、控制字符和多字节字符
+const char* const SMALL_SOURCES[] = {
+    "fn main() {\n    let s = \"a,b\\\"c\";\n    println!(\"{}\", s);\n}\n",
+    "// 注释, 带逗号和 \"引号\"\n/* 块注释\r\n第二行 */\nlet größe = 'é';\n",
+    "let x = 0x1F_u32 + 1.5e3;\tlet y = 'a';\nlet r = r#\"raw \"quoted\"\n行\"#;\n",
+    "let c = \"\x01\x1f控制字符\";\n'outer: loop { break 'outer; }\n",
+    "\n\n\n   let 宽度 = \"中文→😀\";\n",
+};
+
+// 路径中的逗号和引号需要 CSV 加引号、JSON 转义
+const char* const SMALL_PATHS[] = {
+    "src/main.rs", "src/a,b.rs", "src/\"quoted\".rs", "src/中文.rs", "src/tab\there.rs",
+};
+
+// 词素超过约 170 KB 时按最坏情况预留的空间就会超过 1 MiB 的默认缓冲区，转义后超过 1 MiB 时
+// 记录本身也必须分段写出；注释大小在 300 KB 到 1.2 MB 之间，两种情形都会出现。
+// 注释和字符串中混入引号、反斜杠、控制字符和多字节字符，每个字节的转义长度都不同
+std::string generate(size_t index)
+{
+    std::string comment;
+    std::string literal;
+    const size_t size = (index % 4 + 1) * 300 * 1024 + index * 997;
+    while (comment.size() < size) {
+        comment += "注释 \"quoted\", \\ back\tslash\x01 ";
+        comment += char('a' + comment.size() % 26);
+        literal += "字符串 \\\" 转义, \\n ";
+        literal += char('A' + literal.size() % 26);
+    }
+    return "fn f" + std::to_string(index) + "() {}\n/* " + comment + " */\nlet s = \"" + literal
+           + "\";\n// 行尾 → " + std::to_string(index) + "\n";
+}
+
+// ---------- JSON Lines ----------
+
+// 解析 JSON 字符串（p 指向开头的引号），只需支持导出器产生的转义
+bool parseString(std::string_view line, size_t& p, std::string& out)
+{
+    if (p >= line.size() || line[p] != '"') {
+        return false;
+    }
+    out.clear();
+    for (p++; p < line.size(); p++) {
+        char c = line[p];
+        if (c == '"') {
+            p++;
+            return true;
+        }
+        if (static_cast<unsigned char>(c) < 0x20) {
+            return false;
+        }
+        if (c != '\\') {
+            out += c;
+            continue;
+        }
+        if (++p >= line.size()) {
+            return false;
+        }
+        switch (line[p]) {
+        case '"':  out += '"'; break;
+        case '\\': out += '\\'; break;
+        case '/':  out += '/'; break;
+        case 'n':  out += '\n'; break;
+        case 'r':  out += '\r'; break;
+        case 't':  out += '\t'; break;
+        case 'b':  out += '\b'; break;
+        case 'f':  out += '\f'; break;
+        case 'u': {
+            if (p + 4 >= line.size()) {
+                return false;
+            }
+            unsigned long code = std::strtoul(std::string(line.substr(p + 1, 4)).c_str(), nullptr, 16);
+            p += 4;
+            if (code < 0x80) {
+                out += char(code);
+            } else if (code < 0x800) {
+                out += char(0xC0 | (code >> 6));
+                out += char(0x80 | (code & 0x3F));
+            } else {
+                out += char(0xE0 | (code >> 12));
+                out += char(0x80 | ((code >> 6) & 0x3F));
+                out += char(0x80 | (code & 0x3F));
+            }
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+    return false;
+}
+
+bool parseNumber(std::string_view line, size_t& p, uint64_t& value)
+{
+    size_t begin = p;
+    value = 0;
+    while (p < line.size() && line[p] >= '0' && line[p] <= '9') {
+        value = value * 10 + uint64_t(line[p] - '0');
+        p++;
+    }
+    return p != begin;
+}
+
+bool expect(std::string_view line, size_t& p, std::string_view text)
+{
+    if (line.substr(p, text.size()) != text) {
+        return false;
+    }
+    p += text.size();
+    return true;
+}
+
+// 一行 JSON Lines：文件记录设置 isFile 和 file，单词记录填写 record
+bool parseJsonLine(std::string_view line, bool& isFile, std::string& file, Record& record)
+{
+    size_t p = 0;
+    if (line.substr(0, 8) == "{\"file\":") {
+        p = 8;
+        isFile = true;
+        return parseString(line, p, file) && expect(line, p, "}") && p == line.size();
+    }
+    isFile = false;
+    return expect(line, p, "{\"kind\":") && parseString(line, p, record.kind)
+        && expect(line, p, ",\"offset\":") && parseNumber(line, p, record.offset)
+        && expect(line, p, ",\"line\":") && parseNumber(line, p, record.line)
+        && expect(line, p, ",\"column\":") && parseNumber(line, p, record.column)
+        && expect(line, p, ",\"lexeme\":") && parseString(line, p, record.lexeme)
+        && expect(line, p, "}") && p == line.size();
+}
+
+// 每一块以文件记录开头，之后的单词记录属于这个文件
+bool decodeJsonLines(std::string_view data, RecordsByFile& byFile)
+{
+    std::vector<Record>* current = nullptr;
+    size_t lineNumber = 0;
+    size_t start = 0;
+    while (start < data.size()) {
+        size_t end = data.find('\n', start);
+        if (end == std::string_view::npos) {
+            std::printf("输出没有以换行结尾\n");
+            return false;
+        }
+        std::string_view line = data.substr(start, end - start);
+        start = end + 1;
+        lineNumber++;
+
+        bool isFile;
+        std::string path;
+        Record record;
+        if (!parseJsonLine(line, isFile, path, record)) {
+            std::printf("第 %zu 行不是完整的记录：%.80s\n", lineNumber, std::string(line).c_str());
+            return false;
+        }
+        if (isFile) {
+            current = &byFile[path];
+        } else if (!current) {
+            std::printf("第 %zu 行的单词记录之前没有文件记录\n", lineNumber);
+            return false;
+        } else {
+            current->push_back(std::move(record));
+        }
+    }
+    return true;
+}
+
+// ---------- CSV ----------
+
+// 读一个 RFC 4180 字段，停在逗号或换行上
+bool parseCsvField(std::string_view data, size_t& p, std::string& out)
+{
+    out.clear();
+    if (p < data.size() && data[p] == '"') {
+        for (p++; p < data.size(); p++) {
+            if (data[p] != '"') {
+                out += data[p];
+            } else if (p + 1 < data.size() && data[p + 1] == '"') {
+                out += '"';
+                p++;
+            } else {
+                p++;
+                return p < data.size() && (data[p] == ',' || data[p] == '\n');
+            }
+        }
+        return false;
+    }
+    while (p < data.size() && data[p] != ',' && data[p] != '\n') {
+        if (data[p] == '"' || data[p] == '\r') {
+            return false;
+        }
+        out += data[p++];
+    }
+    return p < data.size();
+}
+
+bool parseCsvNumber(const std::string& field, uint64_t& value)
+{
+    size_t p = 0;
+    return parseNumber(field, p, value) && p == field.size();
+}
+
+// 首行为列名，之后每行都带文件路径
+bool decodeCsv(std::string_view data, RecordsByFile& byFile)
+{
+    const std::string_view header = "file,kind,offset,line,column,lexeme\n";
+    if (data.substr(0, header.size()) != header) {
+        std::printf("CSV 缺少列名\n");
+        return false;
+    }
+    size_t p = header.size();
+    size_t row = 1;
+    while (p < data.size()) {
+        row++;
+        std::string fields[6];
+        for (size_t i = 0; i < 6; i++) {
+            if (!parseCsvField(data, p, fields[i]) || data[p] != (i == 5 ? '\n' : ',')) {
+                std::printf("CSV 第 %zu 条记录的第 %zu 个字段不完整\n", row, i + 1);
+                return false;
+            }
+            p++;
+        }
+        Record record;
+        record.kind = fields[1];
+        record.lexeme = fields[5];
+        if (!parseCsvNumber(fields[2], record.offset) || !parseCsvNumber(fields[3], record.line)
+            || !parseCsvNumber(fields[4], record.column)) {
+            std::printf("CSV 第 %zu 条记录的数字字段格式错误\n", row);
+            return false;
+        }
+        byFile[fields[0]].push_back(std::move(record));
+    }
+    return true;
+}
+
+// ---------- 二进制 ----------
+
+bool readVarint(std::string_view data, size_t& p, uint64_t& value)
+{
+    value = 0;
+    for (unsigned shift = 0; shift < 64 && p < data.size(); shift += 7) {
+        uint8_t byte = uint8_t(data[p++]);
+        value |= uint64_t(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 文件记录之后偏移差从0、行号差从第1行重新开始
+bool decodeBinary(std::string_view data, RecordsByFile& byFile)
+{
+    const char header[] = {'R', 'L', 'X', 'E', char(TokenExporter::BINARY_VERSION)};
+    if (data.substr(0, sizeof(header)) != std::string_view(header, sizeof(header))) {
+        std::printf("二进制输出的文件头不符\n");
+        return false;
+    }
+    std::vector<Record>* current = nullptr;
+    uint64_t previousEnd = 0;
+    uint64_t previousLine = 1;
+    size_t p = sizeof(header);
+    while (p < data.size()) {
+        const size_t start = p;
+        const uint8_t tag = uint8_t(data[p++]);
+        uint64_t length;
+        if (tag == 0xFE) {
+            if (!readVarint(data, p, length) || length > data.size() - p) {
+                std::printf("二进制偏移 %zu 处的文件记录不完整\n", start);
+                return false;
+            }
+            current = &byFile[std::string(data.substr(p, length))];
+            p += length;
+            previousEnd = 0;
+            previousLine = 1;
+            continue;
+        }
+        if (tag >= KIND_COUNT || !current) {
+            std::printf("二进制偏移 %zu 处的记录类型 %u 无效或之前没有文件记录\n", start, unsigned(tag));
+            return false;
+        }
+        uint64_t offsetDelta, lineDelta;
+        Record record;
+        if (!readVarint(data, p, offsetDelta) || !readVarint(data, p, lineDelta)
+            || !readVarint(data, p, record.column) || !readVarint(data, p, length)
+            || length > data.size() - p) {
+            std::printf("二进制偏移 %zu 处的单词记录不完整\n", start);
+            return false;
+        }
+        record.kind = KIND_NAMES[tag];
+        record.offset = previousEnd + offsetDelta;
+        record.line = previousLine + lineDelta;
+        record.lexeme.assign(data.substr(p, length));
+        p += length;
+        previousEnd = record.offset + length;
+        previousLine = record.line;
+        current->push_back(std::move(record));
+    }
+    return true;
+}
+
+// ---------- 导出和比较 ----------
+
+bool readFile(std::FILE* file, std::string& data)
+{
+    std::rewind(file);
+    data.clear();
+    char buffer[65536];
+    size_t count;
+    while ((count = std::fread(buffer, 1, sizeof(buffer), file)) != 0) {
+        data.append(buffer, count);
+    }
+    return std::ferror(file) == 0;
+}
+
+// threadCount 个线程各用一个容量为 capacity 的 BufferedWriter 共享一个输出文件，
+// 与 rustlex --export 相同：文件头先单独写出，之后各线程攒满一块持锁写出
+bool exportShared(const std::vector<Source>& sources, ExportFormat format, size_t threadCount, size_t capacity,
+                  std::string& data)
+{
+    std::FILE* file = std::tmpfile();
+    if (!file) {
+        std::printf("无法创建临时文件\n");
+        return false;
+    }
+    {
+        BufferedWriter header(file);
+        TokenExporter(header, format).writeHeader();
+    }
+    std::mutex lock;
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threadCount; t++) {
+        threads.emplace_back([&sources, &lock, file, format, threadCount, capacity, t]() {
+            BufferedWriter writer(file, &lock, capacity);
+            TokenExporter exporter(writer, format);
+            for (size_t i = t; i < sources.size(); i += threadCount) {
+                exporter.exportSource(sources[i].path, sources[i].text);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    bool ok = readFile(file, data);
+    std::fclose(file);
+    if (!ok) {
+        std::printf("读回临时文件失败\n");
+    }
+    return ok;
+}
+
+// 与 tokenize() 的结果逐个比较
+bool checkRecords(const Source& source, const std::vector<Record>& records)
+{
+    RustLexer lexer(source.text);
+    const TokenStream tokens = lexer.tokenize();
+    const LineIndex lines(source.text);
+    if (records.size() != tokens.size()) {
+        std::printf("%s：导出 %zu 个单词，应为 %zu 个\n", source.path.c_str(), records.size(), tokens.size());
+        return false;
+    }
+    for (size_t i = 0; i < tokens.size(); i++) {
+        const Record& record = records[i];
+        const size_t offset = tokens.offset(i);
+        if (record.kind != KIND_NAMES[size_t(tokens.type(i))] || record.offset != offset
+            || record.line != uint64_t(lines.line(offset))
+            || record.column != uint64_t(lines.column(offset, source.text))
+            || record.lexeme != tokens.view().text(i, source.text)) {
+            std::printf("%s：第 %zu 个单词不一致：%s @%ju 第 %ju 行第 %ju 列，词素 %zu 字节\n",
+                        source.path.c_str(), i, record.kind.c_str(), static_cast<uintmax_t>(record.offset),
+                        static_cast<uintmax_t>(record.line), static_cast<uintmax_t>(record.column),
+                        record.lexeme.size());
+            return false;
+        }
+    }
+    return true;
+}
+
+bool checkFormat(const std::vector<Source>& sources, ExportFormat format, size_t threadCount, size_t capacity)
+{
+    std::string data;
+    if (!exportShared(sources, format, threadCount, capacity, data)) {
+        return false;
+    }
+
+    RecordsByFile byFile;
+    bool decoded = false;
+    switch (format) {
+    case ExportFormat::JsonLines:
+        decoded = decodeJsonLines(data, byFile);
+        break;
+    case ExportFormat::Csv:
+        decoded = decodeCsv(data, byFile);
+        break;
+    case ExportFormat::Binary:
+        decoded = decodeBinary(data, byFile);
+        break;
+    }
+    if (!decoded) {
+        std::printf("（%s，%zu 个线程，缓冲区 %zu 字节）\n", exportFormatName(format), threadCount, capacity);
+        return false;
+    }
+    for (const Source& source : sources) {
+        if (!checkRecords(source, byFile[source.path])) {
+            std::printf("（%s，%zu 个线程，缓冲区 %zu 字节）\n", exportFormatName(format), threadCount, capacity);
+            return false;
+        }
+    }
+    if (byFile.size() != sources.size()) {
+        std::printf("%s：读回 %zu 个文件，应为 %zu 个\n", exportFormatName(format), byFile.size(), sources.size());
+        return false;
+    }
+    std::printf("%s：%zu 个线程，缓冲区 %zu 字节，%zu 个文件，%zu 字节，全部一致\n",
+                exportFormatName(format), threadCount, capacity, sources.size(), data.size());
+    return true;
+}
+
+void printUsage(const char* program)
+{
+    std::printf("用法：%s [--threads N] [--files N]\n", program);
+}
+
+bool parseOptions(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            std::exit(0);
+        }
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "%s 需要一个参数\n", arg.c_str());
+            return false;
+        }
+        const char* value = argv[++i];
+        if (arg == "--threads") {
+            options.threads = std::strtoul(value, nullptr, 10);
+        } else if (arg == "--files") {
+            options.files = std::strtoul(value, nullptr, 10);
+        } else {
+            std::fprintf(stderr, "未知选项：%s\n", arg.c_str());
+            return false;
+        }
+    }
+    if (options.threads == 0 || options.files == 0) {
+        std::fprintf(stderr, "--threads 和 --files 必须为正数\n");
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    std::vector<Source> small;
+    for (size_t i = 0; i < sizeof(SMALL_SOURCES) / sizeof(SMALL_SOURCES[0]); i++) {
+        small.push_back({SMALL_PATHS[i], SMALL_SOURCES[i]});
+    }
+    std::vector<Source> large = small;
+    for (size_t i = 0; i < options.files; i++) {
+        large.push_back({"src/file" + std::to_string(i) + ".rs", generate(i)});
+    }
+
+    const ExportFormat formats[] = {ExportFormat::JsonLines, ExportFormat::Csv, ExportFormat::Binary};
+    for (ExportFormat format : formats) {
+        if (!checkFormat(small, format, 1, SMALL_CAPACITY)
+            || !checkFormat(large, format, options.threads, BufferedWriter::DEFAULT_CAPACITY)) {
+            return 1;
+        }
+    }
+    return 0;
+}
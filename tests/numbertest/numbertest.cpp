@@ -0,0 +1,200 @@
+// 数字字面量解码测试：表中每个词素经 decodeNumber() 解码后，NumericValue::toString() 和进制
+// 必须与预期一致。表覆盖 SWAR 分组的边界（8、19、20位数字，下划线落在分组中间）、
+// 64位和128位的进位、有符号类型的上限（128i8、i128 的最小值的绝对值）、f32 的溢出和格式错误。
+// 编译器支持 unsigned __int128 时，另外用固定种子生成带下划线的十进制和十六进制数与之比较。
+// 任何不一致都打印词素、实际值和预期值并返回非零。
+//
+// 用法：numbertest [--random N]
+//   --random <N>     随机比较的个数（默认 200000）
+
+#include "numericliteral.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+namespace {
+
+struct Case {
+    const char* lexeme;
+    const char* expected;   // NumericValue::toString()
+    unsigned radix;
+};
+
+const Case CASES[] = {
+    // 十进制：SWAR 每8个数字一组，前19个数字在64位中累加，之后按128位
+    {"0", "0", 10},
+    {"7", "7", 10},
+    {"12345678", "12345678", 10},
+    {"123456789", "123456789", 10},
+    {"1234567890123456789", "1234567890123456789", 10},
+    {"12345678901234567890", "12345678901234567890", 10},
+    {"18446744073709551615", "18446744073709551615", 10},
+    {"18446744073709551616", "18446744073709551616", 10},
+    {"99999999999999999999999999", "99999999999999999999999999", 10},
+    {"340282366920938463463374607431768211455", "340282366920938463463374607431768211455", 10},
+    {"340282366920938463463374607431768211456", "0，溢出", 10},
+    {"1000000000000000000000000000000000000000", "0，溢出", 10},
+    // 下划线打断8位分组
+    {"1_000_000", "1000000", 10},
+    {"1_2345678_9", "123456789", 10},
+    {"12345678_", "12345678", 10},
+    {"1234_5678_9012_3456_7890_1234", "123456789012345678901234", 10},
+    {"0000000000000000000000000042", "42", 10},
+    // 整数后缀的范围；有符号类型允许到 2^(n-1)，负号是单独的单词
+    {"255u8", "255 (u8)", 10},
+    {"256u8", "256 (u8)，溢出", 10},
+    {"128i8", "128 (i8)", 10},
+    {"129i8", "129 (i8)，溢出", 10},
+    {"65535u16", "65535 (u16)", 10},
+    {"32768i16", "32768 (i16)", 10},
+    {"32769i16", "32769 (i16)，溢出", 10},
+    {"4294967296u32", "4294967296 (u32)，溢出", 10},
+    {"2147483648i32", "2147483648 (i32)", 10},
+    {"9223372036854775808i64", "9223372036854775808 (i64)", 10},
+    {"9223372036854775809i64", "9223372036854775809 (i64)，溢出", 10},
+    {"18446744073709551615usize", "18446744073709551615 (usize)", 10},
+    {"18446744073709551616usize", "18446744073709551616 (usize)，溢出", 10},
+    {"9223372036854775809isize", "9223372036854775809 (isize)，溢出", 10},
+    {"170141183460469231731687303715884105728i128", "170141183460469231731687303715884105728 (i128)", 10},
+    {"170141183460469231731687303715884105729i128", "170141183460469231731687303715884105729 (i128)，溢出", 10},
+    {"340282366920938463463374607431768211455u128", "340282366920938463463374607431768211455 (u128)", 10},
+    {"1_u64", "1 (u64)", 10},
+    // 二/八/十六进制：前 64/bits 个数字在64位中累加，之后按128位移位
+    {"0xff", "255", 16},
+    {"0XFF", "255", 16},
+    {"0xFFFF_FFFF_FFFF_FFFF", "18446744073709551615", 16},
+    {"0x1_0000_0000_0000_0000", "18446744073709551616", 16},
+    {"0xffffffffffffffffffffffffffffffff", "340282366920938463463374607431768211455", 16},
+    {"0x1ffffffffffffffffffffffffffffffff", "0，溢出", 16},
+    {"0x0000000000000000000000000000000001", "1", 16},
+    {"0x1f32", "7986", 16},
+    {"0x80i8", "128 (i8)", 16},
+    {"0x81i8", "129 (i8)，溢出", 16},
+    {"0x100u8", "256 (u8)，溢出", 16},
+    {"0o777", "511", 8},
+    {"0o1777777777777777777777", "18446744073709551615", 8},
+    {"0o2000000000000000000000", "18446744073709551616", 8},
+    {"0b1010_1010u8", "170 (u8)", 2},
+    {"0b1111111111111111111111111111111111111111111111111111111111111111", "18446744073709551615", 2},
+    {"0b10000000000000000000000000000000000000000000000000000000000000000", "18446744073709551616", 2},
+    // 格式错误：没有数字、后缀不合法、非十进制的浮点后缀
+    {"0x", "0，格式错误", 16},
+    {"0b_", "0，格式错误", 2},
+    {"0b102", "2，格式错误", 2},
+    {"1abc", "1，格式错误", 10},
+    {"1.5u8", "1.5，格式错误", 10},
+    {"0b1f32", "1 (f32)，格式错误", 2},
+    // 浮点数：from_chars 之前去掉下划线；f32 后缀舍入到单精度
+    {"1.5", "1.5", 10},
+    {"1.", "1", 10},
+    {"1e10", "10000000000", 10},
+    {"2.5E-3", "0.0025000000000000001", 10},
+    {"1_000.000_1", "1000.0001", 10},
+    {"1e+2_0", "1e+20", 10},
+    {"1f32", "1 (f32)", 10},
+    {"2f64", "2 (f64)", 10},
+    {"0.1f32", "0.10000000149011612 (f32)", 10},
+    {"0.1f64", "0.10000000000000001 (f64)", 10},
+    {"3.4028235e38f32", "3.4028234663852886e+38 (f32)", 10},
+    {"3.5e38f32", "inf (f32)，溢出", 10},
+    {"1e39f32", "inf (f32)，溢出", 10},
+    {"1e308", "1e+308", 10},
+    {"1e400", "0，溢出", 10},
+};
+
+bool checkCases()
+{
+    size_t failures = 0;
+    for (const Case& test : CASES) {
+        NumericValue value = decodeNumber(test.lexeme);
+        std::string actual = value.toString();
+        if (actual != test.expected || value.radix != test.radix) {
+            std::printf("%s：得到 %s（%u 进制），应为 %s（%u 进制）\n", test.lexeme, actual.c_str(),
+                        unsigned(value.radix), test.expected, test.radix);
+            failures++;
+        }
+    }
+    std::printf("边界用例：%zu 个，失败 %zu 个\n", sizeof(CASES) / sizeof(CASES[0]), failures);
+    return failures == 0;
+}
+
+#if defined(__SIZEOF_INT128__)
+
+using U128 = unsigned __int128;
+
+std::string toDecimal(U128 value)
+{
+    std::string digits;
+    do {
+        digits.insert(digits.begin(), char('0' + unsigned(value % 10)));
+        value /= 10;
+    } while (value != 0);
+    return digits;
+}
+
+// 随机位数的 u128 值按十进制和十六进制写出，随机插入下划线，与 unsigned __int128 的结果比较
+bool checkRandom(int count)
+{
+    std::mt19937_64 rng(20240521);
+    for (int i = 0; i < count; i++) {
+        U128 value = (U128(rng()) << 64) | rng();
+        value >>= rng() % 128;
+
+        bool hex = rng() % 2 == 0;
+        std::string digits = hex ? std::string() : toDecimal(value);
+        if (hex) {
+            static const char HEX[] = "0123456789abcdef";
+            U128 rest = value;
+            do {
+                digits.insert(digits.begin(), HEX[unsigned(rest & 0xF)]);
+                rest >>= 4;
+            } while (rest != 0);
+        }
+        std::string lexeme = hex ? "0x" : "";
+        for (char c : digits) {
+            lexeme += c;
+            if (rng() % 6 == 0) {
+                lexeme += '_';
+            }
+        }
+
+        NumericValue decoded = decodeNumber(lexeme);
+        U128 actual = (U128(decoded.integer.high) << 64) | decoded.integer.low;
+        if (actual != value || decoded.overflow || decoded.malformed) {
+            std::printf("%s：得到 %s，应为 %s\n", lexeme.c_str(), decoded.toString().c_str(),
+                        toDecimal(value).c_str());
+            return false;
+        }
+    }
+    std::printf("随机比较：%d 个，全部一致\n", count);
+    return true;
+}
+
+#endif
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int random = 200000;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--random" && i + 1 < argc) {
+            random = std::atoi(argv[++i]);
+        } else {
+            std::printf("用法：%s [--random N]\n", argv[0]);
+            return arg == "-h" || arg == "--help" ? 0 : 2;
+        }
+    }
+
+    bool ok = checkCases();
+#if defined(__SIZEOF_INT128__)
+    ok = checkRandom(random) && ok;
+#else
+    (void)random;
+#endif
+    return ok ? 0 : 1;
+}
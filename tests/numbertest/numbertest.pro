@@ -0,0 +1,11 @@
+TEMPLATE = app
+TARGET = numbertest
+
+QT -= core gui
+CONFIG += console c++17
+CONFIG -= app_bundle
+
+include(../../lexer/lexer.pri)
+
+SOURCES += \
+    numbertest.cpp
@@ -0,0 +1,221 @@
+// 并行分析一致性测试：用固定种子随机拼接块注释、字符串、字符、生命周期和原始字符串等
+// 容易跨越分块边界的片段，对每段源码以从1字节起的各种分块大小运行 tokenizeParallel()，
+// 逐个单词与串行的 tokenize() 比较。任何不一致都打印最短的失败分块和源码并返回非零。
+// 另外检查 parallelFor() 把任务中的异常抛给本次调用方，而不是留给之后的 wait()。
+//
+// 用法：paralleltest [选项]
+//   --iterations <N> 随机源码的段数（默认 400）
+//   --seed <N>       生成器种子（默认 20240521）
+//   --threads <N>    线程池大小（默认 4）
+
+#include "lexstats.h"
+#include "rustlexer.h"
+#include "threadpool.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Random = std::mt19937_64;
+
+// 每个片段都至少包含一个跨越多字节的结构。tokenizeParallel() 只在换行之后切分，
+// 所以块注释、字符串和字符都有内部带换行的写法，让分块边界落在单词中间
+const char* const FRAGMENTS[] = {
+    // 块注释：嵌套、文档、未闭合和看似结束的星号
+    "/* a */", "/* /* nested */ still */", "/** doc */", "/*! inner */", "/***/", "/**/",
+    "/* * / */", "/* \"quote\" 'c' */", "/*", "*/", "/* 中文注释 */",
+    "/* a\n b */", "/*\n/* x\n*/\n*/", "/**\n * doc\n */", "/* \"\n */", "/* '\n */",
+    // 行注释
+    "// line\n", "/// doc\n", "//! inner\n", "// \"不闭合\n",
+    // 字符串：转义、续行、字节串、C串和未闭合
+    "\"abc\"", "\"a\\\"b\"", "\"\\\\\"", "\"line\\\ncontinued\"", "b\"bytes\\x7f\"",
+    "c\"cstr\"", "\"\\u{1F600}\"", "\"多字节→\"", "\"", "\"open\n",
+    "\"multi\nline\"", "\"\n\"", "\"/*\n*/\"", "\"a\\\n\\\"\n\"", "b\"\n\"",
+    // 原始字符串
+    "r\"raw\"", "r#\"has \"quote\" inside\"#", "br##\"x\"#y\"##", "r#\"", "r##\"a\"#",
+    "r#\"\n\"\n\"#", "r\"\n// x\n\"",
+    // 字符和生命周期
+    "'a'", "'\\''", "'\\\\'", "'\\n'", "'\\u{7FFF}'", "b'x'", "'é'", "'中'",
+    "'a", "'static", "&'a str", "'", "'\\", "'\n'", "'\\\n'", "'a\n'",
+    // 普通代码
+    "fn", "let x = 1;", "a::b", "x.0.1", "1.0e-3", "0x_ff_u8", "..=", "->", "=>",
+    "宽度", "r#type", "#[derive(Debug)]", "\n", " ", "\t", "\\",
+};
+
+const size_t FRAGMENT_COUNT = sizeof(FRAGMENTS) / sizeof(FRAGMENTS[0]);
+
+struct Options {
+    int iterations = 400;
+    uint64_t seed = 20240521;
+    size_t threads = 4;
+};
+
+// 片段之间随机直接粘连、加空格或换行；换行越多，可选的切分点越多
+std::string generate(Random& rng)
+{
+    std::string out;
+    const size_t pieces = 1 + rng() % 24;
+    for (size_t i = 0; i < pieces; i++) {
+        out += FRAGMENTS[rng() % FRAGMENT_COUNT];
+        switch (rng() % 4) {
+        case 0:
+            break;
+        case 1:
+            out += ' ';
+            break;
+        default:
+            out += '\n';
+            break;
+        }
+    }
+    return out;
+}
+
+// 找出第一个不一致的单词下标；完全一致时返回 SIZE_MAX
+size_t firstDifference(const TokenStream& expected, const TokenStream& actual)
+{
+    const size_t count = std::min(expected.size(), actual.size());
+    for (size_t i = 0; i < count; i++) {
+        if (expected.offset(i) != actual.offset(i) || expected.length(i) != actual.length(i)
+            || expected.type(i) != actual.type(i) || expected.op(i) != actual.op(i)) {
+            return i;
+        }
+    }
+    return expected.size() == actual.size() ? SIZE_MAX : count;
+}
+
+void printToken(const char* label, const TokenStream& tokens, size_t index)
+{
+    if (index >= tokens.size()) {
+        std::printf("  %s: <无>\n", label);
+        return;
+    }
+    std::printf("  %s: %s @%zu 长度 %zu\n", label, tokenTypeName(tokens.type(index)),
+                tokens.offset(index), tokens.length(index));
+}
+
+// 分块大小：从1字节到整段源码逐个尝试，覆盖每个片段被切在每个字节处的情况
+bool checkSource(ThreadPool& pool, const std::string& source)
+{
+    RustLexer lexer(source);
+    const TokenStream expected = lexer.tokenize();
+    for (size_t chunk = 1; chunk <= source.size() + 1; chunk++) {
+        const TokenStream actual = lexer.tokenizeParallel(pool, chunk);
+        const size_t index = firstDifference(expected, actual);
+        if (index == SIZE_MAX) {
+            continue;
+        }
+        std::printf("不一致：分块 %zu 字节，第 %zu 个单词（串行 %zu 个，并行 %zu 个）\n",
+                    chunk, index, expected.size(), actual.size());
+        printToken("串行", expected, index);
+        printToken("并行", actual, index);
+        std::printf("源码（%zu 字节）：\n%s\n", source.size(), source.c_str());
+        return false;
+    }
+    return true;
+}
+
+// 一批任务中抛出的异常必须从这次 parallelFor() 重新抛出，线程池上的其他等待方不受影响
+bool checkErrorPropagation(ThreadPool& pool)
+{
+    bool thrown = false;
+    try {
+        pool.parallelFor(64, [](size_t i) {
+            if (i == 17) {
+                throw std::runtime_error("任务失败");
+            }
+        });
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    if (!thrown) {
+        std::printf("parallelFor() 没有重新抛出任务中的异常\n");
+        return false;
+    }
+    try {
+        pool.submit([]() {});
+        pool.wait();
+    } catch (...) {
+        std::printf("parallelFor() 的异常留给了之后的 wait()\n");
+        return false;
+    }
+    return true;
+}
+
+void printUsage(const char* program)
+{
+    std::printf("用法：%s [--iterations N] [--seed N] [--threads N]\n", program);
+}
+
+bool parseOptions(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            std::exit(0);
+        }
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "%s 需要一个参数\n", arg.c_str());
+            return false;
+        }
+        const char* value = argv[++i];
+        if (arg == "--iterations") {
+            options.iterations = std::atoi(value);
+        } else if (arg == "--seed") {
+            options.seed = std::strtoull(value, nullptr, 10);
+        } else if (arg == "--threads") {
+            options.threads = std::strtoul(value, nullptr, 10);
+        } else {
+            std::fprintf(stderr, "未知选项：%s\n", arg.c_str());
+            return false;
+        }
+    }
+    if (options.iterations <= 0 || options.threads == 0) {
+        std::fprintf(stderr, "--iterations 和 --threads 必须为正数\n");
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    ThreadPool pool(options.threads);
+    if (!checkErrorPropagation(pool)) {
+        return 1;
+    }
+
+    // 先单独检查每个片段，再检查随机拼接的源码
+    size_t sources = 0;
+    for (size_t i = 0; i < FRAGMENT_COUNT; i++) {
+        sources++;
+        if (!checkSource(pool, FRAGMENTS[i])) {
+            return 1;
+        }
+    }
+    Random rng(options.seed);
+    for (int i = 0; i < options.iterations; i++) {
+        sources++;
+        if (!checkSource(pool, generate(rng))) {
+            std::printf("种子 %llu，第 %d 段\n", static_cast<unsigned long long>(options.seed), i);
+            return 1;
+        }
+    }
+    std::printf("通过：%zu 段源码，全部分块大小一致\n", sources);
+    return 0;
+}
@@ -0,0 +1,11 @@
+TEMPLATE = app
+TARGET = paralleltest
+
+QT -= core gui
+CONFIG += console c++17 thread
+CONFIG -= app_bundle
+
+include(../../lexer/lexer.pri)
+
+SOURCES += \
+    paralleltest.cpp
@@ -0,0 +1,367 @@
+// rustindex：跨文件的单词倒排索引工具。
+// build 分析目录下的全部 .rs 文件并写出索引文件；update 只重新分析变化的文件；
+// query 在映射的索引文件上查找标识符、宏名、生命周期或字面量的全部出现位置，不重新分析源码。
+
+#include "lineindex.h"
+#include "mappedfile.h"
+#include "threadpool.h"
+#include "tokencache.h"
+#include "tokenindex.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct KindName {
+    const char* name;
+    TokenType type;
+    const char* label;
+};
+
+// 建立索引的各类单词在命令行上的名称
+const KindName KIND_NAMES[] = {
+    {"ident", TokenType::IDENTIFIER, "标识符"},
+    {"macro", TokenType::MACRO_CALL, "宏调用名"},
+    {"lifetime", TokenType::LIFETIME, "生命周期"},
+    {"int", TokenType::INTEGER_LITERAL, "整数字面量"},
+    {"float", TokenType::FLOAT_LITERAL, "浮点数字面量"},
+    {"string", TokenType::STRING_LITERAL, "字符串字面量"},
+    {"char", TokenType::CHAR_LITERAL, "字符字面量"},
+};
+
+const KindName* kindByName(const std::string& name)
+{
+    for (const KindName& kind : KIND_NAMES) {
+        if (name == kind.name) {
+            return &kind;
+        }
+    }
+    return nullptr;
+}
+
+const char* kindLabel(uint8_t type)
+{
+    for (const KindName& kind : KIND_NAMES) {
+        if (uint8_t(kind.type) == type) {
+            return kind.label;
+        }
+    }
+    return "?";
+}
+
+struct Options {
+    std::string command;
+    size_t threads = 0;
+    std::string indexPath;
+    std::vector<std::string> paths;     // build/update 的文件或目录，query 的词素
+    const KindName* kind = nullptr;
+    bool count = false;
+    bool offsets = false;
+};
+
+void printUsage(const char* program)
+{
+    std::printf("用法：\n"
+                "  %s build [-j N] -o <索引文件> <文件或目录>...\n"
+                "      分析全部 .rs 文件，写出新的索引\n"
+                "  %s update [-j N] <索引文件> [<文件或目录>...]\n"
+                "      只重新分析大小、修改时间和内容变化了的文件，删除已不存在的文件；\n"
+                "      不给出路径时检查索引中已有的文件\n"
+                "  %s query [--kind <类型>] [-c|--count] [--offsets] <索引文件> <词素>...\n"
+                "      输出每次出现的 路径:行:列: 所在行；-c 只输出次数和文件数，\n"
+                "      --offsets 输出 路径@字节偏移，不读取源文件\n"
+                "  %s info <索引文件>\n"
+                "      输出文件数、词条数和各类型的出现次数\n"
+                "类型：ident macro lifetime int float string char（字符串和字符字面量的词素包含引号）\n"
+                "选项：\n"
+                "  -j, --jobs <N>   工作线程数（默认为硬件线程数）\n"
+                "  -h, --help       显示本帮助\n",
+                program, program, program, program);
+}
+
+bool parseOptions(int argc, char* argv[], Options& options)
+{
+    if (argc < 2) {
+        return false;
+    }
+    options.command = argv[1];
+    if (options.command == "-h" || options.command == "--help") {
+        printUsage(argv[0]);
+        std::exit(0);
+    }
+    if (options.command != "build" && options.command != "update" && options.command != "query"
+        && options.command != "info") {
+        std::fprintf(stderr, "未知命令：%s\n", options.command.c_str());
+        return false;
+    }
+
+    std::vector<std::string> positional;
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            std::exit(0);
+        } else if (arg == "-j" || arg == "--jobs" || arg == "-o" || arg == "--output" || arg == "--kind") {
+            if (i + 1 >= argc) {
+                std::fprintf(stderr, "%s 需要一个参数\n", arg.c_str());
+                return false;
+            }
+            std::string value = argv[++i];
+            if (arg == "-j" || arg == "--jobs") {
+                options.threads = std::strtoul(value.c_str(), nullptr, 10);
+            } else if (arg == "--kind") {
+                options.kind = kindByName(value);
+                if (!options.kind) {
+                    std::fprintf(stderr, "未知的类型：%s\n", value.c_str());
+                    return false;
+                }
+            } else {
+                options.indexPath = value;
+            }
+        } else if (arg == "-c" || arg == "--count") {
+            options.count = true;
+        } else if (arg == "--offsets") {
+            options.offsets = true;
+        } else if (!arg.empty() && arg[0] == '-' && arg.size() > 1) {
+            std::fprintf(stderr, "未知选项：%s\n", arg.c_str());
+            return false;
+        } else {
+            positional.push_back(arg);
+        }
+    }
+
+    // build 的索引文件由 -o 给出，其余命令的第一个位置参数是索引文件
+    if (options.command != "build" && options.indexPath.empty() && !positional.empty()) {
+        options.indexPath = positional.front();
+        positional.erase(positional.begin());
+    }
+    options.paths = std::move(positional);
+    if (options.indexPath.empty()) {
+        std::fprintf(stderr, "没有给出索引文件\n");
+        return false;
+    }
+    if ((options.command == "build" || options.command == "query") && options.paths.empty()) {
+        std::fprintf(stderr, "%s 需要至少一个%s\n", options.command.c_str(),
+                     options.command == "build" ? "文件或目录" : "词素");
+        return false;
+    }
+    return true;
+}
+
+// 收集所有 .rs 文件；直接给出的文件不检查扩展名
+std::vector<std::string> collectFiles(const std::vector<std::string>& paths)
+{
+    std::vector<std::string> files;
+    for (const std::string& path : paths) {
+        std::error_code ec;
+        if (fs::is_directory(path, ec)) {
+            for (fs::recursive_directory_iterator it(path, fs::directory_options::skip_permission_denied, ec), end;
+                 it != end; it.increment(ec)) {
+                if (ec) {
+                    break;
+                }
+                if (it->is_regular_file(ec) && it->path().extension() == ".rs") {
+                    files.push_back(it->path().u8string());
+                }
+            }
+        } else {
+            files.push_back(path);
+        }
+    }
+    return files;
+}
+
+double millisecondsSince(std::chrono::steady_clock::time_point begin)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+int buildOrUpdate(const Options& options)
+{
+    auto begin = std::chrono::steady_clock::now();
+    std::unique_ptr<TokenIndexBuilder> builder;
+    if (options.command == "update") {
+        TokenIndex existing;
+        if (!existing.open(options.indexPath)) {
+            std::fprintf(stderr, "%s\n", existing.errorString().c_str());
+            return 1;
+        }
+        // 复制完成后即关闭映射，写出时才能替换原文件
+        builder = std::make_unique<TokenIndexBuilder>(existing);
+    } else {
+        builder = std::make_unique<TokenIndexBuilder>();
+    }
+    double loadMs = millisecondsSince(begin);
+
+    std::vector<std::string> files = options.paths.empty() ? builder->filePaths() : collectFiles(options.paths);
+    ThreadPool pool(options.threads);
+    auto updateBegin = std::chrono::steady_clock::now();
+    TokenIndexUpdate result = builder->update(files, pool);
+    double updateMs = millisecondsSince(updateBegin);
+    for (const std::string& error : result.errors) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+    }
+
+    auto saveBegin = std::chrono::steady_clock::now();
+    if (!builder->save(options.indexPath)) {
+        std::fprintf(stderr, "无法写入索引文件：%s\n", options.indexPath.c_str());
+        return 1;
+    }
+    double saveMs = millisecondsSince(saveBegin);
+
+    std::error_code ec;
+    uintmax_t indexSize = fs::file_size(fs::u8path(options.indexPath), ec);
+    std::printf("%zu 个文件：新增 %zu，更新 %zu，删除 %zu，未变 %zu，失败 %zu\n",
+                builder->fileCount(), result.added, result.updated, result.removed,
+                result.unchanged + result.touched, result.failed);
+    std::printf("分析 %.1f MB，%zu 个线程；读入旧索引 %.1f ms，检查和分析 %.1f ms，写出 %.1f ms\n",
+                double(result.bytesLexed) / 1e6, pool.threadCount(), loadMs, updateMs, saveMs);
+    std::printf("索引文件 %s：%.1f MB\n", options.indexPath.c_str(), double(indexSize) / 1e6);
+    return result.failed == 0 ? 0 : 1;
+}
+
+// 某个源文件的行索引，同一文件的多次出现只读取一次；文件已变化时不再计算行列号
+struct SourceFile {
+    uint32_t id = UINT32_MAX;
+    MappedFile mapped;
+    LineIndex lines;
+    bool current = false;
+};
+
+void printOccurrence(const TokenIndex& index, SourceFile& source, const Posting& posting)
+{
+    std::string_view path = index.filePath(posting.file);
+    if (source.id != posting.file) {
+        source.id = posting.file;
+        source.current = source.mapped.open(std::string(path))
+            && source.mapped.size() == index.file(posting.file).size
+            && contentHash(source.mapped.view()) == index.file(posting.file).contentHash;
+        if (source.current) {
+            source.lines.build(source.mapped.view());
+        } else {
+            std::fprintf(stderr, "文件已变化或无法读取，只输出偏移（请运行 rustindex update）：%.*s\n",
+                         int(path.size()), path.data());
+        }
+    }
+    if (!source.current) {
+        std::printf("%.*s@%u\n", int(path.size()), path.data(), posting.offset);
+        return;
+    }
+
+    int line = source.lines.line(posting.offset);
+    std::string_view text = source.mapped.view();
+    size_t lineStart = source.lines.lineStart(line);
+    size_t lineEnd = text.find('\n', lineStart);
+    std::string_view content = text.substr(lineStart, (lineEnd == std::string_view::npos ? text.size() : lineEnd)
+                                                          - lineStart);
+    if (!content.empty() && content.back() == '\r') {
+        content.remove_suffix(1);
+    }
+    std::printf("%.*s:%d:%d: %.*s\n", int(path.size()), path.data(), line,
+                source.lines.column(posting.offset, text) + 1, int(content.size()), content.data());
+}
+
+int query(const Options& options)
+{
+    TokenIndex index;
+    if (!index.open(options.indexPath)) {
+        std::fprintf(stderr, "%s\n", index.errorString().c_str());
+        return 1;
+    }
+
+    bool found = false;
+    for (const std::string& lexeme : options.paths) {
+        // 同一词素可能有多个类型（如 foo 与 foo!），合并后按文件和偏移排序
+        std::vector<Posting> postings;
+        for (const TokenIndexTerm& term : index.find(lexeme)) {
+            if (options.kind && term.kind != uint8_t(options.kind->type)) {
+                continue;
+            }
+            found = true;
+            if (options.count) {
+                std::printf("%s\t%s\t%llu 次\t%u 个文件\n", lexeme.c_str(), kindLabel(term.kind),
+                            static_cast<unsigned long long>(term.occurrences), term.fileCount);
+                continue;
+            }
+            if (!index.postings(term, postings)) {
+                std::fprintf(stderr, "索引文件已损坏：%s\n", options.indexPath.c_str());
+                return 1;
+            }
+        }
+        std::sort(postings.begin(), postings.end(), [](const Posting& a, const Posting& b) {
+            return a.file != b.file ? a.file < b.file : a.offset < b.offset;
+        });
+
+        SourceFile source;
+        for (const Posting& posting : postings) {
+            if (options.offsets) {
+                std::string_view path = index.filePath(posting.file);
+                std::printf("%.*s@%u\n", int(path.size()), path.data(), posting.offset);
+            } else {
+                printOccurrence(index, source, posting);
+            }
+        }
+    }
+    return found ? 0 : 1;
+}
+
+int info(const Options& options)
+{
+    TokenIndex index;
+    if (!index.open(options.indexPath)) {
+        std::fprintf(stderr, "%s\n", index.errorString().c_str());
+        return 1;
+    }
+
+    uint64_t sourceBytes = 0;
+    for (uint32_t id = 0; id < index.fileCount(); id++) {
+        sourceBytes += index.file(id).size;
+    }
+    std::printf("%zu 个文件（%.1f MB 源码），%zu 个词条，%llu 次出现，索引 %.1f MB\n",
+                index.fileCount(), double(sourceBytes) / 1e6, index.termCount(),
+                static_cast<unsigned long long>(index.postingCount()), double(index.byteSize()) / 1e6);
+
+    for (const KindName& kind : KIND_NAMES) {
+        size_t terms = 0;
+        uint64_t occurrences = 0;
+        for (const TokenIndexTerm* term = index.termsBegin(); term != index.termsEnd(); ++term) {
+            if (term->kind == uint8_t(kind.type)) {
+                terms++;
+                occurrences += term->occurrences;
+            }
+        }
+        std::printf("  %-8s %10zu 个词条 %12llu 次出现  %s\n", kind.name, terms,
+                    static_cast<unsigned long long>(occurrences), kind.label);
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    if (options.command == "query") {
+        return query(options);
+    }
+    if (options.command == "info") {
+        return info(options);
+    }
+    return buildOrUpdate(options);
+}
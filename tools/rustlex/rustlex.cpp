@@ -0,0 +1,548 @@
+// rustlex：命令行词法分析工具。
+// 递归查找目录下的所有 .rs 文件，内存映射后在工作窃取线程池上并行分析，
+// 输出每个文件及总计的单词数和吞吐量，也可以把全部单词导出为 JSON Lines、CSV 或二进制。
+
+#include "diagnostics.h"
+#include "lineindex.h"
+#include "mappedfile.h"
+#include "rustlexer.h"
+#include "symboltable.h"
+#include "threadpool.h"
+#include "tokenarena.h"
+#include "tokencache.h"
+#include "tokenexport.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// 超过此大小的单个文件在块间并行分析，避免一个大文件占住一个线程而其余线程空闲
+constexpr uintmax_t SPLIT_FILE_SIZE = 16 * 1024 * 1024;
+
+struct Options {
+    size_t threads = 0;
+    bool quiet = false;
+    bool stats = false;
+    bool diagnostics = false;
+    size_t symbols = 0;         // 输出出现最多的标识符个数，0 为不驻留
+    std::string cacheDirectory;
+    bool exportTokens = false;
+    ExportFormat exportFormat = ExportFormat::JsonLines;
+    std::string outputPath;
+    TokenTypeMask types = ALL_TOKEN_TYPES;  // 计数、驻留和导出的单词类型
+    std::vector<std::string> paths;
+};
+
+struct TypeName {
+    const char* name;
+    TokenType type;
+};
+
+// --kinds 中的类型名称
+const TypeName TYPE_NAMES[] = {
+    {"keyword", TokenType::KEYWORD},
+    {"ident", TokenType::IDENTIFIER},
+    {"int", TokenType::INTEGER_LITERAL},
+    {"float", TokenType::FLOAT_LITERAL},
+    {"string", TokenType::STRING_LITERAL},
+    {"char", TokenType::CHAR_LITERAL},
+    {"operator", TokenType::OPERATOR},
+    {"delimiter", TokenType::DELIMITER},
+    {"comment", TokenType::COMMENT},
+    {"macro", TokenType::MACRO_CALL},
+    {"lifetime", TokenType::LIFETIME},
+    {"unknown", TokenType::UNKNOWN},
+};
+
+// 解析逗号分隔的类型列表
+bool parseTypes(const std::string& list, TokenTypeMask& types)
+{
+    types = 0;
+    size_t begin = 0;
+    while (begin <= list.size()) {
+        size_t end = list.find(',', begin);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        std::string name = list.substr(begin, end - begin);
+        const TypeName* found = nullptr;
+        for (const TypeName& entry : TYPE_NAMES) {
+            if (name == entry.name) {
+                found = &entry;
+            }
+        }
+        if (!found) {
+            std::fprintf(stderr, "未知的单词类型：%s\n", name.c_str());
+            return false;
+        }
+        types |= tokenTypeBit(found->type);
+        begin = end + 1;
+    }
+    return true;
+}
+
+// 导出目标：各工作线程用自己的缓冲区攒满一块后，持锁一次写入共享的输出文件
+struct ExportTarget {
+    std::FILE* file = nullptr;
+    std::mutex lock;
+    ExportFormat format = ExportFormat::JsonLines;
+};
+
+struct FileResult {
+    std::string path;
+    uintmax_t size = 0;
+    size_t tokens = 0;
+    TokenCounts counts;         // 导出时不按类型统计
+    double seconds = 0.0;
+    bool ok = false;
+    std::string error;
+    LexStats stats;
+    std::vector<std::string> diagnostics;   // 已格式化为 "路径:行:列: 说明"
+};
+
+void printUsage(const char* program)
+{
+    std::printf("用法：%s [选项] <文件或目录>...\n"
+                "  -j, --jobs <N>   工作线程数（默认为硬件线程数）\n"
+                "  -q, --quiet      只输出总计，不逐个列出文件\n"
+                "  --cache <目录>   使用以内容哈希为键的单词缓存，未变化的文件不再分析\n"
+                "  --stats          输出各类单词数量和各子扫描器的字节数与采样耗时\n"
+                "                   （词法分析库须以 CONFIG+=lexer_stats 构建）\n"
+                "  --symbols <N>    把所有文件的标识符驻留到一张共享符号表，输出出现最多的 N 个\n"
+                "  --diagnostics    输出词法错误（未闭合的字符串、字符字面量和块注释，无法识别的字符）\n"
+                "  --export <格式>  把全部单词导出为 jsonl、csv 或 binary（格式见 tokenexport.h），须同时给出 -o\n"
+                "  -o, --output <文件>  导出的目标文件\n"
+                "  --kinds <列表>   只计数、驻留和导出这些类型（逗号分隔），并按类型输出总数：\n"
+                "                   keyword ident int float string char operator delimiter comment macro\n"
+                "                   lifetime unknown。其余单词只扫描，不保存\n"
+                "  --no-comments    不计数、不导出注释\n"
+                "  -h, --help       显示本帮助\n",
+                program);
+}
+
+bool parseOptions(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            std::exit(0);
+        } else if (arg == "-q" || arg == "--quiet") {
+            options.quiet = true;
+        } else if (arg == "--stats") {
+            options.stats = true;
+        } else if (arg == "--diagnostics") {
+            options.diagnostics = true;
+        } else if (arg == "-j" || arg == "--jobs") {
+            if (i + 1 >= argc) {
+                std::fprintf(stderr, "%s 需要一个参数\n", arg.c_str());
+                return false;
+            }
+            options.threads = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg.rfind("--jobs=", 0) == 0) {
+            options.threads = std::strtoul(arg.c_str() + 7, nullptr, 10);
+        } else if (arg == "--symbols") {
+            if (i + 1 >= argc) {
+                std::fprintf(stderr, "%s 需要一个参数\n", arg.c_str());
+                return false;
+            }
+            options.symbols = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg.rfind("--symbols=", 0) == 0) {
+            options.symbols = std::strtoul(arg.c_str() + 10, nullptr, 10);
+        } else if (arg == "--export") {
+            if (i + 1 >= argc) {
+                std::fprintf(stderr, "%s 需要一个参数\n", arg.c_str());
+                return false;
+            }
+            if (!parseExportFormat(argv[++i], options.exportFormat)) {
+                std::fprintf(stderr, "未知的导出格式：%s\n", argv[i]);
+                return false;
+            }
+            options.exportTokens = true;
+        } else if (arg == "--kinds") {
+            if (i + 1 >= argc) {
+                std::fprintf(stderr, "%s 需要一个参数\n", arg.c_str());
+                return false;
+            }
+            TokenTypeMask types;
+            if (!parseTypes(argv[++i], types)) {
+                return false;
+            }
+            options.types &= types;
+        } else if (arg == "--no-comments") {
+            options.types &= ~tokenTypeBit(TokenType::COMMENT);
+        } else if (arg == "-o" || arg == "--output") {
+            if (i + 1 >= argc) {
+                std::fprintf(stderr, "%s 需要一个参数\n", arg.c_str());
+                return false;
+            }
+            options.outputPath = argv[++i];
+        } else if (arg == "--cache") {
+            if (i + 1 >= argc) {
+                std::fprintf(stderr, "%s 需要一个参数\n", arg.c_str());
+                return false;
+            }
+            options.cacheDirectory = argv[++i];
+        } else if (arg.rfind("--cache=", 0) == 0) {
+            options.cacheDirectory = arg.substr(8);
+        } else if (!arg.empty() && arg[0] == '-') {
+            std::fprintf(stderr, "未知选项：%s\n", arg.c_str());
+            return false;
+        } else {
+            options.paths.push_back(arg);
+        }
+    }
+    if (options.exportTokens && options.outputPath.empty()) {
+        std::fprintf(stderr, "--export 需要用 -o 指定输出文件\n");
+        return false;
+    }
+    return !options.paths.empty();
+}
+
+// 收集所有 .rs 文件；直接给出的文件不检查扩展名
+void collectFiles(const std::vector<std::string>& paths, std::vector<FileResult>& files)
+{
+    for (const std::string& path : paths) {
+        std::error_code ec;
+        if (fs::is_directory(path, ec)) {
+            for (fs::recursive_directory_iterator it(path, fs::directory_options::skip_permission_denied, ec), end;
+                 it != end; it.increment(ec)) {
+                if (ec) {
+                    break;
+                }
+                if (it->is_regular_file(ec) && it->path().extension() == ".rs") {
+                    FileResult file;
+                    file.path = it->path().u8string();
+                    file.size = it->file_size(ec);
+                    files.push_back(std::move(file));
+                }
+            }
+        } else {
+            FileResult file;
+            file.path = path;
+            file.size = fs::file_size(path, ec);
+            files.push_back(std::move(file));
+        }
+    }
+}
+
+// 统计已有的单词序列中 types 的单词
+void countTypes(const TokenView& tokens, TokenTypeMask types, TokenCounts& counts)
+{
+    for (size_t i = 0; i < tokens.size(); i++) {
+        TokenType type = tokens.type(i);
+        if ((types & tokenTypeBit(type)) != 0) {
+            counts.byType[size_t(type)]++;
+        }
+    }
+}
+
+// 把词法错误格式化为 "路径:行:列: 说明"，只为出错的单词计算行列号
+void addDiagnostics(FileResult& file, const std::vector<LexDiagnostic>& diagnostics, std::string_view source)
+{
+    if (diagnostics.empty()) {
+        return;
+    }
+    LineIndex lines(source);
+    for (const LexDiagnostic& diagnostic : diagnostics) {
+        file.diagnostics.push_back(file.path + ":" + std::to_string(lines.line(diagnostic.offset)) + ":"
+                                   + std::to_string(lines.column(diagnostic.offset, source) + 1)
+                                   + ": " + lexErrorMessage(diagnostic.kind));
+    }
+}
+
+void lexFile(FileResult& file, ThreadPool& pool, TokenCache* cache, bool collectStats, SymbolTable* symbols,
+             ExportTarget* target, bool reportDiagnostics, TokenTypeMask types)
+{
+    MappedFile mapped;
+    if (!mapped.open(file.path)) {
+        file.error = mapped.errorString();
+        return;
+    }
+    // 单词序列和行索引以32位保存偏移，词法分析库拒绝更大的源码。用到它们的路径（缓存、诊断）
+    // 与 rustindex 一样报告并跳过这样的文件；只计数、统计、驻留和导出逐个取单词，不受此限制
+    const bool compact = mapped.size() <= TokenStream::MAX_SOURCE_SIZE;
+    if (!compact && (cache || reportDiagnostics)) {
+        file.error = file.path + ": 文件超过 4 GiB，不能使用缓存或输出诊断";
+        return;
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+
+    // 直接在映射的内存上扫描，小文件只计数不保存单词。
+    // 每条路径都从自己产生的单词归类诊断，诊断与其他选项可以同时使用
+    RustLexer lexer(mapped.data(), mapped.size());
+    TokenCounts& counts = file.counts;
+    size_t count = 0;
+    if (target) {
+        // 边扫描边格式化到本线程的缓冲区；缓冲区在线程退出时写出剩余内容
+        thread_local std::unique_ptr<BufferedWriter> writer;
+        if (!writer) {
+            writer = std::make_unique<BufferedWriter>(target->file, &target->lock);
+        }
+        TokenExporter exporter(*writer, target->format);
+        if (reportDiagnostics) {
+            // 诊断需要未选中的 UNKNOWN 和注释单词，先完整分析到本线程的内存区再导出选中的类型
+            thread_local TokenArena arena;
+            {
+                TokenStream tokens = lexer.tokenize(&arena);
+                count = exporter.exportTokens(file.path, mapped.view(), tokens, types);
+                addDiagnostics(file, collectDiagnostics(tokens, mapped.view()), mapped.view());
+            }
+            arena.reset();
+        } else {
+            // 不保存单词序列
+            count = exporter.exportSource(file.path, mapped.view(), types);
+        }
+    } else if (collectStats || symbols) {
+        // 统计和驻留只在逐个取单词时进行，不走缓存和块间并行。
+        // 文件内重复的标识符在本地缓存中解决，共享表只在每个文件第一次遇到某个名字时加锁
+        std::unique_ptr<SymbolCache> local;
+        if (symbols) {
+            local = std::make_unique<SymbolCache>(*symbols);
+        }
+        // 诊断时 UNKNOWN 和注释单词即使未选中也要取出，只是不计数
+        TokenTypeMask scanned = types;
+        if (reportDiagnostics) {
+            scanned |= tokenTypeBit(TokenType::UNKNOWN) | tokenTypeBit(TokenType::COMMENT);
+        }
+        std::vector<LexDiagnostic> diagnostics;
+        Token token;
+        while (lexer.nextToken(token, scanned)) {
+            LexDiagnostic diagnostic;
+            if (reportDiagnostics && diagnoseToken(token, mapped.view(), diagnostic)) {
+                diagnostics.push_back(diagnostic);
+            }
+            if ((types & tokenTypeBit(token.type)) == 0) {
+                continue;
+            }
+            counts.byType[size_t(token.type)]++;
+            if (local && (token.type == TokenType::IDENTIFIER || token.type == TokenType::KEYWORD ||
+                          token.type == TokenType::MACRO_CALL)) {
+                local->intern(lexer.lexeme(token));
+            }
+        }
+        count = size_t(counts.total());
+        file.stats = lexer.stats();
+        addDiagnostics(file, diagnostics, mapped.view());
+    } else if (cache) {
+        // 命中时只计算内容哈希并映射缓存文件；未命中时的分析结果放在本线程的内存区中，
+        // 用完整体丢弃，大量小文件不经过全局堆
+        thread_local TokenArena arena;
+        {
+            CachedTokens tokens = cache->tokenize(mapped.view(), &arena);
+            countTypes(tokens.view(), types, counts);
+            count = size_t(counts.total());
+            if (reportDiagnostics) {
+                addDiagnostics(file, collectDiagnostics(tokens.view(), mapped.view()), mapped.view());
+            }
+        }
+        arena.reset();
+    } else if (compact && mapped.size() >= SPLIT_FILE_SIZE && pool.threadCount() > 1) {
+        TokenStream tokens = lexer.tokenizeParallel(pool);
+        countTypes(tokens.view(), types, counts);
+        count = size_t(counts.total());
+        if (reportDiagnostics) {
+            addDiagnostics(file, collectDiagnostics(tokens, mapped.view()), mapped.view());
+        }
+    } else if (reportDiagnostics) {
+        // 诊断从完整的单词序列归类
+        thread_local TokenArena arena;
+        {
+            TokenStream tokens = lexer.tokenize(&arena);
+            countTypes(tokens.view(), types, counts);
+            count = size_t(counts.total());
+            addDiagnostics(file, collectDiagnostics(tokens, mapped.view()), mapped.view());
+        }
+        arena.reset();
+    } else {
+        // 只计数：未选中的类型只扫描，不构造单词
+        LexOptions lexOptions;
+        lexOptions.types = types;
+        counts = lexer.countTokens(lexOptions);
+        count = size_t(counts.total());
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    file.size = mapped.size();
+    file.tokens = count;
+    file.seconds = std::chrono::duration<double>(end - begin).count();
+    file.ok = true;
+}
+
+double megabytesPerSecond(uintmax_t bytes, double seconds)
+{
+    return seconds > 0.0 ? double(bytes) / seconds / 1e6 : 0.0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    std::vector<FileResult> files;
+    collectFiles(options.paths, files);
+
+    // 大文件先调度，避免最后剩下一个大文件拖长总时间
+    std::vector<size_t> order(files.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&files](size_t a, size_t b) {
+        return files[a].size > files[b].size;
+    });
+
+    std::unique_ptr<TokenCache> cache;
+    if (!options.cacheDirectory.empty()) {
+        cache = std::make_unique<TokenCache>(options.cacheDirectory);
+    }
+    std::unique_ptr<SymbolTable> symbols;
+    if (options.symbols != 0) {
+        symbols = std::make_unique<SymbolTable>();
+    }
+
+    std::unique_ptr<ExportTarget> target;
+    if (options.exportTokens) {
+        target = std::make_unique<ExportTarget>();
+        target->format = options.exportFormat;
+        target->file = std::fopen(options.outputPath.c_str(), "wb");
+        if (!target->file) {
+            std::fprintf(stderr, "无法创建 %s：%s\n", options.outputPath.c_str(), std::strerror(errno));
+            return 1;
+        }
+        // 各线程自己缓冲，整块写出，不再经过 stdio 的缓冲区
+        std::setvbuf(target->file, nullptr, _IONBF, 0);
+        BufferedWriter header(target->file);
+        TokenExporter(header, target->format).writeHeader();
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    size_t threadCount;
+    {
+        ThreadPool pool(options.threads);
+        threadCount = pool.threadCount();
+        TokenCache* sharedCache = cache.get();
+        bool collectStats = options.stats;
+        SymbolTable* sharedSymbols = symbols.get();
+        ExportTarget* sharedTarget = target.get();
+        bool reportDiagnostics = options.diagnostics;
+        TokenTypeMask types = options.types;
+        for (size_t index : order) {
+            pool.submit([&files, &pool, sharedCache, collectStats, sharedSymbols, sharedTarget,
+                         reportDiagnostics, types, index]() {
+                lexFile(files[index], pool, sharedCache, collectStats, sharedSymbols, sharedTarget,
+                        reportDiagnostics, types);
+            });
+        }
+        pool.wait();
+        // 线程池析构时各工作线程退出，线程局部的导出缓冲区随之写出
+    }
+    bool exportFailed = false;
+    if (target) {
+        exportFailed = std::ferror(target->file) != 0;
+        exportFailed = std::fclose(target->file) != 0 || exportFailed;
+        if (exportFailed) {
+            std::fprintf(stderr, "写入 %s 失败\n", options.outputPath.c_str());
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    double wallSeconds = std::chrono::duration<double>(end - begin).count();
+
+    std::sort(files.begin(), files.end(), [](const FileResult& a, const FileResult& b) {
+        return a.path < b.path;
+    });
+
+    uintmax_t totalBytes = 0;
+    size_t totalTokens = 0;
+    size_t failed = 0;
+    size_t diagnosticCount = 0;
+    TokenCounts counts;
+    LexStats stats;
+    for (const FileResult& file : files) {
+        if (!file.ok) {
+            std::fprintf(stderr, "%s\n", file.error.c_str());
+            failed++;
+            continue;
+        }
+        totalBytes += file.size;
+        totalTokens += file.tokens;
+        for (size_t i = 0; i < TOKEN_TYPE_COUNT; i++) {
+            counts.byType[i] += file.counts.byType[i];
+        }
+        stats.merge(file.stats);
+        if (!options.quiet) {
+            std::printf("%s\t%zu tokens\t%ju bytes\t%.3f ms\t%.1f MB/s\n",
+                        file.path.c_str(), file.tokens, file.size,
+                        file.seconds * 1e3, megabytesPerSecond(file.size, file.seconds));
+        }
+        for (const std::string& diagnostic : file.diagnostics) {
+            std::printf("%s\n", diagnostic.c_str());
+        }
+        diagnosticCount += file.diagnostics.size();
+    }
+
+    std::printf("总计：%zu 个文件，%ju 字节，%zu 个单词，%zu 个线程，耗时 %.3f ms，"
+                "%.1f MB/s，%.0f tokens/s\n",
+                files.size() - failed, totalBytes, totalTokens, threadCount,
+                wallSeconds * 1e3, megabytesPerSecond(totalBytes, wallSeconds),
+                wallSeconds > 0.0 ? double(totalTokens) / wallSeconds : 0.0);
+    if (options.types != ALL_TOKEN_TYPES && !target) {
+        std::printf("各类单词：");
+        const char* separator = "";
+        for (const TypeName& entry : TYPE_NAMES) {
+            if ((options.types & tokenTypeBit(entry.type)) != 0) {
+                std::printf("%s%s %ju", separator, entry.name, static_cast<uintmax_t>(counts[entry.type]));
+                separator = "，";
+            }
+        }
+        std::printf("\n");
+    }
+    if (options.diagnostics) {
+        std::printf("词法错误：%zu 处\n", diagnosticCount);
+    }
+    if (options.stats) {
+        std::printf("%s", stats.format().c_str());
+    }
+    if (symbols) {
+        uint64_t occurrences = 0;
+        for (uint32_t id = 0; id < symbols->size(); id++) {
+            occurrences += symbols->occurrences(id);
+        }
+        std::printf("标识符：%zu 个不同的名字，共出现 %ju 次\n",
+                    symbols->size(), static_cast<uintmax_t>(occurrences));
+        for (const auto& [id, count] : symbols->mostFrequent(options.symbols)) {
+            std::string name(symbols->name(id));
+            std::printf("  %10ju  %s\n", static_cast<uintmax_t>(count), name.c_str());
+        }
+    }
+    if (cache) {
+        std::printf("缓存：命中 %zu 个文件，未命中 %zu 个文件（%s）\n",
+                    cache->hits(), cache->misses(), cache->directoryPath().c_str());
+    }
+
+    if (target && !exportFailed) {
+        std::error_code ec;
+        std::printf("导出：%s 格式，%ju 字节（%s）\n", exportFormatName(options.exportFormat),
+                    fs::file_size(options.outputPath, ec), options.outputPath.c_str());
+    }
+
+    return failed == 0 && !exportFailed ? 0 : 1;
+}
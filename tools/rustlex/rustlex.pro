@@ -0,0 +1,11 @@
+TEMPLATE = app
+TARGET = rustlex
+
+QT -= core gui
+CONFIG += console c++17 thread
+CONFIG -= app_bundle
+
+include(../../lexer/lexer.pri)
+
+SOURCES += \
+    rustlex.cpp
@@ -0,0 +1,462 @@
+#include "json.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+const JsonValue NULL_VALUE;
+const std::string EMPTY_STRING;
+
+// 嵌套超过此深度的消息视为非法，防止递归耗尽栈
+constexpr int MAX_DEPTH = 256;
+
+void appendUtf8(std::string& out, uint32_t code)
+{
+    if (code < 0x80) {
+        out += char(code);
+    } else if (code < 0x800) {
+        out += char(0xC0 | (code >> 6));
+        out += char(0x80 | (code & 0x3F));
+    } else if (code < 0x10000) {
+        out += char(0xE0 | (code >> 12));
+        out += char(0x80 | ((code >> 6) & 0x3F));
+        out += char(0x80 | (code & 0x3F));
+    } else {
+        out += char(0xF0 | (code >> 18));
+        out += char(0x80 | ((code >> 12) & 0x3F));
+        out += char(0x80 | ((code >> 6) & 0x3F));
+        out += char(0x80 | (code & 0x3F));
+    }
+}
+
+} // namespace
+
+class JsonParser {
+public:
+    explicit JsonParser(std::string_view json) : json(json) {}
+
+    bool parseDocument(JsonValue& result, std::string& error)
+    {
+        skipSpace();
+        if (!parseValue(result, 0)) {
+            error = message + "（位置 " + std::to_string(position) + "）";
+            return false;
+        }
+        skipSpace();
+        if (position != json.size()) {
+            error = "多余的字符（位置 " + std::to_string(position) + "）";
+            return false;
+        }
+        return true;
+    }
+
+private:
+    std::string_view json;
+    size_t position = 0;
+    std::string message;
+
+    bool fail(const char* reason)
+    {
+        message = reason;
+        return false;
+    }
+
+    void skipSpace()
+    {
+        while (position < json.size() &&
+               (json[position] == ' ' || json[position] == '\t' || json[position] == '\n' || json[position] == '\r')) {
+            position++;
+        }
+    }
+
+    bool literal(std::string_view word)
+    {
+        if (json.substr(position, word.size()) != word) {
+            return fail("无效的字面量");
+        }
+        position += word.size();
+        return true;
+    }
+
+    bool parseValue(JsonValue& value, int depth)
+    {
+        if (depth > MAX_DEPTH) {
+            return fail("嵌套过深");
+        }
+        if (position >= json.size()) {
+            return fail("意外的结尾");
+        }
+        switch (json[position]) {
+        case 'n':
+            value = JsonValue();
+            return literal("null");
+        case 't':
+            value = JsonValue(true);
+            return literal("true");
+        case 'f':
+            value = JsonValue(false);
+            return literal("false");
+        case '"':
+            value.kind = JsonValue::Type::String;
+            return parseString(value.text);
+        case '[':
+            return parseArray(value, depth);
+        case '{':
+            return parseObject(value, depth);
+        default:
+            return parseNumber(value);
+        }
+    }
+
+    bool parseNumber(JsonValue& value)
+    {
+        size_t start = position;
+        if (position < json.size() && json[position] == '-') {
+            position++;
+        }
+        while (position < json.size()) {
+            char c = json[position];
+            if ((c >= '0' && c <= '9') || c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-') {
+                position++;
+            } else {
+                break;
+            }
+        }
+        if (position == start) {
+            return fail("无效的值");
+        }
+        // strtod 需要以 '\0' 结尾的字符串；数字很短，复制一份
+        std::string digits(json.substr(start, position - start));
+        char* end = nullptr;
+        double number = std::strtod(digits.c_str(), &end);
+        if (end != digits.c_str() + digits.size()) {
+            return fail("无效的数字");
+        }
+        value = JsonValue(number);
+        return true;
+    }
+
+    bool parseHex4(uint32_t& code)
+    {
+        if (position + 4 > json.size()) {
+            return fail("不完整的 \\u 转义");
+        }
+        code = 0;
+        for (int i = 0; i < 4; i++) {
+            char c = json[position++];
+            code <<= 4;
+            if (c >= '0' && c <= '9') {
+                code |= uint32_t(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                code |= uint32_t(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                code |= uint32_t(c - 'A' + 10);
+            } else {
+                return fail("无效的 \\u 转义");
+            }
+        }
+        return true;
+    }
+
+    bool parseString(std::string& out)
+    {
+        position++; // 跳过 '"'
+        out.clear();
+        while (true) {
+            // 整段复制不含转义的部分，文档全文通常只有少量转义
+            size_t start = position;
+            while (position < json.size() && json[position] != '"' && json[position] != '\\') {
+                position++;
+            }
+            out.append(json.data() + start, position - start);
+            if (position >= json.size()) {
+                return fail("字符串未结束");
+            }
+            if (json[position] == '"') {
+                position++;
+                return true;
+            }
+
+            position++; // 跳过 '\\'
+            if (position >= json.size()) {
+                return fail("字符串未结束");
+            }
+            char escape = json[position++];
+            switch (escape) {
+            case '"':  out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/':  out += '/'; break;
+            case 'b':  out += '\b'; break;
+            case 'f':  out += '\f'; break;
+            case 'n':  out += '\n'; break;
+            case 'r':  out += '\r'; break;
+            case 't':  out += '\t'; break;
+            case 'u': {
+                uint32_t code;
+                if (!parseHex4(code)) {
+                    return false;
+                }
+                // UTF-16 代理对合并为一个码点，孤立的代理项替换为 U+FFFD
+                if (code >= 0xD800 && code <= 0xDBFF) {
+                    size_t next = position;
+                    uint32_t low = 0;
+                    if (json.substr(position, 2) == "\\u") {
+                        position += 2;
+                        if (!parseHex4(low)) {
+                            return false;
+                        }
+                    }
+                    if (low >= 0xDC00 && low <= 0xDFFF) {
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    } else {
+                        // 后面不是低代理项：留给下一轮按普通转义处理
+                        position = next;
+                        code = 0xFFFD;
+                    }
+                } else if (code >= 0xDC00 && code <= 0xDFFF) {
+                    code = 0xFFFD;
+                }
+                appendUtf8(out, code);
+                break;
+            }
+            default:
+                return fail("无效的转义");
+            }
+        }
+    }
+
+    bool parseArray(JsonValue& value, int depth)
+    {
+        position++; // 跳过 '['
+        value = JsonValue::array();
+        skipSpace();
+        if (position < json.size() && json[position] == ']') {
+            position++;
+            return true;
+        }
+        while (true) {
+            skipSpace();
+            value.items.emplace_back();
+            if (!parseValue(value.items.back(), depth + 1)) {
+                return false;
+            }
+            skipSpace();
+            if (position >= json.size()) {
+                return fail("数组未结束");
+            }
+            char c = json[position++];
+            if (c == ']') {
+                return true;
+            }
+            if (c != ',') {
+                return fail("数组中缺少 ','");
+            }
+        }
+    }
+
+    bool parseObject(JsonValue& value, int depth)
+    {
+        position++; // 跳过 '{'
+        value = JsonValue::object();
+        skipSpace();
+        if (position < json.size() && json[position] == '}') {
+            position++;
+            return true;
+        }
+        while (true) {
+            skipSpace();
+            if (position >= json.size() || json[position] != '"') {
+                return fail("对象的键必须是字符串");
+            }
+            std::string key;
+            if (!parseString(key)) {
+                return false;
+            }
+            skipSpace();
+            if (position >= json.size() || json[position] != ':') {
+                return fail("对象中缺少 ':'");
+            }
+            position++;
+            skipSpace();
+            value.members.emplace_back(std::move(key), JsonValue());
+            if (!parseValue(value.members.back().second, depth + 1)) {
+                return false;
+            }
+            skipSpace();
+            if (position >= json.size()) {
+                return fail("对象未结束");
+            }
+            char c = json[position++];
+            if (c == '}') {
+                return true;
+            }
+            if (c != ',') {
+                return fail("对象中缺少 ','");
+            }
+        }
+    }
+};
+
+bool JsonValue::parse(std::string_view json, JsonValue& result, std::string& error)
+{
+    JsonParser parser(json);
+    return parser.parseDocument(result, error);
+}
+
+int64_t JsonValue::asInt(int64_t fallback) const
+{
+    if (kind != Type::Number || !std::isfinite(number)) {
+        return fallback;
+    }
+    // 2^63 不能用 int64 表示，比较时用精确的 double 边界，不用 double(INT64_MAX)
+    if (number >= 9223372036854775808.0) {
+        return INT64_MAX;
+    }
+    if (number <= -9223372036854775808.0) {
+        return INT64_MIN;
+    }
+    return int64_t(number);
+}
+
+bool JsonValue::asUInt32(uint32_t& value) const
+{
+    if (kind != Type::Number || !std::isfinite(number) || number < 0.0 || number > double(UINT32_MAX)
+        || std::trunc(number) != number) {
+        return false;
+    }
+    value = uint32_t(number);
+    return true;
+}
+
+const std::string& JsonValue::asString() const
+{
+    return kind == Type::String ? text : EMPTY_STRING;
+}
+
+const JsonValue& JsonValue::operator[](size_t index) const
+{
+    return kind == Type::Array && index < items.size() ? items[index] : NULL_VALUE;
+}
+
+const JsonValue& JsonValue::operator[](std::string_view key) const
+{
+    if (kind == Type::Object) {
+        for (const auto& member : members) {
+            if (member.first == key) {
+                return member.second;
+            }
+        }
+    }
+    return NULL_VALUE;
+}
+
+bool JsonValue::contains(std::string_view key) const
+{
+    if (kind == Type::Object) {
+        for (const auto& member : members) {
+            if (member.first == key) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+JsonValue& JsonValue::set(std::string key, JsonValue value)
+{
+    kind = Type::Object;
+    for (auto& member : members) {
+        if (member.first == key) {
+            member.second = std::move(value);
+            return *this;
+        }
+    }
+    members.emplace_back(std::move(key), std::move(value));
+    return *this;
+}
+
+void JsonValue::writeString(std::string& out, std::string_view value)
+{
+    static const char HEX[] = "0123456789abcdef";
+    out += '"';
+    size_t start = 0;
+    for (size_t i = 0; i < value.size(); i++) {
+        unsigned char c = static_cast<unsigned char>(value[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        out.append(value.data() + start, i - start);
+        start = i + 1;
+        switch (c) {
+        case '"':  out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            out += "\\u00";
+            out += HEX[c >> 4];
+            out += HEX[c & 0xF];
+            break;
+        }
+    }
+    out.append(value.data() + start, value.size() - start);
+    out += '"';
+}
+
+void JsonValue::write(std::string& out) const
+{
+    switch (kind) {
+    case Type::Null:
+        out += "null";
+        break;
+    case Type::Bool:
+        out += boolean ? "true" : "false";
+        break;
+    case Type::Number: {
+        char buffer[32];
+        // 整数值按整数写出，JSON-RPC 的 id 和各种计数都是整数
+        if (std::isfinite(number) && number == std::floor(number) && std::fabs(number) < 9007199254740992.0) {
+            auto result = std::to_chars(buffer, buffer + sizeof(buffer), int64_t(number));
+            out.append(buffer, result.ptr);
+        } else if (std::isfinite(number)) {
+            int length = std::snprintf(buffer, sizeof(buffer), "%.17g", number);
+            out.append(buffer, size_t(length));
+        } else {
+            out += "null";
+        }
+        break;
+    }
+    case Type::String:
+        writeString(out, text);
+        break;
+    case Type::Raw:
+        out += text;
+        break;
+    case Type::Array:
+        out += '[';
+        for (size_t i = 0; i < items.size(); i++) {
+            if (i != 0) {
+                out += ',';
+            }
+            items[i].write(out);
+        }
+        out += ']';
+        break;
+    case Type::Object:
+        out += '{';
+        for (size_t i = 0; i < members.size(); i++) {
+            if (i != 0) {
+                out += ',';
+            }
+            writeString(out, members[i].first);
+            out += ':';
+            members[i].second.write(out);
+        }
+        out += '}';
+        break;
+    }
+}
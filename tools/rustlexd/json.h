@@ -0,0 +1,76 @@
+#ifndef JSON_H
+#define JSON_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// 最小的 JSON 值：只覆盖 JSON-RPC 消息需要的部分。
+// 对象按插入顺序保存键值对，查找为线性扫描（消息中的对象都很小）
+class JsonValue {
+public:
+    enum class Type { Null, Bool, Number, String, Array, Object, Raw };
+
+    JsonValue() = default;
+    JsonValue(std::nullptr_t) {}
+    JsonValue(bool value) : kind(Type::Bool), boolean(value) {}
+    JsonValue(int value) : kind(Type::Number), number(value) {}
+    JsonValue(int64_t value) : kind(Type::Number), number(double(value)) {}
+    JsonValue(uint64_t value) : kind(Type::Number), number(double(value)) {}
+    JsonValue(double value) : kind(Type::Number), number(value) {}
+    JsonValue(const char* value) : kind(Type::String), text(value) {}
+    JsonValue(std::string value) : kind(Type::String), text(std::move(value)) {}
+
+    static JsonValue array() { JsonValue value; value.kind = Type::Array; return value; }
+    static JsonValue object() { JsonValue value; value.kind = Type::Object; return value; }
+    // 已格式化好的 JSON 文本，写出时原样输出（如很长的整数数组）
+    static JsonValue raw(std::string json) { JsonValue value; value.kind = Type::Raw; value.text = std::move(json); return value; }
+
+    // 解析失败时返回 false，error 给出原因和位置
+    static bool parse(std::string_view json, JsonValue& result, std::string& error);
+
+    Type type() const { return kind; }
+    bool isNull() const { return kind == Type::Null; }
+    bool isNumber() const { return kind == Type::Number; }
+    bool isString() const { return kind == Type::String; }
+    bool isArray() const { return kind == Type::Array; }
+    bool isObject() const { return kind == Type::Object; }
+
+    bool asBool(bool fallback = false) const { return kind == Type::Bool ? boolean : fallback; }
+    double asNumber(double fallback = 0.0) const { return kind == Type::Number ? number : fallback; }
+    // 非有限值返回 fallback，超出 int64 范围的值截到边界，小数部分舍去
+    int64_t asInt(int64_t fallback = 0) const;
+    // 是 [0, UINT32_MAX] 内的整数时写入 value 并返回 true，如 LSP 位置的行号和列号
+    bool asUInt32(uint32_t& value) const;
+    const std::string& asString() const;
+
+    // 数组
+    size_t size() const { return kind == Type::Array ? items.size() : members.size(); }
+    const JsonValue& operator[](size_t index) const;
+    void push(JsonValue value) { items.push_back(std::move(value)); }
+
+    // 对象：不存在的键返回 null
+    const JsonValue& operator[](std::string_view key) const;
+    bool contains(std::string_view key) const;
+    JsonValue& set(std::string key, JsonValue value);
+
+    // 紧凑格式，不含多余空白
+    void write(std::string& out) const;
+    std::string toString() const { std::string out; write(out); return out; }
+
+    static void writeString(std::string& out, std::string_view value);
+
+private:
+    Type kind = Type::Null;
+    bool boolean = false;
+    double number = 0.0;
+    std::string text;
+    std::vector<JsonValue> items;
+    std::vector<std::pair<std::string, JsonValue>> members;
+
+    friend class JsonParser;
+};
+
+#endif // JSON_H
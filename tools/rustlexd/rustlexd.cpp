@@ -0,0 +1,405 @@
+// rustlexd：常驻的本地语义单词服务。
+// 通过标准输入输出以 LSP 的 JSON-RPC 分帧（Content-Length 头）通信，支持
+// textDocument/didOpen、didChange（增量）、didClose 和 semanticTokens/full、full/delta。
+// 每个打开的文档常驻内存，编辑只重新分析受影响的单词，增量结果只编码改动的区间。
+
+#include "json.h"
+#include "semantictokens.h"
+
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace {
+
+// JSON-RPC 和 LSP 定义的错误码
+constexpr int PARSE_ERROR = -32700;
+constexpr int INVALID_REQUEST = -32600;
+constexpr int METHOD_NOT_FOUND = -32601;
+constexpr int INVALID_PARAMS = -32602;
+constexpr int SERVER_NOT_INITIALIZED = -32002;
+
+void printUsage(const char* program)
+{
+    std::fprintf(stderr,
+                 "用法：%s [选项]\n"
+                 "  从标准输入读取 LSP 消息，向标准输出写回应答\n"
+                 "  -v, --verbose    在标准错误输出每条消息的方法名和处理耗时\n"
+                 "  -h, --help       显示本帮助\n",
+                 program);
+}
+
+// LSP 的 Position；行号或列号不是非负的32位整数时返回 false
+bool readPosition(const JsonValue& position, uint32_t& line, uint32_t& character)
+{
+    return position["line"].asUInt32(line) && position["character"].asUInt32(character);
+}
+
+std::string formatData(const std::vector<uint32_t>& data)
+{
+    std::string out;
+    out.reserve(data.size() * 3 + 2);
+    out += '[';
+    char buffer[16];
+    for (size_t i = 0; i < data.size(); i++) {
+        if (i != 0) {
+            out += ',';
+        }
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), data[i]);
+        out.append(buffer, result.ptr);
+    }
+    out += ']';
+    return out;
+}
+
+class Server {
+public:
+    explicit Server(bool verbose) : verbose(verbose) {}
+
+    int run();
+
+private:
+    std::unordered_map<std::string, std::unique_ptr<SemanticDocument>> documents;
+    PositionEncoding encoding = PositionEncoding::Utf16;
+    bool verbose;
+    bool initialized = false;
+    bool shutdownRequested = false;
+    bool exitRequested = false;
+
+    bool readMessage(std::string& body);
+    void send(const JsonValue& message);
+    void reply(const JsonValue& id, JsonValue result);
+    void replyError(const JsonValue& id, int code, const std::string& message);
+
+    void handle(const JsonValue& message);
+    JsonValue initialize(const JsonValue& params);
+    void didOpen(const JsonValue& params);
+    void didChange(const JsonValue& params);
+    void didClose(const JsonValue& params);
+    JsonValue semanticTokensFull(SemanticDocument& document);
+    JsonValue semanticTokensDelta(SemanticDocument& document, const JsonValue& params);
+    SemanticDocument* findDocument(const JsonValue& params);
+};
+
+int Server::run()
+{
+    std::string body;
+    while (!exitRequested && readMessage(body)) {
+        auto begin = std::chrono::steady_clock::now();
+        JsonValue message;
+        std::string error;
+        if (!JsonValue::parse(body, message, error)) {
+            replyError(JsonValue(), PARSE_ERROR, error);
+            continue;
+        }
+        handle(message);
+        if (verbose) {
+            double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+            std::fprintf(stderr, "%-40s %10.1f us\n", message["method"].asString().c_str(), micros);
+        }
+    }
+    // 按协议，收到 shutdown 之后的 exit 以0退出，否则以1退出
+    return exitRequested && shutdownRequested ? 0 : 1;
+}
+
+bool Server::readMessage(std::string& body)
+{
+    // 头部为若干行 "名称: 值\r\n"，以空行结束；只关心 Content-Length
+    size_t length = 0;
+    bool haveLength = false;
+    std::string line;
+    while (true) {
+        line.clear();
+        int c;
+        while ((c = std::getchar()) != EOF && c != '\n') {
+            line += char(c);
+        }
+        if (c == EOF) {
+            return false;
+        }
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty()) {
+            if (haveLength) {
+                break;
+            }
+            continue;
+        }
+        const char* name = "Content-Length:";
+        if (line.compare(0, std::strlen(name), name) == 0) {
+            length = std::strtoull(line.c_str() + std::strlen(name), nullptr, 10);
+            haveLength = true;
+        }
+    }
+
+    body.resize(length);
+    return std::fread(&body[0], 1, length, stdin) == length;
+}
+
+void Server::send(const JsonValue& message)
+{
+    std::string body = message.toString();
+    std::printf("Content-Length: %zu\r\n\r\n", body.size());
+    std::fwrite(body.data(), 1, body.size(), stdout);
+    std::fflush(stdout);
+}
+
+void Server::reply(const JsonValue& id, JsonValue result)
+{
+    JsonValue message = JsonValue::object();
+    message.set("jsonrpc", "2.0");
+    message.set("id", id);
+    message.set("result", std::move(result));
+    send(message);
+}
+
+void Server::replyError(const JsonValue& id, int code, const std::string& text)
+{
+    JsonValue error = JsonValue::object();
+    error.set("code", code);
+    error.set("message", text);
+    JsonValue message = JsonValue::object();
+    message.set("jsonrpc", "2.0");
+    message.set("id", id);
+    message.set("error", std::move(error));
+    send(message);
+}
+
+void Server::handle(const JsonValue& message)
+{
+    const std::string& method = message["method"].asString();
+    const JsonValue& params = message["params"];
+    const bool isRequest = message.contains("id");
+    const JsonValue& id = message["id"];
+
+    if (!message.isObject() || method.empty()) {
+        // 客户端对服务端请求的应答（本服务不发请求）或格式不对的消息
+        if (isRequest && !message.contains("result") && !message.contains("error")) {
+            replyError(id, INVALID_REQUEST, "缺少 method");
+        }
+        return;
+    }
+
+    if (method == "exit") {
+        exitRequested = true;
+        return;
+    }
+    if (method == "initialize") {
+        initialized = true;
+        reply(id, initialize(params));
+        return;
+    }
+    if (!initialized) {
+        if (isRequest) {
+            replyError(id, SERVER_NOT_INITIALIZED, "尚未 initialize");
+        }
+        return;
+    }
+    if (shutdownRequested) {
+        if (isRequest) {
+            replyError(id, INVALID_REQUEST, "已经 shutdown");
+        }
+        return;
+    }
+
+    if (method == "shutdown") {
+        shutdownRequested = true;
+        documents.clear();
+        reply(id, JsonValue());
+    } else if (method == "textDocument/didOpen") {
+        didOpen(params);
+    } else if (method == "textDocument/didChange") {
+        didChange(params);
+    } else if (method == "textDocument/didClose") {
+        didClose(params);
+    } else if (method == "textDocument/semanticTokens/full" ||
+               method == "textDocument/semanticTokens/full/delta") {
+        SemanticDocument* document = findDocument(params);
+        if (!document) {
+            replyError(id, INVALID_PARAMS, "文档未打开：" + params["textDocument"]["uri"].asString());
+        } else if (method == "textDocument/semanticTokens/full") {
+            reply(id, semanticTokensFull(*document));
+        } else {
+            reply(id, semanticTokensDelta(*document, params));
+        }
+    } else if (isRequest) {
+        replyError(id, METHOD_NOT_FOUND, "不支持的方法：" + method);
+    }
+    // 其余通知（initialized、$/cancelRequest、didSave 等）忽略
+}
+
+JsonValue Server::initialize(const JsonValue& params)
+{
+    // 客户端声明支持 utf-8 时按字节计列号，否则用协议默认的 UTF-16
+    const JsonValue& offered = params["capabilities"]["general"]["positionEncodings"];
+    encoding = PositionEncoding::Utf16;
+    for (size_t i = 0; i < offered.size(); i++) {
+        if (offered[i].asString() == "utf-8") {
+            encoding = PositionEncoding::Utf8;
+        }
+    }
+
+    JsonValue tokenTypes = JsonValue::array();
+    for (const std::string& type : semanticTokenLegend()) {
+        tokenTypes.push(type);
+    }
+    JsonValue legend = JsonValue::object();
+    legend.set("tokenTypes", std::move(tokenTypes));
+    legend.set("tokenModifiers", JsonValue::array());
+
+    JsonValue full = JsonValue::object();
+    full.set("delta", true);
+    JsonValue semanticTokens = JsonValue::object();
+    semanticTokens.set("legend", std::move(legend));
+    semanticTokens.set("range", false);
+    semanticTokens.set("full", std::move(full));
+
+    JsonValue sync = JsonValue::object();
+    sync.set("openClose", true);
+    sync.set("change", 2);     // TextDocumentSyncKind.Incremental
+
+    JsonValue capabilities = JsonValue::object();
+    capabilities.set("positionEncoding", encoding == PositionEncoding::Utf8 ? "utf-8" : "utf-16");
+    capabilities.set("textDocumentSync", std::move(sync));
+    capabilities.set("semanticTokensProvider", std::move(semanticTokens));
+
+    JsonValue serverInfo = JsonValue::object();
+    serverInfo.set("name", "rustlexd");
+
+    JsonValue result = JsonValue::object();
+    result.set("capabilities", std::move(capabilities));
+    result.set("serverInfo", std::move(serverInfo));
+    return result;
+}
+
+SemanticDocument* Server::findDocument(const JsonValue& params)
+{
+    auto it = documents.find(params["textDocument"]["uri"].asString());
+    return it != documents.end() ? it->second.get() : nullptr;
+}
+
+void Server::didOpen(const JsonValue& params)
+{
+    const JsonValue& textDocument = params["textDocument"];
+    documents[textDocument["uri"].asString()] =
+        std::make_unique<SemanticDocument>(textDocument["text"].asString(), encoding);
+}
+
+void Server::didChange(const JsonValue& params)
+{
+    SemanticDocument* document = findDocument(params);
+    if (!document) {
+        return;
+    }
+
+    // 通知没有应答，位置不合法时整条通知都不应用，不留下只改了一半的文档
+    const JsonValue& changes = params["contentChanges"];
+    for (size_t i = 0; i < changes.size(); i++) {
+        const JsonValue& range = changes[i]["range"];
+        uint32_t line, character;
+        if (changes[i].contains("range")
+            && (!readPosition(range["start"], line, character) || !readPosition(range["end"], line, character))) {
+            std::fprintf(stderr, "忽略 didChange：位置不是非负整数（%s）\n",
+                         params["textDocument"]["uri"].asString().c_str());
+            return;
+        }
+    }
+
+    // 多处修改按顺序应用，每处的位置相对前一处修改之后的文本
+    for (size_t i = 0; i < changes.size(); i++) {
+        const JsonValue& change = changes[i];
+        if (!change.contains("range")) {
+            document->replaceAll(change["text"].asString());
+            continue;
+        }
+        uint32_t startLine, startCharacter, endLine, endCharacter;
+        readPosition(change["range"]["start"], startLine, startCharacter);
+        readPosition(change["range"]["end"], endLine, endCharacter);
+        size_t begin = document->offsetAt(startLine, startCharacter);
+        size_t finish = document->offsetAt(endLine, endCharacter);
+        document->replace(begin, finish, change["text"].asString());
+    }
+}
+
+void Server::didClose(const JsonValue& params)
+{
+    documents.erase(params["textDocument"]["uri"].asString());
+}
+
+JsonValue Server::semanticTokensFull(SemanticDocument& document)
+{
+    std::vector<uint32_t> data = document.full();
+    JsonValue result = JsonValue::object();
+    result.set("resultId", std::to_string(document.resultId()));
+    result.set("data", JsonValue::raw(formatData(data)));
+    return result;
+}
+
+JsonValue Server::semanticTokensDelta(SemanticDocument& document, const JsonValue& params)
+{
+    // 只能相对最近一次结果计算增量；客户端给出更早的结果时退回完整结果
+    if (params["previousResultId"].asString() != std::to_string(document.resultId())) {
+        return semanticTokensFull(document);
+    }
+
+    std::vector<SemanticTokensEdit> changes;
+    if (!document.delta(changes)) {
+        return semanticTokensFull(document);
+    }
+
+    // 各处替换的 start 都是相对上次结果的下标，互不重叠
+    JsonValue edits = JsonValue::array();
+    for (const SemanticTokensEdit& change : changes) {
+        JsonValue item = JsonValue::object();
+        item.set("start", uint64_t(change.start));
+        item.set("deleteCount", uint64_t(change.deleteCount));
+        item.set("data", JsonValue::raw(formatData(change.data)));
+        edits.push(std::move(item));
+    }
+    JsonValue result = JsonValue::object();
+    result.set("resultId", std::to_string(document.resultId()));
+    result.set("edits", std::move(edits));
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    bool verbose = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-v" || arg == "--verbose") {
+            verbose = true;
+        } else if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--stdio") {
+            // 编辑器插件常带此参数启动语言服务，标准输入输出本就是唯一的通道
+        } else {
+            std::fprintf(stderr, "未知选项：%s\n", arg.c_str());
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+#ifdef _WIN32
+    // 按字节读写，Content-Length 才与实际长度一致
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+
+    Server server(verbose);
+    return server.run();
+}
@@ -0,0 +1,17 @@
+TEMPLATE = app
+TARGET = rustlexd
+
+QT -= core gui
+CONFIG += console c++17
+CONFIG -= app_bundle
+
+include(../../lexer/lexer.pri)
+
+SOURCES += \
+    json.cpp \
+    rustlexd.cpp \
+    semantictokens.cpp
+
+HEADERS += \
+    json.h \
+    semantictokens.h
@@ -0,0 +1,350 @@
+#include "semantictokens.h"
+
+#include <algorithm>
+
+namespace {
+
+// 每段编码为5个整数：行差、列差、长度、类型、修饰符
+constexpr size_t INTS_PER_SEGMENT = 5;
+
+// 单词类型在图例中的下标，-1 表示不着色
+int legendIndex(TokenType type)
+{
+    switch (type) {
+    case TokenType::KEYWORD:         return 0;
+    case TokenType::IDENTIFIER:      return 1;
+    case TokenType::INTEGER_LITERAL:
+    case TokenType::FLOAT_LITERAL:   return 2;
+    case TokenType::STRING_LITERAL:
+    case TokenType::CHAR_LITERAL:    return 3;
+    case TokenType::OPERATOR:        return 4;
+    case TokenType::COMMENT:         return 5;
+    case TokenType::MACRO_CALL:      return 6;
+    case TokenType::DELIMITER:       return 7;
+    case TokenType::LIFETIME:        return 8;
+    default:                         return -1;
+    }
+}
+
+// UTF-8 首字节对应的字节数和 UTF-16 码元数；续字节按1字节处理，非法序列不会卡住
+inline size_t sequenceLength(unsigned char lead)
+{
+    if (lead < 0xC0) {
+        return 1;
+    }
+    return lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+}
+
+} // namespace
+
+const std::vector<std::string>& semanticTokenLegend()
+{
+    // punctuation 和 lifetime 不是 LSP 的标准类型，不认识它们的客户端会忽略这类单词
+    static const std::vector<std::string> legend = {
+        "keyword", "variable", "number", "string", "operator", "comment", "macro", "punctuation",
+        "lifetime"
+    };
+    return legend;
+}
+
+SemanticDocument::SemanticDocument(std::string text, PositionEncoding encoding)
+    : lexer(std::make_unique<RustLexer>(std::move(text))), encoding(encoding)
+{
+    tokens = lexer->tokenize();
+    lines.build(lexer->sourceText());
+}
+
+size_t SemanticDocument::offsetAt(uint32_t line, uint32_t character) const
+{
+    std::string_view source = lexer->sourceText();
+    if (line >= lines.lineCount()) {
+        return source.size();
+    }
+
+    // 只有 "\n" 是换行，"\r" 与普通字符一样占一列；超出行尾的位置截到 "\n" 之前
+    size_t lineStart = lines.lineStart(int(line) + 1);
+    size_t lineEnd = line + 1 < lines.lineCount() ? lines.lineStart(int(line) + 2) - 1 : source.size();
+    if (encoding == PositionEncoding::Utf8) {
+        return std::min(lineStart + character, lineEnd);
+    }
+
+    // UTF-16：逐个码点累加码元数，落在代理对中间时取码点起点
+    size_t position = lineStart;
+    uint32_t units = 0;
+    while (position < lineEnd && units < character) {
+        size_t length = sequenceLength(static_cast<unsigned char>(source[position]));
+        uint32_t width = length == 4 ? 2 : 1;
+        if (units + width > character) {
+            break;
+        }
+        units += width;
+        position = std::min(position + length, lineEnd);
+    }
+    return position;
+}
+
+void SemanticDocument::replace(size_t begin, size_t end, std::string_view text)
+{
+    size_t size = lexer->sourceText().size();
+    begin = std::min(begin, size);
+    end = std::min(std::max(begin, end), size);
+
+    TokenEdit edit = lexer->applyEdit(tokens, begin, end - begin, text);
+    lines.applyEdit(begin, end - begin, text);
+    markDirty(edit.first, edit.removed, edit.inserted);
+}
+
+void SemanticDocument::replaceAll(std::string text)
+{
+    size_t removed = tokens.size();
+    lexer = std::make_unique<RustLexer>(std::move(text));
+    tokens = lexer->tokenize();
+    lines.build(lexer->sourceText());
+    markDirty(0, removed, tokens.size());
+}
+
+void SemanticDocument::markDirty(size_t first, size_t removed, size_t inserted)
+{
+    if (lastResultId == 0) {
+        // 还没有返回过结果，下一次请求必然是完整结果
+        return;
+    }
+
+    // 与当前坐标 [first, first + removed] 相交或相接的已有区间 [lo, hi) 合并为一个
+    size_t end = first + removed;
+    auto lo = dirtyRanges.begin();
+    int64_t shiftBefore = 0;    // lo 之前各区间造成的单词数变化
+    while (lo != dirtyRanges.end() && lo->newEnd < first) {
+        shiftBefore += int64_t(lo->newEnd - lo->newFirst) - int64_t(lo->oldEnd - lo->oldFirst);
+        ++lo;
+    }
+    auto hi = lo;
+    while (hi != dirtyRanges.end() && hi->newFirst <= end) {
+        ++hi;
+    }
+
+    DirtyRange merged;
+    if (lo == hi) {
+        merged = {size_t(int64_t(first) - shiftBefore), size_t(int64_t(end) - shiftBefore), first, end};
+    } else {
+        // 区间之间未改动的单词与旧结果一一对应，按前一个区间的偏差换算
+        const DirtyRange& last = *(hi - 1);
+        merged.newFirst = std::min(first, lo->newFirst);
+        merged.oldFirst = first < lo->newFirst ? size_t(int64_t(first) - shiftBefore) : lo->oldFirst;
+        merged.newEnd = std::max(end, last.newEnd);
+        merged.oldEnd = end > last.newEnd ? last.oldEnd + (end - last.newEnd) : last.oldEnd;
+    }
+    merged.newEnd = merged.newEnd - removed + inserted;
+
+    for (auto it = hi; it != dirtyRanges.end(); ++it) {
+        it->newFirst = it->newFirst - removed + inserted;
+        it->newEnd = it->newEnd - removed + inserted;
+    }
+    size_t index = size_t(lo - dirtyRanges.begin());
+    dirtyRanges.erase(lo, hi);
+    dirtyRanges.insert(dirtyRanges.begin() + index, merged);
+
+    if (dirtyRanges.size() > MAX_DIRTY_RANGES) {
+        DirtyRange all = {dirtyRanges.front().oldFirst, dirtyRanges.back().oldEnd,
+                          dirtyRanges.front().newFirst, dirtyRanges.back().newEnd};
+        dirtyRanges.assign(1, all);
+    }
+}
+
+std::vector<uint32_t> SemanticDocument::full()
+{
+    std::vector<uint32_t> data;
+    data.reserve(tokens.size() * INTS_PER_SEGMENT);
+    std::vector<std::pair<uint32_t, uint32_t>> segments;
+    Position previous;
+    encode(0, tokens.size(), previous, data, segments);
+
+    lastSegments = std::move(segments);
+    dirtyRanges.clear();
+    lastResultId++;
+    return data;
+}
+
+bool SemanticDocument::delta(std::vector<SemanticTokensEdit>& edits)
+{
+    if (lastResultId == 0) {
+        return false;
+    }
+
+    // 每个区间之后第一个着色的单词也要重新编码：它相对前一段的行差和列差可能变了；
+    // 再往后的单词与前一段一起平移，编码不变。延伸后与下一个区间相接的合并
+    std::vector<DirtyRange> ranges;
+    for (DirtyRange range : dirtyRanges) {
+        size_t newEnd = range.newEnd;
+        while (newEnd < tokens.size() && legendIndex(tokens.type(newEnd)) < 0) {
+            newEnd++;
+        }
+        newEnd = std::min(newEnd + 1, tokens.size());
+        range.oldEnd += newEnd - range.newEnd;
+        range.newEnd = newEnd;
+        if (!ranges.empty() && range.newFirst <= ranges.back().newEnd) {
+            ranges.back().oldEnd = range.oldEnd;
+            ranges.back().newEnd = range.newEnd;
+        } else {
+            ranges.push_back(range);
+        }
+    }
+
+    edits.clear();
+    std::vector<std::pair<uint32_t, uint32_t>> updated;
+    updated.reserve(lastSegments.size());
+    auto it = lastSegments.begin();
+    int64_t shift = 0;
+    for (const DirtyRange& range : ranges) {
+        SemanticTokensEdit edit;
+        edit.start = resultOffset(range.oldFirst);
+        edit.deleteCount = resultOffset(range.oldEnd) - edit.start;
+        std::vector<std::pair<uint32_t, uint32_t>> segments;
+        Position previous = positionBefore(range.newFirst);
+        encode(range.newFirst, range.newEnd, previous, edit.data, segments);
+        edits.push_back(std::move(edit));
+
+        // 更新结果的形状：区间前的平移下标，区间内换成新编码的
+        for (; it != lastSegments.end() && it->first < range.oldFirst; ++it) {
+            updated.emplace_back(uint32_t(int64_t(it->first) + shift), it->second);
+        }
+        while (it != lastSegments.end() && it->first < range.oldEnd) {
+            ++it;
+        }
+        updated.insert(updated.end(), segments.begin(), segments.end());
+        shift += int64_t(range.newEnd - range.newFirst) - int64_t(range.oldEnd - range.oldFirst);
+    }
+    for (; it != lastSegments.end(); ++it) {
+        updated.emplace_back(uint32_t(int64_t(it->first) + shift), it->second);
+    }
+    lastSegments = std::move(updated);
+
+    dirtyRanges.clear();
+    lastResultId++;
+    return true;
+}
+
+void SemanticDocument::moveCursor(Cursor& cursor, size_t offset) const
+{
+    if (cursor.line != UINT32_MAX && offset >= cursor.lineStart && offset < cursor.nextLineStart) {
+        return;
+    }
+
+    std::string_view source = lexer->sourceText();
+    int line = lines.line(offset);
+    cursor.line = uint32_t(line - 1);
+    cursor.lineStart = lines.lineStart(line);
+    if (size_t(line) < lines.lineCount()) {
+        cursor.nextLineStart = lines.lineStart(line + 1);
+        cursor.lineEnd = cursor.nextLineStart - 1;
+        if (cursor.lineEnd > cursor.lineStart && source[cursor.lineEnd - 1] == '\r') {
+            cursor.lineEnd--;
+        }
+    } else {
+        cursor.nextLineStart = source.size();
+        cursor.lineEnd = source.size();
+    }
+    cursor.offset = cursor.lineStart;
+    cursor.units = 0;
+}
+
+uint32_t SemanticDocument::unitsBetween(size_t begin, size_t end) const
+{
+    if (encoding == PositionEncoding::Utf8) {
+        return uint32_t(end - begin);
+    }
+    // 续字节不计数，4字节序列在 UTF-16 中占两个码元
+    std::string_view source = lexer->sourceText();
+    uint32_t units = 0;
+    for (size_t i = begin; i < end; i++) {
+        unsigned char c = static_cast<unsigned char>(source[i]);
+        units += (c & 0xC0) != 0x80;
+        units += c >= 0xF0;
+    }
+    return units;
+}
+
+uint32_t SemanticDocument::columnAt(Cursor& cursor, size_t offset) const
+{
+    if (encoding == PositionEncoding::Utf8) {
+        return uint32_t(offset - cursor.lineStart);
+    }
+    if (offset < cursor.offset) {
+        cursor.offset = cursor.lineStart;
+        cursor.units = 0;
+    }
+    cursor.units += unitsBetween(cursor.offset, offset);
+    cursor.offset = offset;
+    return cursor.units;
+}
+
+void SemanticDocument::encode(size_t first, size_t last, Position& previous, std::vector<uint32_t>& data,
+                              std::vector<std::pair<uint32_t, uint32_t>>& segments) const
+{
+    Cursor cursor;
+    for (size_t index = first; index < last; index++) {
+        int type = legendIndex(tokens.type(index));
+        if (type < 0) {
+            segments.emplace_back(uint32_t(index), 0);
+            continue;
+        }
+
+        // 客户端不一定支持跨行单词，按行拆成多段
+        size_t begin = tokens.offset(index);
+        size_t end = begin + tokens.length(index);
+        uint32_t count = 0;
+        size_t position = begin;
+        while (true) {
+            moveCursor(cursor, position);
+            size_t segmentEnd = std::min(end, cursor.lineEnd);
+            if (segmentEnd > position) {
+                uint32_t character = columnAt(cursor, position);
+                uint32_t length = unitsBetween(position, segmentEnd);
+                data.push_back(cursor.line - previous.line);
+                data.push_back(cursor.line == previous.line ? character - previous.character : character);
+                data.push_back(length);
+                data.push_back(uint32_t(type));
+                data.push_back(0);
+                previous.line = cursor.line;
+                previous.character = character;
+                count++;
+            }
+            if (end <= cursor.nextLineStart || cursor.nextLineStart >= lexer->sourceText().size()) {
+                break;
+            }
+            position = cursor.nextLineStart;
+        }
+        if (count != 1) {
+            segments.emplace_back(uint32_t(index), count);
+        }
+    }
+}
+
+SemanticDocument::Position SemanticDocument::positionBefore(size_t index) const
+{
+    // 前一个着色的单词最后一段的位置；不着色的单词很少，向前找通常只看一个
+    std::vector<uint32_t> scratch;
+    std::vector<std::pair<uint32_t, uint32_t>> segments;
+    for (size_t i = index; i > 0; i--) {
+        Position position;
+        scratch.clear();
+        encode(i - 1, i, position, scratch, segments);
+        if (!scratch.empty()) {
+            return position;
+        }
+    }
+    return Position();
+}
+
+size_t SemanticDocument::resultOffset(size_t index) const
+{
+    // 段数不为1的单词很少，线性累加修正量
+    int64_t segmentCount = int64_t(index);
+    for (const auto& entry : lastSegments) {
+        if (entry.first >= index) {
+            break;
+        }
+        segmentCount += int64_t(entry.second) - 1;
+    }
+    return size_t(segmentCount) * INTS_PER_SEGMENT;
+}
@@ -0,0 +1,110 @@
+#ifndef SEMANTICTOKENS_H
+#define SEMANTICTOKENS_H
+
+#include "lineindex.h"
+#include "rustlexer.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// LSP 位置中 character 的单位，由 initialize 时协商
+enum class PositionEncoding {
+    Utf16,      // 协议默认
+    Utf8        // 直接以字节计，不必扫描行内文本
+};
+
+// 语义单词图例：下标即 LSP 数据中的 tokenType
+const std::vector<std::string>& semanticTokenLegend();
+
+// 一次增量结果：用 data 替换上次结果中从 start 起的 deleteCount 个整数
+struct SemanticTokensEdit {
+    size_t start = 0;
+    size_t deleteCount = 0;
+    std::vector<uint32_t> data;
+};
+
+// 一个打开的文档：常驻内存的源码、单词序列和行索引。
+// 编辑通过 RustLexer::applyEdit() 增量更新，只重新分析受影响的单词；
+// 语义单词的增量结果只编码上次结果以来被改动的单词区间，与文件大小无关
+class SemanticDocument {
+public:
+    SemanticDocument(std::string text, PositionEncoding encoding);
+
+    // LSP 位置（行和 character 均从0开始）对应的字节偏移，超出范围时截到行尾或文末
+    size_t offsetAt(uint32_t line, uint32_t character) const;
+
+    // 把 [begin, end) 替换为 text
+    void replace(size_t begin, size_t end, std::string_view text);
+    // 整体替换全文（didChange 不带 range 时）
+    void replaceAll(std::string text);
+
+    // 完整编码全部单词，并记为最新结果
+    std::vector<uint32_t> full();
+    // 相对最新结果的增量（每个改动区间一处替换，按位置升序），并把当前状态记为最新结果。
+    // 从未返回过结果时返回 false
+    bool delta(std::vector<SemanticTokensEdit>& edits);
+
+    // 最新结果的编号，每次 full()/delta() 后递增
+    uint64_t resultId() const { return lastResultId; }
+
+    std::string_view text() const { return lexer->sourceText(); }
+    size_t tokenCount() const { return tokens.size(); }
+
+private:
+    struct Position {
+        uint32_t line = 0;
+        uint32_t character = 0;
+    };
+
+    // 按行推进的游标：连续编码同一行上的单词时，UTF-16 列号从上一个单词处接着数
+    struct Cursor {
+        uint32_t line = UINT32_MAX;     // 从0开始
+        size_t lineStart = 0;
+        size_t lineEnd = 0;             // 不含行尾的 "\n" 或 "\r\n"
+        size_t nextLineStart = 0;
+        size_t offset = 0;              // 已数到的字节偏移
+        uint32_t units = 0;             // offset 处的列号
+    };
+
+    std::unique_ptr<RustLexer> lexer;
+    TokenStream tokens;
+    LineIndex lines;
+    PositionEncoding encoding;
+
+    // 最新结果的形状：多数单词恰好编码为一段（5个整数），只记录段数不为1的单词
+    // （跨行的块注释和字符串按行拆开，不着色的单词为0段），按单词下标升序
+    uint64_t lastResultId = 0;
+    std::vector<std::pair<uint32_t, uint32_t>> lastSegments;
+
+    // 上次结果以来被改动的单词区间：旧结果中的 [oldFirst, oldEnd) 对应当前的 [newFirst, newEnd)，
+    // 区间之外的单词只平移。按位置升序、互不相接；过多时合并为一个
+    struct DirtyRange {
+        size_t oldFirst;
+        size_t oldEnd;
+        size_t newFirst;
+        size_t newEnd;
+    };
+    static constexpr size_t MAX_DIRTY_RANGES = 64;
+    std::vector<DirtyRange> dirtyRanges;
+
+    void markDirty(size_t first, size_t removed, size_t inserted);
+
+    void moveCursor(Cursor& cursor, size_t offset) const;
+    uint32_t columnAt(Cursor& cursor, size_t offset) const;
+    uint32_t unitsBetween(size_t begin, size_t end) const;
+
+    // 把单词 [first, last) 编码后追加到 data；previous 为前一段的位置，结束时更新。
+    // 段数不为1的单词追加到 segments
+    void encode(size_t first, size_t last, Position& previous, std::vector<uint32_t>& data,
+                std::vector<std::pair<uint32_t, uint32_t>>& segments) const;
+    // 单词 index 之前最后一段的位置（没有时为文档开头）
+    Position positionBefore(size_t index) const;
+    // 最新结果中单词 index 的第一个整数的下标
+    size_t resultOffset(size_t index) const;
+};
+
+#endif // SEMANTICTOKENS_H
@@ -0,0 +1,213 @@
+#!/usr/bin/env python3
+# rustlexd 回放测试：启动服务，打开一个文档后回放随机的增量 didChange，
+# 不定期请求 semanticTokens/full/delta，把增量结果应用到客户端保存的上一份数据上，
+# 再以另一个 URI 打开同样的文本请求 semanticTokens/full，两者必须完全相同。
+# 编辑片段包括块注释、字符串和原始字符串的开闭、多字节字符、代理对和 \r\n，
+# 位置按协商的编码（UTF-16 或 UTF-8）计算。任何不一致都打印步骤并返回非零。
+#
+# 用法：replay.py [选项] <rustlexd 可执行文件> [源文件...]
+#   --steps <N>         每个文件、每种编码回放的编辑次数（默认 2000）
+#   --seed <N>          随机种子（默认 20240521）
+#   --encoding <名称>   utf-16、utf-8 或 both（默认 both）
+# 不给出源文件时使用内置的示例源码。
+
+import argparse
+import json
+import random
+import subprocess
+import sys
+
+SAMPLE = '''// 示例源码：各类单词都有
+use std::collections::HashMap;
+
+/// 文档注释 /* 不是块注释 */
+fn main() {
+    let größe: u32 = 0x1F_u32 + 1_000;
+    let s = "字符串 \\"转义\\" 😀";
+    let r = r#"原始 "字符串""#;
+    let c = 'é';
+    /* 块注释 /* 嵌套 */ 结束 */
+    'outer: loop { break 'outer; }
+    println!("{}", s.len() as f64 * 2.5e-3);
+}
+'''
+
+# 每个片段单独插入，或与相邻文本粘连后改变单词边界
+SNIPPETS = [
+    "\n", " ", "x", "fn", "/*", "*/", "//", "\"", "'", "r#\"", "\"#", "\\",
+    "é", "中文", "😀", "\r\n", "0x1F", "1.5e3", "'a", "b'x'", "::", "=>",
+    "fn main() {}", "// 注释\n", "/* 多行\n注释 */", "\"多行\n字符串\"",
+]
+
+URI = "file:///replay/a.rs"
+CHECK_URI = "file:///replay/check.rs"
+
+
+class Client:
+    """通过标准输入输出与 rustlexd 交换 Content-Length 分帧的 JSON-RPC 消息。"""
+
+    def __init__(self, server):
+        self.process = subprocess.Popen([server], stdin=subprocess.PIPE, stdout=subprocess.PIPE)
+        self.next_id = 0
+
+    def send(self, message):
+        body = json.dumps(message).encode("utf-8")
+        self.process.stdin.write(b"Content-Length: %d\r\n\r\n" % len(body) + body)
+        self.process.stdin.flush()
+
+    def receive(self):
+        length = None
+        while True:
+            line = self.process.stdout.readline()
+            if not line:
+                raise RuntimeError("rustlexd 意外退出")
+            if line in (b"\r\n", b"\n"):
+                break
+            name, _, value = line.partition(b":")
+            if name.strip().lower() == b"content-length":
+                length = int(value)
+        return json.loads(self.process.stdout.read(length))
+
+    def request(self, method, params):
+        self.next_id += 1
+        self.send({"jsonrpc": "2.0", "id": self.next_id, "method": method, "params": params})
+        reply = self.receive()
+        if reply.get("id") != self.next_id or "error" in reply:
+            raise RuntimeError("%s 失败：%s" % (method, json.dumps(reply, ensure_ascii=False)))
+        return reply["result"]
+
+    def notify(self, method, params):
+        self.send({"jsonrpc": "2.0", "method": method, "params": params})
+
+    def close(self):
+        self.request("shutdown", None)
+        self.notify("exit", None)
+        return self.process.wait()
+
+
+def position(text, index, encoding):
+    """Python 字符下标对应的 LSP 位置；只有 \\n 分行，列号按协商的编码计。"""
+    line_start = text.rfind("\n", 0, index) + 1
+    segment = text[line_start:index]
+    if encoding == "utf-8":
+        character = len(segment.encode("utf-8"))
+    else:
+        character = len(segment.encode("utf-16-le")) // 2
+    return {"line": text.count("\n", 0, index), "character": character}
+
+
+def random_change(rng, text, encoding):
+    """在 text 上随机删除一段并插入若干片段，返回 LSP 的 contentChange 和编辑后的文本。"""
+    start = rng.randint(0, len(text))
+    end = min(len(text), start + rng.choice([0, 0, 1, 2, 5, 20]))
+    inserted = "" if rng.random() < 0.3 else "".join(
+        rng.choice(SNIPPETS) for _ in range(rng.randint(1, 3)))
+    change = {
+        "range": {"start": position(text, start, encoding), "end": position(text, end, encoding)},
+        "text": inserted,
+    }
+    return change, text[:start] + inserted + text[end:]
+
+
+def apply_delta(data, result):
+    """把 full/delta 的结果应用到上一份数据上；服务端也可能直接返回完整数据。"""
+    if "data" in result:
+        return list(result["data"])
+    # 编辑按起点从后往前应用，前面的下标不受影响
+    for edit in sorted(result["edits"], key=lambda edit: -edit["start"]):
+        data[edit["start"]:edit["start"] + edit["deleteCount"]] = edit.get("data", [])
+    return data
+
+
+def full_tokens(client, text):
+    """以另一个 URI 打开同样的文本，取完整结果作为参照。"""
+    client.notify("textDocument/didOpen", {"textDocument": {
+        "uri": CHECK_URI, "languageId": "rust", "version": 1, "text": text}})
+    data = client.request("textDocument/semanticTokens/full", {"textDocument": {"uri": CHECK_URI}})["data"]
+    client.notify("textDocument/didClose", {"textDocument": {"uri": CHECK_URI}})
+    return data
+
+
+def replay(server, name, text, encoding, steps, seed):
+    client = Client(server)
+    offered = ["utf-8", "utf-16"] if encoding == "utf-8" else ["utf-16"]
+    result = client.request("initialize", {"capabilities": {"general": {"positionEncodings": offered}}})
+    negotiated = result["capabilities"]["positionEncoding"]
+    if negotiated != encoding:
+        print("%s：协商的编码是 %s，期望 %s" % (name, negotiated, encoding))
+        return False
+    client.notify("initialized", {})
+
+    client.notify("textDocument/didOpen", {"textDocument": {
+        "uri": URI, "languageId": "rust", "version": 1, "text": text}})
+    result = client.request("textDocument/semanticTokens/full", {"textDocument": {"uri": URI}})
+    data = list(result["data"])
+    result_id = result["resultId"]
+
+    rng = random.Random(seed)
+    deltas = 0
+    for step in range(steps):
+        # 一次 didChange 带1到3处编辑，按顺序作用在前一处编辑后的文本上
+        changes = []
+        for _ in range(rng.randint(1, 3)):
+            change, text = random_change(rng, text, encoding)
+            changes.append(change)
+        client.notify("textDocument/didChange", {
+            "textDocument": {"uri": URI, "version": step + 2}, "contentChanges": changes})
+
+        # 有时连续几次编辑之后才请求增量结果
+        if rng.random() < 0.3:
+            continue
+        result = client.request("textDocument/semanticTokens/full/delta",
+                                {"textDocument": {"uri": URI}, "previousResultId": result_id})
+        result_id = result["resultId"]
+        data = apply_delta(data, result)
+        deltas += 1
+
+        expected = full_tokens(client, text)
+        if data != expected:
+            print("%s（%s）：第 %d 步增量结果与完整结果不同（%d 项，期望 %d 项）"
+                  % (name, encoding, step, len(data), len(expected)))
+            for index, (actual, wanted) in enumerate(zip(data, expected)):
+                if actual != wanted:
+                    print("  第一处不同在第 %d 项：%s，期望 %s"
+                          % (index, data[index:index + 10], expected[index:index + 10]))
+                    break
+            print("  最后一次编辑：%s" % json.dumps(changes, ensure_ascii=False))
+            client.process.kill()
+            return False
+
+    code = client.close()
+    if code != 0:
+        print("%s（%s）：rustlexd 退出码 %d" % (name, encoding, code))
+        return False
+    print("%s（%s）：%d 次编辑，%d 次增量结果一致" % (name, encoding, steps, deltas))
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description="回放 didChange，检查 rustlexd 的增量语义单词结果")
+    parser.add_argument("server", help="rustlexd 可执行文件")
+    parser.add_argument("sources", nargs="*", help="作为初始文本的源文件")
+    parser.add_argument("--steps", type=int, default=2000)
+    parser.add_argument("--seed", type=int, default=20240521)
+    parser.add_argument("--encoding", choices=["utf-16", "utf-8", "both"], default="both")
+    options = parser.parse_args()
+
+    documents = [("示例", SAMPLE)]
+    if options.sources:
+        documents = []
+        for path in options.sources:
+            with open(path, encoding="utf-8", errors="replace") as file:
+                documents.append((path, file.read()))
+    encodings = ["utf-16", "utf-8"] if options.encoding == "both" else [options.encoding]
+
+    ok = True
+    for index, (name, text) in enumerate(documents):
+        for encoding in encodings:
+            ok = replay(options.server, name, text, encoding, options.steps, options.seed + index) and ok
+    return 0 if ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())